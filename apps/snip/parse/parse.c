@@ -1,131 +1,231 @@
-/*
- * Copyright (c) 2015 Broadcom
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without modification,
- * are permitted provided that the following conditions are met:
- *
- * 1. Redistributions of source code must retain the above copyright notice, this
- * list of conditions and the following disclaimer.
- *
- * 2. Redistributions in binary form must reproduce the above copyright notice, this
- * list of conditions and the following disclaimer in the documentation and/or
- * other materials provided with the distribution.
- *
- * 3. Neither the name of Broadcom nor the names of other contributors to this 
- * software may be used to endorse or promote products derived from this software 
- * without specific prior written permission.
- *
- * 4. This software may not be used as a standalone product, and may only be used as 
- * incorporated in your product or device that incorporates Broadcom wireless connectivity 
- * products and solely for the purpose of enabling the functionalities of such Broadcom products.
- *
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
- * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
- * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
- * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
- * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
- * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
- * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
- * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
- * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- */
-
-/** @file
- *
- *PARSE Application
- *
- *
- */
-
-#include "wiced.h"
-#include "parse.h"
-#include "parse_dct.h"
-
-/******************************************************
- *                      Macros
- ******************************************************/
-
-/******************************************************
- *                    Constants
- ******************************************************/
-
-/******************************************************
- *                   Enumerations
- ******************************************************/
-
-/******************************************************
- *                 Type Definitions
- ******************************************************/
-
-/******************************************************
- *                    Structures
- ******************************************************/
-
-/******************************************************
- *               Static Function Declarations
- ******************************************************/
-
-static void push_received( parse_client_t* client, int error, const char* data );
-
-/******************************************************
- *               Variable Definitions
- ******************************************************/
-
-static parse_client_t client;
-
-/******************************************************
- *               Function Definitions
- ******************************************************/
-
-void application_start(void)
-{
-    parse_dct_t* parse_dct;
-
-    /* Initialise the WICED device */
-    wiced_init( );
-
-    /* Bring up the network interface and connect to the Wi-Fi network */
-    wiced_network_up( WICED_STA_INTERFACE, WICED_USE_EXTERNAL_DHCP_SERVER, NULL );
-
-    /* Get keys from DCT */
-    wiced_dct_read_lock( (void**) &parse_dct, WICED_FALSE, DCT_APP_SECTION, 0, sizeof(parse_dct_t) );
-
-    /* Initialize Parse */
-    parse_init( &client, parse_dct->application_id, parse_dct->client_key, parse_dct->installation_id );
-
-    wiced_dct_read_unlock( parse_dct, WICED_FALSE );
-
-    parse_set_push_callback( &client, push_received );
-
-    WPRINT_APP_INFO( ("Starting push service...\n") );
-    parse_start_push_service( &client );
-
-    WPRINT_APP_INFO( ("Starting run loop...\n") );
-    parse_run_push_loop( &client );
-
-    wiced_deinit();
-}
-
-static void push_received( parse_client_t* client, int error, const char* data )
-{
-#ifdef PLATFORM_HAS_LEDS
-    static int led_state = 0;
-
-    led_state = 1 - led_state;
-    if (led_state)
-    {
-        wiced_gpio_output_high(WICED_LED1);
-    }
-    else
-    {
-        wiced_gpio_output_low(WICED_LED1);
-    }
-#endif
-    if ( error == 0 && data != NULL )
-    {
-        WPRINT_APP_INFO( ("Received push message:\"%s\"\n", data) );
-    }
-}
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ *PARSE Application
+ *
+ *
+ */
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_dct.h"
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/* Stack left unpainted for what application_start() is called with and its own frame */
+#define STACK_PAINT_MARGIN  ( 1024 )
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void push_received( parse_client_t* client, int error, const char* data, const parse_push_t* push );
+static void installation_resolved( parse_client_t* client, const char* installation_id, const char* installation_object_id );
+#ifdef PARSE_ENABLE_ASYNC_INIT
+static void client_ready( parse_client_t* client, wiced_result_t installation_result, wiced_result_t push_result );
+#endif
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static parse_client_t client;
+#ifdef PARSE_ENABLE_ASYNC_INIT
+static wiced_semaphore_t ready_semaphore;
+static wiced_result_t    ready_push_result;
+#endif
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+void application_start(void)
+{
+    parse_dct_t* parse_dct;
+    const char*  installation_object_id;
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    parse_paint_current_stack( "application", APPLICATION_STACK_SIZE - STACK_PAINT_MARGIN );
+#endif
+
+    /* Initialise the WICED device */
+    wiced_init( );
+
+    /* Bring up the network interface and connect to the Wi-Fi network */
+    wiced_network_up( WICED_STA_INTERFACE, WICED_USE_EXTERNAL_DHCP_SERVER, NULL );
+
+    /* Get keys from DCT. This is a copy, installation_resolved() may write the DCT during parse_init_with_installation() */
+    wiced_dct_read_lock( (void**) &parse_dct, WICED_TRUE, DCT_APP_SECTION, 0, sizeof(parse_dct_t) );
+
+    /* The stored installation object id is only used with the installation id it was stored for,
+     * then no request is needed */
+    installation_object_id = ( strcmp( parse_dct->installation_owner_id, parse_dct->installation_id ) == 0 ) ? parse_dct->installation_object_id : NULL;
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+    /* Installation and push service are set up in parallel, the strings are copied before it returns */
+    wiced_rtos_init_semaphore( &ready_semaphore );
+    parse_init_async( &client, parse_dct->application_id, parse_dct->client_key, parse_dct->installation_id, installation_object_id,
+                      installation_resolved, client_ready );
+    wiced_dct_read_unlock( parse_dct, WICED_TRUE );
+
+    parse_set_push_decoded_callback( &client, push_received );
+
+    WPRINT_APP_INFO( ("Waiting for the installation and push service...\n") );
+    wiced_rtos_get_semaphore( &ready_semaphore, WICED_NEVER_TIMEOUT );
+    if ( ready_push_result != WICED_SUCCESS )
+    {
+        parse_start_push_service( &client );
+    }
+#else
+    /* Initialize Parse */
+    parse_init_with_installation( &client, parse_dct->application_id, parse_dct->client_key, parse_dct->installation_id, installation_object_id, installation_resolved );
+    wiced_dct_read_unlock( parse_dct, WICED_TRUE );
+
+    parse_set_push_decoded_callback( &client, push_received );
+
+    WPRINT_APP_INFO( ("Starting push service...\n") );
+    parse_start_push_service( &client );
+#endif
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    parse_print_memory_stats( );
+#endif
+
+    WPRINT_APP_INFO( ("Starting run loop...\n") );
+    parse_run_push_loop( &client );
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    parse_print_memory_stats( );
+#endif
+
+    wiced_deinit();
+}
+
+static void installation_resolved( parse_client_t* client, const char* installation_id, const char* installation_object_id )
+{
+    parse_dct_t* parse_dct;
+
+    UNUSED_PARAMETER( client );
+
+    if ( wiced_dct_read_lock( (void**) &parse_dct, WICED_TRUE, DCT_APP_SECTION, 0, sizeof(parse_dct_t) ) != WICED_SUCCESS )
+    {
+        return;
+    }
+
+    /* Only write the flash when the ids changed, a generated installation id is stored as well */
+    if ( strcmp( parse_dct->installation_id,        installation_id )        != 0 ||
+         strcmp( parse_dct->installation_object_id, installation_object_id ) != 0 ||
+         strcmp( parse_dct->installation_owner_id,  installation_id )        != 0 )
+    {
+        memset( parse_dct->installation_id,        0, sizeof( parse_dct->installation_id ) );
+        memset( parse_dct->installation_object_id, 0, sizeof( parse_dct->installation_object_id ) );
+        memset( parse_dct->installation_owner_id,  0, sizeof( parse_dct->installation_owner_id ) );
+        strncpy( parse_dct->installation_id,        installation_id,        sizeof( parse_dct->installation_id ) - 1 );
+        strncpy( parse_dct->installation_object_id, installation_object_id, sizeof( parse_dct->installation_object_id ) - 1 );
+        strncpy( parse_dct->installation_owner_id,  installation_id,        sizeof( parse_dct->installation_owner_id ) - 1 );
+
+        WPRINT_APP_INFO( ("Storing installation %s\n", installation_object_id) );
+        wiced_dct_write( parse_dct, DCT_APP_SECTION, 0, sizeof(parse_dct_t) );
+    }
+
+    wiced_dct_read_unlock( parse_dct, WICED_TRUE );
+}
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+static void client_ready( parse_client_t* client, wiced_result_t installation_result, wiced_result_t push_result )
+{
+    UNUSED_PARAMETER( client );
+
+    WPRINT_APP_INFO( ("Parse ready, installation %d, push %d\n", (int) installation_result, (int) push_result) );
+    ready_push_result = push_result;
+    wiced_rtos_set_semaphore( &ready_semaphore );
+}
+#endif
+
+static void push_received( parse_client_t* client, int error, const char* data, const parse_push_t* push )
+{
+#ifdef PLATFORM_HAS_LEDS
+    static int led_state = 0;
+
+    led_state = 1 - led_state;
+    if (led_state)
+    {
+        wiced_gpio_output_high(WICED_LED1);
+    }
+    else
+    {
+        wiced_gpio_output_low(WICED_LED1);
+    }
+#endif
+    if ( error == 0 && push != NULL )
+    {
+        int64_t badge;
+        char    alert[ 128 ];
+
+        if ( push->alert.type == SIMPLE_JSON_STRING && simpleJsonUnescape( &push->alert, alert, sizeof( alert ) ) >= 0 )
+        {
+            WPRINT_APP_INFO( ("Received push alert:\"%s\"\n", alert) );
+        }
+        if ( simpleJsonGetInt64( &push->badge, &badge ) )
+        {
+            WPRINT_APP_INFO( ("Badge: %ld\n", (long) badge) );
+        }
+        WPRINT_APP_INFO( ("Push has %u custom fields\n", parse_push_get_custom_count( push )) );
+    }
+    else if ( error == 0 && data != NULL )
+    {
+        WPRINT_APP_INFO( ("Received push message:\"%s\"\n", data) );
+    }
+}
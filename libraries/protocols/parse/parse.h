@@ -1,367 +1,1424 @@
-/*
- * Copyright (c) 2015 Broadcom
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without modification,
- * are permitted provided that the following conditions are met:
- *
- * 1. Redistributions of source code must retain the above copyright notice, this
- * list of conditions and the following disclaimer.
- *
- * 2. Redistributions in binary form must reproduce the above copyright notice, this
- * list of conditions and the following disclaimer in the documentation and/or
- * other materials provided with the distribution.
- *
- * 3. Neither the name of Broadcom nor the names of other contributors to this 
- * software may be used to endorse or promote products derived from this software 
- * without specific prior written permission.
- *
- * 4. This software may not be used as a standalone product, and may only be used as 
- * incorporated in your product or device that incorporates Broadcom wireless connectivity 
- * products and solely for the purpose of enabling the functionalities of such Broadcom products.
- *
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
- * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
- * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
- * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
- * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
- * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
- * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
- * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
- * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- */
-#pragma once
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-
-/******************************************************
- *                      Macros
- ******************************************************/
-
-/******************************************************
- *                    Constants
- ******************************************************/
-
-/*! \def APPLICATION_ID_MAX_LEN
- *  \brief The length of application id
- */
-#define APPLICATION_ID_MAX_LEN      ( 40 )
-
-/*! \def CLIENT_KEY_MAX_LEN
- *  \brief The length of client key
- */
-#define CLIENT_KEY_MAX_LEN          ( 40 )
-
-/*! \def OBJECT_ID_MAX_LEN
- *  \brief The length of object id
- */
-#define OBJECT_ID_MAX_LEN           ( 16 )
-
-/*! \def INSTALLATION_ID_MAX_LEN
- *  \brief The length of installation id
- */
-#define INSTALLATION_ID_MAX_LEN     ( 36 )
-
-/*! \def SESSION_TOKEN_MAX_LEN
- *  \brief The length of session token
- */
-#define SESSION_TOKEN_MAX_LEN       ( 40 )
-
-#define RESPONSE_SIZE               ( 2048 )
-
-/******************************************************
- *                   Enumerations
- ******************************************************/
-
-/******************************************************
- *                 Type Definitions
- ******************************************************/
-
-typedef struct _parse_client_t parse_client_t;
-
-/*! \typedef parse_request_callback_t
- *  \brief Callback for API requests.
- *
- *  Called when an API request is finished.
- *
- *  \param[in]  client           The Parse client that made the API request.
- *  \param[in]  error            OS-specific error code.
- *                               If the API request was successful, this will be 0.
- *                               If any error occured during the request, the rest of the
- *                               parameters are meaningless.
- *  \param[in]  httpStatus       HTTP status of the API request.
- *  \param[in]  httpResponseBody The response body for the request. If the request
- *                               is successful, this is a JSON document describing the
- *                               result. If the request is unsuccessful, this contains
- *                               error details.
- *
- *  The SDK retains ownership of the response body. If you need to retain any data from it
- *  for use outside of the scope of the callback, make a copy.
- */
-typedef void (*parse_request_callback_t)( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody );
-
-
-/*! \typedef parse_push_callback_t
- *  \brief Callback for push notifications and errors from the push service.
- *
- *  \param[in]  client           The Parse client associated with the callback.
- *  \param[in]  error            OS-specific error code.
- *                               If the push service received the notification data
- *                               normally, this will be 0.
- *                               If any error occurred during receiving
- *                               the notification data, the rest of the parameters are
- *                               meaningless.
- *  \param[in]  data             The data for the incoming push notification. If the notification
- *                               is received successfully, this is a JSON document describing the
- *                               payload for the notification.
- *
- *  The SDK retains ownership of the notification data buffer. If you need to retain any data from it
- *  for use outside of the scope of the callback, make a copy.
- */
-typedef void (*parse_push_callback_t)( parse_client_t* client, int error, const char* data );
-
-/******************************************************
- *                    Structures
- ******************************************************/
-
-struct _parse_client_t
-{
-    char                   app_id                [ APPLICATION_ID_MAX_LEN    + 1];
-    char                   client_key            [ CLIENT_KEY_MAX_LEN        + 1];
-    char                   session_token         [ SESSION_TOKEN_MAX_LEN     + 1];
-    char                   installation_id       [ INSTALLATION_ID_MAX_LEN   + 1];
-    char                   installation_id_string[ INSTALLATION_ID_MAX_LEN*2 + 1];
-    char                   installationObjectId  [ OBJECT_ID_MAX_LEN         + 1];
-    parse_push_callback_t  push_callback;
-    wiced_tcp_socket_t     tcp_socket;
-    volatile int           push_socket_connected;
-    volatile int           push_socket_stop;
-    char                   parse_buffer[ RESPONSE_SIZE ];
-#ifdef USE_STREAM
-    wiced_tcp_stream_t     tcp_stream;
-#endif
-};
-
-/******************************************************
- *                 Global Variables
- ******************************************************/
-
-/******************************************************
- *               Function Declarations
- ******************************************************/
-
-/*! \fn wiced_result_t parse_init( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id )
- *  \brief Initialize the Parse client and user session
- *
- *  This method only initializes the Parse client, used for subsequent API requests. It does
- *  not start the push service, and does not create or load the installation object for the client.
- *
- *  \param[in]  client            A pointer to a parse_client_t object          (required)
- *  \param[in]  application_id    The application id for the Parse application. (required)
- *  \param[in]  client_key        The client API key for the Parse application. (required)
- *  \param[in]  installation_id   The installation ID to be used by the client  (optional)
- *
- *  \result                       wiced_result_t
- *
- *  The caller retains ownership of the applicationId and clientKey buffers, and is responsible for
- *  freeing them and reclaiming the memory after this call.
- *  The SDK will make copies of the buffers.
- */
-wiced_result_t parse_init( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id );
-
-/*! \fn void parse_set_installation_id( parse_client_t* client, const char* installationId )
- *  \brief Set the installation object id for this client.
- *
- *  Set the installation object id for this client. If this is not called before making an
- *  API request or starting push service, the SDK will create a new installation object for
- *  the client.
- *
- *  \param[in]  client           The Parse client for which the installation id will be set.
- *  \param[in]  installationId   The installation id to be used by the client.
- *
- *  The caller retains ownership of the installationId buffer, and is responsible for
- *  freeing it and reclaiming the memory after this call.
- *  The SDK will make copies of the buffer.
- */
-void parse_set_installation_id( parse_client_t* client, const char* installationId );
-
-/*! \fn const char* parse_get_installation_id( parse_client_t* client )
- *  \brief Return the client installation id
- *
- *  Return the installation id for the client. If called before the installation id for the
- *  client was set, this method will NOT create a new installation object.
- *  The typical usage scenario is:
- *
- *  1.   Call parseInitialize().
- *  2.   Call parse_get_installation_id().
- *  3.a. If the result is not NULL, the SDK has a previous installation id,
- *       there's nothing else to do.
- *       Otherwise:
- *  3.b.1. If the device has already an installation id, call parse_set_installation_id().
- *  3.b.2. If the device doesn't have an installation id, the SDK will generate one
- *         the first time it needs it.
- *
- *  \param[in]  client           The Parse client for which the installation id should be returned.
- *
- *  \result                      The installation id.
- *
- *  The SDK retains ownership of the result buffer, and still owns it after
- *  this call. Do not free it.
- */
-const char* parse_get_installation_id( parse_client_t* client );
-
-/*! \fn void parse_set_session_token( parse_client_t* client, const char* sessionToken )
- *  \brief Set the session token for the Parse client
- *
- *  \param[in]  client           The Parse client for which the session token is set.
- *  \param[in]  sessionToken     The new session token. All subsequent API calls will
- *                               use this token for authentication and authorization.
- *                               If this is NULL, the client will be unauthenticated.
- *
- *  The caller retains ownership of the sessionToken buffer, and is responsible for
- *  freeing it and reclaiming the memory after this call.
- *  The SDK will make copies of the buffer.
- */
-void parse_set_session_token( parse_client_t* client, const char* sessionToken );
-
-/*! \fn void parseClearSessionToken(ParseClient client)
- *  \brief Clear the session token
- *
- *  Same as parse_set_session_token(client, NULL);
- */
-void parseClearSessionToken( parse_client_t* client );
-
-/*! \fn const char* parse_get_session_token( parse_client_t* client )
- *  \brief Return the client session token.
- *
- *  Return the session token for the client, or NULL if there isn't one.
- *
- *  \param[in]  client           The Parse client for which the session token should be returned.
- *
- *  \result                      The session token.
- *
- *  The SDK retains ownership of the result buffer, and still owns it after
- *  this call. Do not free it.
- */
-const char* parse_get_session_token( parse_client_t* client );
-
-/*! \fn void parse_set_push_callback( parse_client_t* client, parse_push_callback_t callback )
- *  \brief Set the callback for push notifications and errors
- *
- *  This method sets or clears the callback for push notifications and errors from
- *  the push service, associated with this client.
- *
- *  This method DOES NOT start or stop the push service.
- *
- *  \param[in]  client           The Parse client for which the callback is set.
- *  \param[in]  callback         The new callback method. All subsequent push notifications
- *                               or errors will result  in a call to this callback method.
- *                               If this parameter is NULL, the callback will be removed.
- *
- *  Any push notifications received while there is no callback associated with the client
- *  will be skipped, and the application will not received them.
- */
-void parse_set_push_callback( parse_client_t* client, parse_push_callback_t callback );
-
-/*! \fn int parse_start_push_service( parse_client_t* client )
- *  \brief Start the push notifications service.
- *
- *  This method will start the push notification service and will listen for incoming
- *  push notifications. If the push service is already started, this will do nothing.
- *  To actually process incoming push notifications, it is still necessary to repeatedly
- *  call parse_process_next_push_notification() or call parseRunPushLoop().
- *
- *  \param[in]  client           The Parse client for which the service should be started.
- *
- *  \result                      OS-specific error if the push can't be started or 0 if
- *                               started successfully.
- *
- *  If a push callback has been set for the client, any errors during starting the service will
- *  passed to it as well.
- *
- */
-int parse_start_push_service( parse_client_t* client );
-
-/*! \fn void parse_stop_push_service( parse_client_t* client )
- *  \brief Stop the push notifications service.
- *
- *  This method will stop the push notification service. If the push service is not started,
- *  this will do nothing.
- *
- *  \param[in]  client           The Parse client for which the service should be stopped.
- */
-void parse_stop_push_service( parse_client_t* client );
-
-/*! \fn int parse_process_next_push_notification( parse_client_t* client )
- *  \brief Process next pending push notification.
- *
- *  Push notifications are processed one at a time. This method will process the next push
- *  notification and will call the client callback, if one is set.
- *
- *  \param[in]  client           The Parse client for which the next event should be processed.
- *
- *  \result                      0 if there are no more pending notification events or the push
- *                               service is not started.
- *                               Positive number if there are more pending notification events.
- *
- *  If the push notifications callback has been set for the client, it will also be called in
- *  the case of an error during the processing of the notification. If the callback is not set,
- *  the client will not get notified about any errors that during the processing of the notification.
- */
-int parse_process_next_push_notification( parse_client_t* client );
-
-/*! \fn void parseRunPushLoop(ParseClient client)
- *  \brief Process push notifications events in a loop.
- *
- *  This method will keep processing the push notification events for the client and will call
- *  the client callback for each one. If the push notification service for the client is not
- *  started or is stopped, this method will exit.
- *
- *  \param[in]  client           The Parse client for which the push events should be processed.
- */
-void parse_run_push_loop( parse_client_t* client );
-
-/*! \fn void parse_send_request( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback )
- *  \brief Send an API request.
- *
- *  This method makes an API request for the client. If called before installation id for the client
- *  is set, this will also create a new installation object.
- *
- *  The API requests supported are any valid requests that can be made through the REST API as well.
- *
- *  \param[in]  client           The Parse client for which the request is made.
- *  \param[in]  httpVerb         The type of request - POST, GET, PUT, DELETE
- *  \param[in]  httpPath         The path for the request, i.e. /1/classes/MyClass
- *  \param[in]  httpRequestBody  The JSON payload for the request
- *  \param[in]  callback         The callback to process the result  of the request.
- *
- *  The caller retains ownership of the httpVerb, httpPath, and requestBody buffers, and is responsible for
- *  freeing them and reclaiming the memory after this call.
- */
-void parse_send_request( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback );
-
-/*! \fn int parse_get_error_code( const char* httpResponseBody )
- *  \brief Extract Parse error code.
- *
- *  Helper function to extract Parse errors from the response body, when httpStatus of the response is 4xx or 5xx.
- *  TODO: Link to the public documentation of the Parse error codes
- *
- *  \param[in]  httpResponseBody The response body for the request.
- *
- *  \result                      Return the error code from the server.
- *
- * The caller retains ownership of the httpResponseBody buffer, and is responsible for
- * freeing it and reclaiming the memory after this call.
- */
-int parse_get_error_code( const char* httpResponseBody );
-
-
-#ifdef __cplusplus
-} /* extern "C" */
-#endif
-
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "simplejson.h"
+#ifdef PARSE_ENABLE_TRACE
+#include "binary_trace.h"
+#endif
+#ifdef PARSE_ENABLE_TELEMETRY
+#include "time_series.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/*! \def APPLICATION_ID_MAX_LEN
+ *  \brief The length of application id
+ */
+#define APPLICATION_ID_MAX_LEN      ( 40 )
+
+/*! \def CLIENT_KEY_MAX_LEN
+ *  \brief The length of client key
+ */
+#define CLIENT_KEY_MAX_LEN          ( 40 )
+
+/*! \def OBJECT_ID_MAX_LEN
+ *  \brief The length of object id
+ */
+#define OBJECT_ID_MAX_LEN           ( 16 )
+
+/*! \def INSTALLATION_ID_MAX_LEN
+ *  \brief The length of installation id
+ */
+#define INSTALLATION_ID_MAX_LEN     ( 36 )
+
+/*! \def SESSION_TOKEN_MAX_LEN
+ *  \brief The length of session token
+ */
+#define SESSION_TOKEN_MAX_LEN       ( 40 )
+
+#define RESPONSE_SIZE               ( 2048 )
+
+/*! \def PARSE_PUSH_MAX_CUSTOM_FIELDS
+ *  \brief The number of custom data fields kept by the push decoder
+ */
+#define PARSE_PUSH_MAX_CUSTOM_FIELDS ( 8 )
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+/*! \def PARSE_DEFERRED_REQUEST_COUNT
+ *  \brief The number of requests a client queues while parse_init_async() is resolving its installation
+ */
+#ifndef PARSE_DEFERRED_REQUEST_COUNT
+#define PARSE_DEFERRED_REQUEST_COUNT ( 4 )
+#endif
+
+/*! \def PARSE_DEFERRED_REQUEST_SIZE
+ *  \brief Bytes for the verbs, paths and bodies of the queued requests
+ */
+#ifndef PARSE_DEFERRED_REQUEST_SIZE
+#define PARSE_DEFERRED_REQUEST_SIZE  ( 1024 )
+#endif
+#endif /* PARSE_ENABLE_ASYNC_INIT */
+
+#ifdef PARSE_ENABLE_TELEMETRY
+/*! \def PARSE_TELEMETRY_MAX_METRICS
+ *  \brief The number of metrics a client can record
+ */
+#ifndef PARSE_TELEMETRY_MAX_METRICS
+#define PARSE_TELEMETRY_MAX_METRICS  ( 4 )
+#endif
+
+/*! \def PARSE_TELEMETRY_MAX_SAMPLES
+ *  \brief The number of samples buffered per metric
+ */
+#ifndef PARSE_TELEMETRY_MAX_SAMPLES
+#define PARSE_TELEMETRY_MAX_SAMPLES  ( 32 )
+#endif
+
+/*! \def PARSE_TELEMETRY_NAME_MAX_LEN
+ *  \brief The length of a metric name
+ */
+#define PARSE_TELEMETRY_NAME_MAX_LEN ( 15 )
+
+/*! \def PARSE_TELEMETRY_CLASS_MAX_LEN
+ *  \brief The length of the class name the samples are uploaded to
+ */
+#define PARSE_TELEMETRY_CLASS_MAX_LEN ( 31 )
+#endif /* PARSE_ENABLE_TELEMETRY */
+
+#ifdef PARSE_ENABLE_OBJECTS
+/*! \def PARSE_OBJECT_MAX_FIELDS
+ *  \brief The number of fields an object handle tracks
+ */
+#ifndef PARSE_OBJECT_MAX_FIELDS
+#define PARSE_OBJECT_MAX_FIELDS      ( 8 )
+#endif
+
+/*! \def PARSE_OBJECT_TEXT_MAX_LEN
+ *  \brief The length of a string field, or of all the strings added to a set field before a save
+ */
+#ifndef PARSE_OBJECT_TEXT_MAX_LEN
+#define PARSE_OBJECT_TEXT_MAX_LEN    ( 31 )
+#endif
+
+/*! \def PARSE_OBJECT_KEY_MAX_LEN
+ *  \brief The length of a field name
+ */
+#define PARSE_OBJECT_KEY_MAX_LEN     ( 15 )
+
+/*! \def PARSE_OBJECT_CLASS_MAX_LEN
+ *  \brief The length of the class name of an object
+ */
+#define PARSE_OBJECT_CLASS_MAX_LEN   ( 31 )
+
+/*! \def PARSE_OBJECT_DATE_MAX_LEN
+ *  \brief The length of the server's dates, 2015-10-19T05:23:14.209Z
+ */
+#define PARSE_OBJECT_DATE_MAX_LEN    ( 24 )
+#endif /* PARSE_ENABLE_OBJECTS */
+
+#ifdef PARSE_ENABLE_QUERY_CURSOR
+/*! \def PARSE_QUERY_WINDOW_SIZE
+ *  \brief Bytes of the window a cursor receives each page in, with its HTTP headers
+ */
+#ifndef PARSE_QUERY_WINDOW_SIZE
+#define PARSE_QUERY_WINDOW_SIZE      ( RESPONSE_SIZE )
+#endif
+
+/*! \def PARSE_QUERY_WHERE_MAX_LEN
+ *  \brief The length of the constraints of a cursor, as a JSON object
+ */
+#ifndef PARSE_QUERY_WHERE_MAX_LEN
+#define PARSE_QUERY_WHERE_MAX_LEN    ( 127 )
+#endif
+
+/*! \def PARSE_QUERY_KEYS_MAX_LEN
+ *  \brief The length of the comma separated fields a cursor selects
+ */
+#define PARSE_QUERY_KEYS_MAX_LEN     ( 63 )
+
+/*! \def PARSE_QUERY_CLASS_MAX_LEN
+ *  \brief The length of the class name of a cursor
+ */
+#define PARSE_QUERY_CLASS_MAX_LEN    ( 31 )
+
+/*! \def PARSE_QUERY_MAX_LIMIT
+ *  \brief The most objects the server returns in one page
+ */
+#define PARSE_QUERY_MAX_LIMIT        ( 1000 )
+#endif /* PARSE_ENABLE_QUERY_CURSOR */
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+#ifdef PARSE_ENABLE_LATENCY_STATS
+/*! \enum parse_latency_phase_t
+ *  \brief The phases of an API request, timed when PARSE_ENABLE_LATENCY_STATS is defined.
+ */
+typedef enum
+{
+    PARSE_LATENCY_DNS,          /*!< Host name lookup                                 */
+    PARSE_LATENCY_CONNECT,      /*!< TCP connect                                      */
+    PARSE_LATENCY_TLS,          /*!< TLS handshake                                    */
+    PARSE_LATENCY_SEND,         /*!< Writing the request                              */
+    PARSE_LATENCY_FIRST_BYTE,   /*!< From the end of the request to the first packet  */
+    PARSE_LATENCY_BODY,         /*!< From the first to the last packet                */
+    PARSE_LATENCY_TOTAL,        /*!< From the start of the lookup to the last packet  */
+    PARSE_LATENCY_PHASE_COUNT
+} parse_latency_phase_t;
+
+/*! \enum parse_endpoint_t
+ *  \brief The REST endpoints latency is aggregated by, from the first part of the path.
+ */
+typedef enum
+{
+    PARSE_ENDPOINT_INSTALLATIONS,   /*!< /1/installations */
+    PARSE_ENDPOINT_CLASSES,         /*!< /1/classes       */
+    PARSE_ENDPOINT_BATCH,           /*!< /1/batch         */
+    PARSE_ENDPOINT_FUNCTIONS,       /*!< /1/functions     */
+    PARSE_ENDPOINT_OTHER,           /*!< Anything else    */
+    PARSE_ENDPOINT_COUNT
+} parse_endpoint_t;
+#endif /* PARSE_ENABLE_LATENCY_STATS */
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+/*! \enum parse_memory_buffer_t
+ *  \brief The library's buffers, measured when PARSE_ENABLE_MEMORY_STATS is defined.
+ */
+typedef enum
+{
+    PARSE_MEMORY_SENDING_DATA,      /*!< Static, request headers and body are built in it   */
+    PARSE_MEMORY_CLIENT_BUFFER,     /*!< parse_buffer of each client, the request to send   */
+    PARSE_MEMORY_RECEIVED_DATA,     /*!< Static, the last response packet                   */
+    PARSE_MEMORY_JSON_DATA,         /*!< Static, the push handshake                         */
+    PARSE_MEMORY_PUSH_NOTIFICATION, /*!< Static, the last push notification                 */
+    PARSE_MEMORY_KEEPALIVE,         /*!< Static, the push handshake and keep-alive replies  */
+    PARSE_MEMORY_REQUEST_PATH,      /*!< On the stack, path or query of installation lookup */
+    PARSE_MEMORY_TLS_CONTEXT,       /*!< Static, the TLS context of API requests            */
+    PARSE_MEMORY_TELEMETRY_DATA,    /*!< Static, the compact samples of a telemetry upload  */
+    PARSE_MEMORY_QUERY_WINDOW,      /*!< In each cursor, the last page received             */
+    PARSE_MEMORY_BUFFER_COUNT
+} parse_memory_buffer_t;
+
+/*! \enum parse_memory_location_t
+ *  \brief Where a buffer lives.
+ */
+typedef enum
+{
+    PARSE_MEMORY_STATIC,            /*!< One for the whole library */
+    PARSE_MEMORY_PER_CLIENT,        /*!< One in every client       */
+    PARSE_MEMORY_STACK              /*!< On the caller's stack     */
+} parse_memory_location_t;
+#endif /* PARSE_ENABLE_MEMORY_STATS */
+
+#ifdef PARSE_ENABLE_TELEMETRY
+/*! \enum parse_telemetry_encoding_t
+ *  \brief How the samples of a telemetry object are written.
+ */
+typedef enum
+{
+    PARSE_TELEMETRY_ENCODING_JSON = 0,    /*!< "dt" and "v" arrays of numbers                       */
+    PARSE_TELEMETRY_ENCODING_TIME_SERIES  /*!< "n" samples of time_series.h in base64 "data", "ts1" */
+} parse_telemetry_encoding_t;
+#endif /* PARSE_ENABLE_TELEMETRY */
+
+#ifdef PARSE_ENABLE_OBJECTS
+/*! \enum parse_field_type_t
+ *  \brief The value of an object field.
+ */
+typedef enum
+{
+    PARSE_FIELD_INTEGER,            /*!< value.integer                                    */
+    PARSE_FIELD_NUMBER,             /*!< value.number                                     */
+    PARSE_FIELD_BOOL,               /*!< value.boolean                                    */
+    PARSE_FIELD_STRING,             /*!< text                                             */
+    PARSE_FIELD_SET                 /*!< An array on the server, only additions are known */
+} parse_field_type_t;
+
+/*! \enum parse_field_change_t
+ *  \brief What the next save sends for a field.
+ */
+typedef enum
+{
+    PARSE_FIELD_UNCHANGED = 0,      /*!< Nothing, the field is as last synced             */
+    PARSE_FIELD_CHANGED,            /*!< The value                                        */
+    PARSE_FIELD_INCREMENTED,        /*!< An Increment operation by increment              */
+    PARSE_FIELD_ADDED               /*!< An AddUnique operation of the strings in text    */
+} parse_field_change_t;
+#endif /* PARSE_ENABLE_OBJECTS */
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+typedef struct _parse_client_t parse_client_t;
+
+/*! \typedef parse_request_callback_t
+ *  \brief Callback for API requests.
+ *
+ *  Called when an API request is finished.
+ *
+ *  \param[in]  client           The Parse client that made the API request.
+ *  \param[in]  error            OS-specific error code.
+ *                               If the API request was successful, this will be 0.
+ *                               If any error occured during the request, the rest of the
+ *                               parameters are meaningless.
+ *  \param[in]  httpStatus       HTTP status of the API request.
+ *  \param[in]  httpResponseBody The response body for the request. If the request
+ *                               is successful, this is a JSON document describing the
+ *                               result. If the request is unsuccessful, this contains
+ *                               error details.
+ *
+ *  The SDK retains ownership of the response body. If you need to retain any data from it
+ *  for use outside of the scope of the callback, make a copy.
+ */
+typedef void (*parse_request_callback_t)( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody );
+
+/*! \typedef parse_installation_callback_t
+ *  \brief Callback for a resolved installation.
+ *
+ *  Called when the installation object of the client was found or created on the server.
+ *  Store both ids, and pass them to parse_init_with_installation() on the next boot to
+ *  skip the installation requests.
+ *
+ *  \param[in]  client                 The Parse client of the installation.
+ *  \param[in]  installation_id        The installation id used by the client.
+ *  \param[in]  installation_object_id The object id of the installation on the server.
+ */
+typedef void (*parse_installation_callback_t)( parse_client_t* client, const char* installation_id, const char* installation_object_id );
+
+
+/*! \typedef parse_push_callback_t
+ *  \brief Callback for push notifications and errors from the push service.
+ *
+ *  \param[in]  client           The Parse client associated with the callback.
+ *  \param[in]  error            OS-specific error code.
+ *                               If the push service received the notification data
+ *                               normally, this will be 0.
+ *                               If any error occurred during receiving
+ *                               the notification data, the rest of the parameters are
+ *                               meaningless.
+ *  \param[in]  data             The data for the incoming push notification. If the notification
+ *                               is received successfully, this is a JSON document describing the
+ *                               payload for the notification.
+ *
+ *  The SDK retains ownership of the notification data buffer. If you need to retain any data from it
+ *  for use outside of the scope of the callback, make a copy.
+ */
+typedef void (*parse_push_callback_t)( parse_client_t* client, int error, const char* data );
+
+/*! \struct parse_push_field_t
+ *  \brief A custom data field of a push notification.
+ */
+typedef struct
+{
+    simple_json_value_t key;
+    simple_json_value_t value;
+} parse_push_field_t;
+
+/*! \struct parse_push_t
+ *  \brief A decoded push notification.
+ *
+ *  All the members are views into the raw notification buffer, nothing is copied.
+ *  String members are still escaped, use simpleJsonUnescape to copy their text.
+ *  Members that are not present in the notification have type SIMPLE_JSON_UNDEFINED.
+ *  Any member of the notification data other than the well-known ones is a custom field.
+ */
+typedef struct
+{
+    simple_json_value_t alert;
+    simple_json_value_t title;
+    simple_json_value_t badge;
+    simple_json_value_t sound;
+    simple_json_value_t channels;
+    simple_json_value_t time;
+    simple_json_value_t push_id;
+    simple_json_value_t data;
+    unsigned int        custom_count;
+    parse_push_field_t  custom[ PARSE_PUSH_MAX_CUSTOM_FIELDS ];
+} parse_push_t;
+
+/*! \typedef parse_push_decoded_callback_t
+ *  \brief Callback for decoded push notifications and errors from the push service.
+ *
+ *  \param[in]  client           The Parse client associated with the callback.
+ *  \param[in]  error            OS-specific error code, see parse_push_callback_t.
+ *  \param[in]  data             The raw data for the incoming push notification.
+ *  \param[in]  push             The decoded notification, or NULL if the data is not a
+ *                               valid push notification.
+ *
+ *  The SDK retains ownership of both the data buffer and the decoded notification, which
+ *  points into it. If you need to retain any data from them for use outside of the scope
+ *  of the callback, make a copy.
+ */
+typedef void (*parse_push_decoded_callback_t)( parse_client_t* client, int error, const char* data, const parse_push_t* push );
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+#ifdef PARSE_ENABLE_LATENCY_STATS
+/*! \struct parse_latency_record_t
+ *  \brief The timing of one API request.
+ *
+ *  Phases that were not reached, because the request failed before them, are 0.
+ */
+typedef struct
+{
+    parse_endpoint_t endpoint;
+    int              result;                                /*!< WICED result of the request          */
+    uint32_t         start_us;                              /*!< Clock value when the request started */
+    uint32_t         phase_us[ PARSE_LATENCY_PHASE_COUNT ]; /*!< Microseconds per phase               */
+} parse_latency_record_t;
+
+/*! \struct parse_latency_percentiles_t
+ *  \brief Latency distribution of one phase of one endpoint, in microseconds.
+ *
+ *  Percentiles come from a log-linear histogram and are the upper bound of their bucket,
+ *  capped at the largest value seen.
+ */
+typedef struct
+{
+    uint32_t count;     /*!< Successful requests measured */
+    uint32_t errors;    /*!< Failed requests, not in the percentiles */
+    uint32_t p50;
+    uint32_t p90;
+    uint32_t p99;
+    uint32_t max;
+} parse_latency_percentiles_t;
+
+/*! \typedef parse_latency_callback_t
+ *  \brief Called with the timing of every API request, just before its request callback.
+ */
+typedef void (*parse_latency_callback_t)( parse_client_t* client, const parse_latency_record_t* record );
+#endif /* PARSE_ENABLE_LATENCY_STATS */
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+/*! \typedef parse_ready_callback_t
+ *  \brief Called when the bootstrap started by parse_init_async() is finished.
+ *
+ *  Called once, when both the installation and the push connection are set up or failed,
+ *  on the thread of the library that finished last.
+ *
+ *  \param[in]  client              The Parse client.
+ *  \param[in]  installation_result WICED_SUCCESS if the installation object id is known.
+ *  \param[in]  push_result         WICED_SUCCESS if the push service is connected; call
+ *                                  parse_run_push_loop() next. Otherwise start it again with
+ *                                  parse_start_push_service().
+ */
+typedef void (*parse_ready_callback_t)( parse_client_t* client, wiced_result_t installation_result, wiced_result_t push_result );
+
+/*! \struct parse_deferred_request_t
+ *  \brief A request made before the installation was resolved.
+ */
+typedef struct
+{
+    parse_request_callback_t callback;
+    uint16_t                 offset;    /*!< Verb, path and body, each terminated by a zero, in parse_bootstrap_t.data */
+} parse_deferred_request_t;
+
+/*! \struct parse_bootstrap_t
+ *  \brief State of the bootstrap started by parse_init_async().
+ */
+typedef struct
+{
+    wiced_mutex_t            mutex;                 /*!< Initialised while started is set                 */
+    wiced_bool_t             started;               /*!< Until parse_async_deinit_client()                */
+    volatile int             installation_pending;  /*!< Requests are queued while set                    */
+    int                      paths;                 /*!< Installation and push, the last one reports ready */
+    int                      installation_step;
+    wiced_result_t           installation_result;
+    wiced_result_t           push_result;
+    parse_ready_callback_t   ready_callback;
+    parse_deferred_request_t requests[ PARSE_DEFERRED_REQUEST_COUNT ];
+    uint8_t                  count;
+    uint8_t                  next;
+    uint16_t                 used;
+    char                     data[ PARSE_DEFERRED_REQUEST_SIZE ];
+} parse_bootstrap_t;
+#endif /* PARSE_ENABLE_ASYNC_INIT */
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+/*! \struct parse_memory_usage_t
+ *  \brief Peak usage of one buffer since the last reset.
+ *
+ *  Usage counts the terminating zero of strings. Data that did not fit is counted as
+ *  filling the buffer, so full > 0 means the buffer is too small for some traffic.
+ */
+typedef struct
+{
+    parse_memory_location_t location;
+    uint32_t                size;   /*!< Bytes reserved                       */
+    uint32_t                peak;   /*!< Most bytes used at once               */
+    uint32_t                uses;   /*!< Times the buffer was filled           */
+    uint32_t                full;   /*!< Times the data filled or overflowed it */
+} parse_memory_usage_t;
+
+/*! \struct parse_stack_usage_t
+ *  \brief High-water mark of a painted stack.
+ */
+typedef struct
+{
+    const char* name;
+    uint32_t    size;   /*!< Bytes painted                           */
+    uint32_t    used;   /*!< Bytes overwritten since they were painted */
+} parse_stack_usage_t;
+#endif /* PARSE_ENABLE_MEMORY_STATS */
+
+#ifdef PARSE_ENABLE_TELEMETRY
+/*! \struct parse_telemetry_config_t
+ *  \brief When buffered telemetry is uploaded, see parse_telemetry_init().
+ *
+ *  All metrics are uploaded together as soon as one threshold is reached.
+ */
+typedef struct
+{
+    uint16_t                   max_samples;       /*!< Samples of one metric, at most PARSE_TELEMETRY_MAX_SAMPLES     */
+    uint16_t                   max_bytes;         /*!< Body of the upload, it must fit the request buffer             */
+    uint32_t                   max_age_ms;        /*!< Age of the oldest sample                                       */
+    uint32_t                   piggyback_age_ms;  /*!< Age from which samples go out after other requests, 0 to not */
+    parse_telemetry_encoding_t encoding;          /*!< Of the samples, PARSE_TELEMETRY_ENCODING_JSON by default       */
+} parse_telemetry_config_t;
+
+/*! \struct parse_telemetry_metric_t
+ *  \brief The buffered samples of one metric, one column per field.
+ */
+typedef struct
+{
+    char                  name[ PARSE_TELEMETRY_NAME_MAX_LEN + 1 ];
+    uint16_t              count;
+    uint16_t              bytes;                                  /*!< Upload size of the samples, with the object around them */
+    uint32_t              dropped;                                /*!< Oldest samples overwritten while uploads failed          */
+    wiced_time_t          times [ PARSE_TELEMETRY_MAX_SAMPLES ];  /*!< wiced_time_get_time() of each sample                     */
+    float                 values[ PARSE_TELEMETRY_MAX_SAMPLES ];
+    time_series_encoder_t encoder;                                /*!< Measures the compact stream of the samples               */
+} parse_telemetry_metric_t;
+
+/*! \struct parse_telemetry_t
+ *  \brief Telemetry state of a client.
+ */
+typedef struct
+{
+    char                      class_name[ PARSE_TELEMETRY_CLASS_MAX_LEN + 1 ];
+    parse_telemetry_config_t  config;
+    parse_request_callback_t  callback;
+    uint8_t                   metric_count;
+    uint8_t                   uploading;
+    uint8_t                   retry_pending; /*!< retry_time is set, after a failed upload        */
+    uint16_t                  pending;       /*!< Samples of all metrics                          */
+    uint16_t                  bytes;         /*!< Upload size of all metrics                      */
+    wiced_result_t            result;        /*!< Of the last upload                              */
+    wiced_time_t              retry_time;    /*!< No threshold upload before this after a failure */
+    wiced_time_t              upload_time;   /*!< Both clocks at the start of the upload, to turn */
+    wiced_utc_time_ms_t       upload_utc;    /*!< sample times into wall clock times              */
+    parse_telemetry_metric_t  metrics[ PARSE_TELEMETRY_MAX_METRICS ];
+} parse_telemetry_t;
+#endif /* PARSE_ENABLE_TELEMETRY */
+
+#ifdef PARSE_ENABLE_OBJECTS
+/*! \struct parse_object_field_t
+ *  \brief A field of an object handle and its change since the last save.
+ */
+typedef struct
+{
+    char                 key[ PARSE_OBJECT_KEY_MAX_LEN + 1 ];
+    uint8_t              type;                                  /*!< parse_field_type_t                              */
+    uint8_t              change;                                /*!< parse_field_change_t                            */
+    uint8_t              items;                                 /*!< Strings to add to a set, one after the other    */
+    union
+    {
+        int64_t          integer;
+        double           number;
+        int              boolean;
+    } value;
+    union
+    {
+        int64_t          integer;
+        double           number;
+    } increment;                                                /*!< Amount not sent yet, in the type of the value   */
+    char                 text[ PARSE_OBJECT_TEXT_MAX_LEN + 1 ]; /*!< A string value, or the zero separated additions */
+} parse_object_field_t;
+
+/*! \struct parse_object_t
+ *  \brief A handle on an object of a class, see parse_object_init().
+ */
+typedef struct
+{
+    char                     class_name[ PARSE_OBJECT_CLASS_MAX_LEN + 1 ];
+    char                     object_id [ OBJECT_ID_MAX_LEN + 1 ];           /*!< Empty until the object is created */
+    char                     updated_at[ PARSE_OBJECT_DATE_MAX_LEN + 1 ];   /*!< Of the last save                  */
+    uint8_t                  field_count;
+    parse_request_callback_t callback;                                      /*!< Of the save in progress           */
+    wiced_result_t           result;                                        /*!< Of the last save                  */
+    parse_object_field_t     fields[ PARSE_OBJECT_MAX_FIELDS ];
+} parse_object_t;
+#endif /* PARSE_ENABLE_OBJECTS */
+
+#ifdef PARSE_ENABLE_QUERY_CURSOR
+/*! \struct parse_query_t
+ *  \brief A cursor over the objects of a query, see parse_query_open().
+ *
+ *  The cursor owns its connection and the window its pages are received in, so it is
+ *  large: keep it static or in the application's own state rather than on a stack.
+ */
+typedef struct
+{
+    parse_client_t*            client;
+    char                       class_name    [ PARSE_QUERY_CLASS_MAX_LEN + 1 ];
+    char                       where         [ PARSE_QUERY_WHERE_MAX_LEN + 1 ]; /*!< Members of the constraints, without the braces */
+    char                       keys          [ PARSE_QUERY_KEYS_MAX_LEN  + 1 ];
+    char                       last_object_id[ OBJECT_ID_MAX_LEN         + 1 ]; /*!< Of the last page, the next one starts after it */
+    uint16_t                   limit;                                           /*!< Objects per page, halved if a page overflows   */
+    uint8_t                    connected;
+    uint8_t                    reused;                                          /*!< The pending request went on a kept connection  */
+    uint8_t                    requested;                                       /*!< The next page is on its way                    */
+    uint8_t                    finished;                                        /*!< The last page was received                     */
+    int                        http_status;                                     /*!< Of the last page, 0 if none was received       */
+    wiced_result_t             result;                                          /*!< Of the last page                               */
+    uint32_t                   pages;
+    uint32_t                   objects;                                         /*!< Returned by parse_query_next()                 */
+    uint32_t                   connects;
+    simple_json_value_t        results;                                         /*!< Array of the page in the window                */
+    size_t                     offset;                                          /*!< Of the next object in results                  */
+    wiced_tcp_socket_t         socket;
+    wiced_tls_simple_context_t tls_context;
+    char                       window[ PARSE_QUERY_WINDOW_SIZE ];
+} parse_query_t;
+#endif /* PARSE_ENABLE_QUERY_CURSOR */
+
+struct _parse_client_t
+{
+    char                           app_id                [ APPLICATION_ID_MAX_LEN    + 1];
+    char                           client_key            [ CLIENT_KEY_MAX_LEN        + 1];
+    char                           session_token         [ SESSION_TOKEN_MAX_LEN     + 1];
+    char                           installation_id       [ INSTALLATION_ID_MAX_LEN   + 1];
+    char                           installation_id_string[ INSTALLATION_ID_MAX_LEN*2 + 1];
+    char                           installationObjectId  [ OBJECT_ID_MAX_LEN         + 1];
+    parse_installation_callback_t  installation_callback;
+    parse_push_callback_t          push_callback;
+    parse_push_decoded_callback_t  push_decoded_callback;
+    wiced_tcp_socket_t             tcp_socket;
+    volatile int                   push_socket_connected;
+    volatile int                   push_socket_stop;
+    char                           parse_buffer[ RESPONSE_SIZE ];
+#ifdef USE_STREAM
+    wiced_tcp_stream_t             tcp_stream;
+#endif
+#ifdef PARSE_ENABLE_LATENCY_STATS
+    parse_latency_record_t         latency;
+    parse_latency_callback_t       latency_callback;
+#endif
+#ifdef PARSE_ENABLE_ASYNC_INIT
+    parse_bootstrap_t              bootstrap;
+#endif
+#ifdef PARSE_ENABLE_TELEMETRY
+    parse_telemetry_t              telemetry;
+#endif
+#ifdef PARSE_ENABLE_OBJECTS
+    parse_object_t*                object;       /* Being saved by parse_object_save() */
+#endif
+};
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/*! \fn wiced_result_t parse_init( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id )
+ *  \brief Initialize the Parse client and user session
+ *
+ *  This method only initializes the Parse client, used for subsequent API requests. It does
+ *  not start the push service, and does not create or load the installation object for the client.
+ *
+ *  \param[in]  client            A pointer to a parse_client_t object          (required)
+ *  \param[in]  application_id    The application id for the Parse application. (required)
+ *  \param[in]  client_key        The client API key for the Parse application. (required)
+ *  \param[in]  installation_id   The installation ID to be used by the client  (optional)
+ *
+ *  \result                       wiced_result_t
+ *
+ *  The caller retains ownership of the applicationId and clientKey buffers, and is responsible for
+ *  freeing them and reclaiming the memory after this call.
+ *  The SDK will make copies of the buffers.
+ */
+wiced_result_t parse_init( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id );
+
+/*! \fn wiced_result_t parse_init_with_installation( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id, const char* installation_object_id, parse_installation_callback_t callback )
+ *  \brief Initialize the Parse client with a stored installation
+ *
+ *  Same as parse_init(), but when both the installation id and the object id of its
+ *  installation are given, the installation is not looked up or created and no request
+ *  is made. Otherwise the installation is resolved as by parse_init(), and callback
+ *  reports the ids to store.
+ *
+ *  \param[in]  client                 A pointer to a parse_client_t object          (required)
+ *  \param[in]  application_id         The application id for the Parse application. (required)
+ *  \param[in]  client_key             The client API key for the Parse application. (required)
+ *  \param[in]  installation_id        The installation ID to be used by the client  (optional)
+ *  \param[in]  installation_object_id The stored object id of that installation     (optional)
+ *  \param[in]  callback               Called when the installation is resolved      (optional)
+ *
+ *  \result                            wiced_result_t
+ *
+ *  The object id must have been stored for the same installation id, the SDK cannot check it
+ *  without a request.
+ */
+wiced_result_t parse_init_with_installation( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id, const char* installation_object_id, parse_installation_callback_t callback );
+
+/*! \fn void parse_set_installation_id( parse_client_t* client, const char* installationId )
+ *  \brief Set the installation object id for this client.
+ *
+ *  Set the installation object id for this client. If this is not called before making an
+ *  API request or starting push service, the SDK will create a new installation object for
+ *  the client.
+ *
+ *  \param[in]  client           The Parse client for which the installation id will be set.
+ *  \param[in]  installationId   The installation id to be used by the client.
+ *
+ *  The caller retains ownership of the installationId buffer, and is responsible for
+ *  freeing it and reclaiming the memory after this call.
+ *  The SDK will make copies of the buffer.
+ */
+void parse_set_installation_id( parse_client_t* client, const char* installationId );
+
+/*! \fn const char* parse_get_installation_id( parse_client_t* client )
+ *  \brief Return the client installation id
+ *
+ *  Return the installation id for the client. If called before the installation id for the
+ *  client was set, this method will NOT create a new installation object.
+ *  The typical usage scenario is:
+ *
+ *  1.   Call parseInitialize().
+ *  2.   Call parse_get_installation_id().
+ *  3.a. If the result is not NULL, the SDK has a previous installation id,
+ *       there's nothing else to do.
+ *       Otherwise:
+ *  3.b.1. If the device has already an installation id, call parse_set_installation_id().
+ *  3.b.2. If the device doesn't have an installation id, the SDK will generate one
+ *         the first time it needs it.
+ *
+ *  \param[in]  client           The Parse client for which the installation id should be returned.
+ *
+ *  \result                      The installation id.
+ *
+ *  The SDK retains ownership of the result buffer, and still owns it after
+ *  this call. Do not free it.
+ */
+const char* parse_get_installation_id( parse_client_t* client );
+
+/*! \fn const char* parse_get_installation_object_id( parse_client_t* client )
+ *  \brief Return the object id of the client installation
+ *
+ *  \param[in]  client           The Parse client.
+ *
+ *  \result                      The object id, or NULL if the installation is not resolved.
+ *
+ *  The SDK retains ownership of the result buffer. Do not free it.
+ */
+const char* parse_get_installation_object_id( parse_client_t* client );
+
+/*! \fn void parse_set_session_token( parse_client_t* client, const char* sessionToken )
+ *  \brief Set the session token for the Parse client
+ *
+ *  \param[in]  client           The Parse client for which the session token is set.
+ *  \param[in]  sessionToken     The new session token. All subsequent API calls will
+ *                               use this token for authentication and authorization.
+ *                               If this is NULL, the client will be unauthenticated.
+ *
+ *  The caller retains ownership of the sessionToken buffer, and is responsible for
+ *  freeing it and reclaiming the memory after this call.
+ *  The SDK will make copies of the buffer.
+ */
+void parse_set_session_token( parse_client_t* client, const char* sessionToken );
+
+/*! \fn void parseClearSessionToken(ParseClient client)
+ *  \brief Clear the session token
+ *
+ *  Same as parse_set_session_token(client, NULL);
+ */
+void parseClearSessionToken( parse_client_t* client );
+
+/*! \fn const char* parse_get_session_token( parse_client_t* client )
+ *  \brief Return the client session token.
+ *
+ *  Return the session token for the client, or NULL if there isn't one.
+ *
+ *  \param[in]  client           The Parse client for which the session token should be returned.
+ *
+ *  \result                      The session token.
+ *
+ *  The SDK retains ownership of the result buffer, and still owns it after
+ *  this call. Do not free it.
+ */
+const char* parse_get_session_token( parse_client_t* client );
+
+/*! \fn void parse_set_push_callback( parse_client_t* client, parse_push_callback_t callback )
+ *  \brief Set the callback for push notifications and errors
+ *
+ *  This method sets or clears the callback for push notifications and errors from
+ *  the push service, associated with this client.
+ *
+ *  This method DOES NOT start or stop the push service.
+ *
+ *  \param[in]  client           The Parse client for which the callback is set.
+ *  \param[in]  callback         The new callback method. All subsequent push notifications
+ *                               or errors will result  in a call to this callback method.
+ *                               If this parameter is NULL, the callback will be removed.
+ *
+ *  Any push notifications received while there is no callback associated with the client
+ *  will be skipped, and the application will not received them.
+ */
+void parse_set_push_callback( parse_client_t* client, parse_push_callback_t callback );
+
+/*! \fn void parse_set_push_decoded_callback( parse_client_t* client, parse_push_decoded_callback_t callback )
+ *  \brief Set the callback for decoded push notifications and errors
+ *
+ *  Same as parse_set_push_callback(), but the notification is also decoded in a single pass
+ *  and delivered alongside the raw data. Both callbacks can be set at the same time. The
+ *  notification is only decoded when this callback is set.
+ *
+ *  \param[in]  client           The Parse client for which the callback is set.
+ *  \param[in]  callback         The new callback method, or NULL to remove it.
+ */
+void parse_set_push_decoded_callback( parse_client_t* client, parse_push_decoded_callback_t callback );
+
+/*! \fn wiced_result_t parse_push_decode( const char* data, size_t data_size, parse_push_t* push )
+ *  \brief Decode a push notification.
+ *
+ *  The notification is scanned once. Well-known fields (alert, title, badge, sound, channels,
+ *  time, push_id) are stored in the corresponding members, any other member of the notification
+ *  data is stored as a custom field. Custom fields after the first PARSE_PUSH_MAX_CUSTOM_FIELDS
+ *  are dropped.
+ *
+ *  \param[in]  data             The raw notification. Does not need to be NULL terminated.
+ *  \param[in]  data_size        The size of the notification in bytes.
+ *  \param[out] push             The decoded notification.
+ *
+ *  \result                      WICED_SUCCESS if decoded, WICED_ERROR if the data is not a JSON object
+ *                               or is not valid UTF-8.
+ *
+ *  The result points into the data buffer, which must outlive it.
+ */
+wiced_result_t parse_push_decode( const char* data, size_t data_size, parse_push_t* push );
+
+/*! \fn unsigned int parse_push_get_custom_count( const parse_push_t* push )
+ *  \brief Return the number of custom data fields in a decoded push notification.
+ */
+unsigned int parse_push_get_custom_count( const parse_push_t* push );
+
+/*! \fn const parse_push_field_t* parse_push_get_custom( const parse_push_t* push, unsigned int index )
+ *  \brief Return a custom data field by index, or NULL if the index is out of range.
+ */
+const parse_push_field_t* parse_push_get_custom( const parse_push_t* push, unsigned int index );
+
+/*! \fn const simple_json_value_t* parse_push_find_custom( const parse_push_t* push, const char* key )
+ *  \brief Return the value of a custom data field by name, or NULL if there is no such field.
+ */
+const simple_json_value_t* parse_push_find_custom( const parse_push_t* push, const char* key );
+
+/*! \fn int parse_start_push_service( parse_client_t* client )
+ *  \brief Start the push notifications service.
+ *
+ *  This method will start the push notification service and will listen for incoming
+ *  push notifications. If the push service is already started, this will do nothing.
+ *  To actually process incoming push notifications, it is still necessary to repeatedly
+ *  call parse_process_next_push_notification() or call parseRunPushLoop().
+ *
+ *  \param[in]  client           The Parse client for which the service should be started.
+ *
+ *  \result                      OS-specific error if the push can't be started or 0 if
+ *                               started successfully.
+ *
+ *  If a push callback has been set for the client, any errors during starting the service will
+ *  passed to it as well.
+ *
+ */
+int parse_start_push_service( parse_client_t* client );
+
+/*! \fn void parse_stop_push_service( parse_client_t* client )
+ *  \brief Stop the push notifications service.
+ *
+ *  This method will stop the push notification service. If the push service is not started,
+ *  this will do nothing.
+ *
+ *  \param[in]  client           The Parse client for which the service should be stopped.
+ */
+void parse_stop_push_service( parse_client_t* client );
+
+/*! \fn int parse_process_next_push_notification( parse_client_t* client )
+ *  \brief Process next pending push notification.
+ *
+ *  Push notifications are processed one at a time. This method will process the next push
+ *  notification and will call the client callback, if one is set.
+ *
+ *  \param[in]  client           The Parse client for which the next event should be processed.
+ *
+ *  \result                      0 if there are no more pending notification events or the push
+ *                               service is not started.
+ *                               Positive number if there are more pending notification events.
+ *
+ *  If the push notifications callback has been set for the client, it will also be called in
+ *  the case of an error during the processing of the notification. If the callback is not set,
+ *  the client will not get notified about any errors that during the processing of the notification.
+ */
+int parse_process_next_push_notification( parse_client_t* client );
+
+/*! \fn void parseRunPushLoop(ParseClient client)
+ *  \brief Process push notifications events in a loop.
+ *
+ *  This method will keep processing the push notification events for the client and will call
+ *  the client callback for each one. If the push notification service for the client is not
+ *  started or is stopped, this method will exit.
+ *
+ *  \param[in]  client           The Parse client for which the push events should be processed.
+ */
+void parse_run_push_loop( parse_client_t* client );
+
+/*! \fn void parse_send_request( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback )
+ *  \brief Send an API request.
+ *
+ *  This method makes an API request for the client. If called before installation id for the client
+ *  is set, this will also create a new installation object.
+ *
+ *  The API requests supported are any valid requests that can be made through the REST API as well.
+ *
+ *  \param[in]  client           The Parse client for which the request is made.
+ *  \param[in]  httpVerb         The type of request - POST, GET, PUT, DELETE
+ *  \param[in]  httpPath         The path for the request, i.e. /1/classes/MyClass
+ *  \param[in]  httpRequestBody  The JSON payload for the request
+ *  \param[in]  callback         The callback to process the result  of the request.
+ *
+ *  The caller retains ownership of the httpVerb, httpPath, and requestBody buffers, and is responsible for
+ *  freeing them and reclaiming the memory after this call.
+ */
+void parse_send_request( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback );
+
+/*! \fn int parse_get_error_code( const char* httpResponseBody )
+ *  \brief Extract Parse error code.
+ *
+ *  Helper function to extract Parse errors from the response body, when httpStatus of the response is 4xx or 5xx.
+ *  TODO: Link to the public documentation of the Parse error codes
+ *
+ *  \param[in]  httpResponseBody The response body for the request.
+ *
+ *  \result                      Return the error code from the server, or -1 if the body does
+ *                               not contain one (or is NULL).
+ *
+ *  The code is read in place, without copying the body.
+ *
+ * The caller retains ownership of the httpResponseBody buffer, and is responsible for
+ * freeing it and reclaiming the memory after this call.
+ */
+int parse_get_error_code( const char* httpResponseBody );
+
+#ifdef PARSE_ENABLE_LATENCY_STATS
+/*! \fn const parse_latency_record_t* parse_get_request_latency( parse_client_t* client )
+ *  \brief Get the timing of the client's last API request.
+ *
+ *  Call it from the request callback to get the timing of that request.
+ *
+ *  \param[in]  client           The Parse client.
+ *
+ *  \result                      The record, owned by the client and overwritten by the next request.
+ */
+const parse_latency_record_t* parse_get_request_latency( parse_client_t* client );
+
+/*! \fn void parse_set_latency_callback( parse_client_t* client, parse_latency_callback_t callback )
+ *  \brief Set a callback that receives the timing of every API request of the client.
+ *
+ *  \param[in]  client           The Parse client.
+ *  \param[in]  callback         The callback, or NULL to stop.
+ */
+void parse_set_latency_callback( parse_client_t* client, parse_latency_callback_t callback );
+
+/*! \fn wiced_result_t parse_get_latency_percentiles( parse_endpoint_t endpoint, parse_latency_phase_t phase, parse_latency_percentiles_t* percentiles )
+ *  \brief Get the latency distribution of one phase of one endpoint, over all clients.
+ *
+ *  The histograms are locked while requests of other threads are added, so this can be
+ *  called from any thread.
+ *
+ *  \param[in]  endpoint         The endpoint.
+ *  \param[in]  phase            The phase, PARSE_LATENCY_TOTAL for whole requests.
+ *  \param[out] percentiles      The distribution.
+ *
+ *  \result                      WICED_SUCCESS, or WICED_BADARG for an unknown endpoint or phase.
+ */
+wiced_result_t parse_get_latency_percentiles( parse_endpoint_t endpoint, parse_latency_phase_t phase, parse_latency_percentiles_t* percentiles );
+
+/*! \fn void parse_reset_latency_stats( void )
+ *  \brief Clear the latency histograms of all endpoints.
+ */
+void parse_reset_latency_stats( void );
+
+/*! \fn const char* parse_get_latency_phase_name( parse_latency_phase_t phase )
+ *  \brief Get a short name of a phase, for reports.
+ */
+const char* parse_get_latency_phase_name( parse_latency_phase_t phase );
+
+/*! \fn const char* parse_get_endpoint_name( parse_endpoint_t endpoint )
+ *  \brief Get a short name of an endpoint, for reports.
+ */
+const char* parse_get_endpoint_name( parse_endpoint_t endpoint );
+
+/*! \fn void parse_print_latency_stats( void )
+ *  \brief Print p50/p90/p99 of every phase of every endpoint that has been used.
+ */
+void parse_print_latency_stats( void );
+#endif /* PARSE_ENABLE_LATENCY_STATS */
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+/*! \fn wiced_result_t parse_get_memory_usage( parse_memory_buffer_t buffer, parse_memory_usage_t* usage )
+ *  \brief Get the peak usage of one of the library's buffers, over all clients.
+ *
+ *  \param[in]  buffer           The buffer.
+ *  \param[out] usage            Its size and peak usage.
+ *
+ *  \result                      WICED_SUCCESS, or WICED_BADARG for an unknown buffer.
+ */
+wiced_result_t parse_get_memory_usage( parse_memory_buffer_t buffer, parse_memory_usage_t* usage );
+
+/*! \fn const char* parse_get_memory_buffer_name( parse_memory_buffer_t buffer )
+ *  \brief Get a short name of a buffer, for reports.
+ */
+const char* parse_get_memory_buffer_name( parse_memory_buffer_t buffer );
+
+/*! \fn wiced_result_t parse_paint_stack( const char* name, void* stack, uint32_t size )
+ *  \brief Paint a thread stack so its high-water mark can be measured.
+ *
+ *  Call it on a stack passed to wiced_rtos_create_thread_with_stack(), before the
+ *  thread is created. A stack painted under a name that is already in the report
+ *  replaces it, e.g. the stack of a thread that was deleted and created again. With
+ *  PARSE_ENABLE_ASYNC_INIT the two worker threads of parse_init_async() paint their own
+ *  stacks and take two of the PARSE_MEMORY_MAX_STACKS entries.
+ *
+ *  \param[in]  name             Name in reports, the SDK keeps the pointer.
+ *  \param[in]  stack            The stack.
+ *  \param[in]  size             Its size in bytes.
+ *
+ *  \result                      WICED_SUCCESS, or WICED_OUT_OF_HEAP_SPACE when
+ *                               PARSE_MEMORY_MAX_STACKS stacks are painted already.
+ */
+wiced_result_t parse_paint_stack( const char* name, void* stack, uint32_t size );
+
+/*! \fn wiced_result_t parse_paint_current_stack( const char* name, uint32_t size )
+ *  \brief Paint the unused part of the calling thread's stack.
+ *
+ *  For threads whose stack is not the application's, like the one running application_start().
+ *  Paints size bytes below the caller's frame, so usage is measured from the point of the
+ *  call. size must be less than what is left of the stack there, e.g. APPLICATION_STACK_SIZE
+ *  minus a margin when called first thing in application_start(). Assumes the stack grows down.
+ *
+ *  \param[in]  name             Name in reports, the SDK keeps the pointer.
+ *  \param[in]  size             Bytes to paint.
+ *
+ *  \result                      WICED_SUCCESS, or WICED_OUT_OF_HEAP_SPACE when
+ *                               PARSE_MEMORY_MAX_STACKS stacks are painted already.
+ */
+wiced_result_t parse_paint_current_stack( const char* name, uint32_t size );
+
+/*! \fn wiced_result_t parse_get_stack_usage( uint32_t index, parse_stack_usage_t* usage )
+ *  \brief Get the high-water mark of a painted stack.
+ *
+ *  \param[in]  index            0 for the first stack painted, and so on.
+ *  \param[out] usage            Its size and high-water mark.
+ *
+ *  \result                      WICED_SUCCESS, or WICED_NOT_FOUND past the last stack.
+ */
+wiced_result_t parse_get_stack_usage( uint32_t index, parse_stack_usage_t* usage );
+
+/*! \fn void parse_reset_memory_stats( void )
+ *  \brief Clear the peak usage of all buffers. Stacks keep their high-water marks.
+ */
+void parse_reset_memory_stats( void );
+
+/*! \fn void parse_print_memory_stats( void )
+ *  \brief Print size, peak and headroom of every buffer and painted stack.
+ */
+void parse_print_memory_stats( void );
+#endif /* PARSE_ENABLE_MEMORY_STATS */
+
+#ifdef PARSE_ENABLE_TRACE
+/*! \fn uint32_t parse_trace_dump( binary_trace_output_t output, void* context )
+ *  \brief Dump the library's trace ring in binary.
+ *
+ *  The events are listed in parse_trace_events.h. Format the dump with
+ *  tools/binary_trace/binary_trace_decode.py.
+ *
+ *  \param[in]  output           Receives the header and then one record at a time.
+ *  \param[in]  context          Passed to output.
+ *
+ *  \result                      The number of records dumped.
+ */
+uint32_t parse_trace_dump( binary_trace_output_t output, void* context );
+
+/*! \fn void parse_trace_print( void )
+ *  \brief Print the library's trace ring as hex lines, for capture from the console.
+ */
+void parse_trace_print( void );
+
+/*! \fn void parse_trace_reset( void )
+ *  \brief Empty the library's trace ring.
+ */
+void parse_trace_reset( void );
+#endif /* PARSE_ENABLE_TRACE */
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+/*! \fn wiced_result_t parse_init_async( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id, const char* installation_object_id, parse_installation_callback_t installation_callback, parse_ready_callback_t ready_callback )
+ *  \brief Initialize the Parse client without waiting for the network
+ *
+ *  Same as parse_init_with_installation() followed by parse_start_push_service(), but both
+ *  run in parallel on the library's worker threads and the call returns at once. Requests
+ *  made with parse_send_request() before the installation is resolved are queued, up to
+ *  PARSE_DEFERRED_REQUEST_COUNT requests and PARSE_DEFERRED_REQUEST_SIZE bytes, and sent
+ *  in order once it is. Their callbacks run on the worker thread. Telemetry uploads and
+ *  parse_object_save() write their bodies as they are sent, so they cannot be queued: until
+ *  then they fail with WICED_NOT_CONNECTED, and the samples and changes are kept for the next
+ *  attempt.
+ *
+ *  \param[in]  client                 A pointer to a parse_client_t object          (required)
+ *  \param[in]  application_id         The application id for the Parse application. (required)
+ *  \param[in]  client_key             The client API key for the Parse application. (required)
+ *  \param[in]  installation_id        The installation ID to be used by the client  (optional)
+ *  \param[in]  installation_object_id The stored object id of that installation     (optional)
+ *  \param[in]  installation_callback  Called when the installation is resolved      (optional)
+ *  \param[in]  ready_callback         Called when the bootstrap is finished         (optional)
+ *
+ *  \result                            WICED_SUCCESS if the bootstrap was started.
+ *
+ *  The client must stay valid while the bootstrap runs. The SDK copies the string
+ *  arguments before returning. The bootstrap keeps an RTOS mutex in the client: call
+ *  parse_async_deinit_client() once it is finished, before the client is initialised
+ *  again or released.
+ *
+ *  The worker stacks are PARSE_ASYNC_INSTALLATION_STACK_SIZE and PARSE_ASYNC_PUSH_STACK_SIZE
+ *  bytes. With PARSE_ENABLE_MEMORY_STATS their high-water marks are in
+ *  parse_print_memory_stats(), to check the sizes against the TLS library of the target.
+ */
+wiced_result_t parse_init_async( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id, const char* installation_object_id, parse_installation_callback_t installation_callback, parse_ready_callback_t ready_callback );
+
+/*! \fn wiced_result_t parse_async_deinit_client( parse_client_t* client )
+ *  \brief Release what the bootstrap of parse_init_async() keeps in a client
+ *
+ *  The bootstrap is finished once both paths are done and the requests queued during it
+ *  are sent, which can be after the ready callback. Call it again later if it is not, not
+ *  from the callbacks of the queued requests and not while another thread makes requests
+ *  on the client. Clients that were not initialised with parse_init_async() have nothing
+ *  to release.
+ *
+ *  \param[in]  client           The Parse client.
+ *
+ *  \result                      WICED_SUCCESS, or WICED_PENDING while the bootstrap runs.
+ */
+wiced_result_t parse_async_deinit_client( parse_client_t* client );
+
+/*! \fn void parse_async_deinit( void )
+ *  \brief Delete the worker threads of parse_init_async()
+ *
+ *  Call it once no bootstrap is running, to get their stacks back.
+ */
+void parse_async_deinit( void );
+#endif /* PARSE_ENABLE_ASYNC_INIT */
+
+#ifdef PARSE_ENABLE_TELEMETRY
+/*! \fn wiced_result_t parse_telemetry_init( parse_client_t* client, const char* class_name, const parse_telemetry_config_t* config, parse_request_callback_t callback )
+ *  \brief Start buffering telemetry for the client
+ *
+ *  Samples are kept in the client, a column of times and one of values per metric, and
+ *  uploaded together instead of one request per sample. Each metric with samples becomes
+ *  one object of the class:
+ *
+ *      {"metric":"temperature","installationId":"...","t0":1444000000000,"dt":[0,1000],"v":[21.5,21.6]}
+ *
+ *  t0 is the wall clock time of the first sample in milliseconds and dt the offsets of all
+ *  of them from it. A single object is created with a POST to the class, several with one
+ *  /1/batch request.
+ *
+ *  With PARSE_TELEMETRY_ENCODING_TIME_SERIES the offsets and values are packed by
+ *  time_series_encode() instead, typically to a few bits per sample:
+ *
+ *      {"metric":"temperature","installationId":"...","t0":1444000000000,"n":2,"enc":"ts1","data":"QawAAOPo4PzM0A=="}
+ *
+ *  tools/time_series has the decoders, time_series_decode.js for Cloud Code.
+ *
+ *  Uploads happen when a threshold of the configuration is reached, and right after the
+ *  client's other requests once the oldest sample is piggyback_age_ms old, while the radio
+ *  is still awake. They are synchronous and run in the thread that made the call.
+ *
+ *  \param[in]  client           The Parse client, after its initialisation.
+ *  \param[in]  class_name       The class the samples are uploaded to.
+ *  \param[in]  config           The thresholds, NULL for 32 samples, 640 bytes, 60 s and 10 s.
+ *  \param[in]  callback         Called with the result of every upload (optional)
+ *
+ *  \result                      WICED_BADARG if the class name is too long or max_samples is
+ *                               larger than PARSE_TELEMETRY_MAX_SAMPLES.
+ */
+wiced_result_t parse_telemetry_init( parse_client_t* client, const char* class_name, const parse_telemetry_config_t* config, parse_request_callback_t callback );
+
+/*! \fn int parse_telemetry_add_metric( parse_client_t* client, const char* name )
+ *  \brief Add a metric to the client's telemetry
+ *
+ *  \param[in]  client           The Parse client.
+ *  \param[in]  name             The name of the metric, at most PARSE_TELEMETRY_NAME_MAX_LEN characters.
+ *
+ *  \result                      The id of the metric for parse_telemetry_record(), the existing one if
+ *                               the name was already added, or -1 if there is no room.
+ */
+int parse_telemetry_add_metric( parse_client_t* client, const char* name );
+
+/*! \fn wiced_result_t parse_telemetry_record( parse_client_t* client, int metric, float value )
+ *  \brief Record a sample, timestamped now
+ *
+ *  The buffered samples are uploaded first if this one would go over max_samples or
+ *  max_bytes, and after it if the oldest is max_age_ms old. While uploads fail, a full
+ *  metric overwrites its oldest sample.
+ *
+ *  \param[in]  client           The Parse client.
+ *  \param[in]  metric           The id from parse_telemetry_add_metric().
+ *  \param[in]  value            The sample.
+ *
+ *  \result                      WICED_SUCCESS if the sample was buffered.
+ */
+wiced_result_t parse_telemetry_record( parse_client_t* client, int metric, float value );
+
+/*! \fn wiced_result_t parse_telemetry_poll( parse_client_t* client )
+ *  \brief Upload the buffered samples if they are max_age_ms old
+ *
+ *  Call it periodically when samples may stop coming, parse_telemetry_record() checks the
+ *  age itself.
+ *
+ *  \param[in]  client           The Parse client.
+ *
+ *  \result                      The result of the upload, or WICED_SUCCESS if there was none.
+ */
+wiced_result_t parse_telemetry_poll( parse_client_t* client );
+
+/*! \fn wiced_result_t parse_telemetry_flush( parse_client_t* client )
+ *  \brief Upload the buffered samples now
+ *
+ *  \param[in]  client           The Parse client.
+ *
+ *  \result                      The result of the upload, or WICED_SUCCESS if nothing was buffered.
+ *                               The samples are kept if it failed.
+ */
+wiced_result_t parse_telemetry_flush( parse_client_t* client );
+#endif /* PARSE_ENABLE_TELEMETRY */
+
+#ifdef PARSE_ENABLE_OBJECTS
+/*! \fn wiced_result_t parse_object_init( parse_object_t* object, const char* class_name, const char* object_id )
+ *  \brief Start a handle on an object
+ *
+ *  The handle keeps the fields the application sets and what changed in each of them since
+ *  the last save, so that parse_object_save() sends only those:
+ *
+ *      PUT /1/classes/Device/Ed1nuqPvcm  {"name":"hall","boots":{"__op":"Increment","amount":1}}
+ *
+ *  Fields are set without knowing the rest of the object, nothing is fetched.
+ *
+ *  \param[in]  object           The handle.
+ *  \param[in]  class_name       The class of the object.
+ *  \param[in]  object_id        The id of an existing object, or NULL to create one on the first save.
+ *
+ *  \result                      WICED_BADARG if a name or id is too long.
+ */
+wiced_result_t parse_object_init( parse_object_t* object, const char* class_name, const char* object_id );
+
+/*! \fn wiced_result_t parse_object_set_int( parse_object_t* object, const char* key, int64_t value )
+ *  \brief Set a field to a value
+ *
+ *  The parse_object_set functions add the field if the handle does not have it yet, change its
+ *  type if it had another, and replace any increment or additions not saved yet.
+ *
+ *  \param[in]  object           The handle.
+ *  \param[in]  key              The field, at most PARSE_OBJECT_KEY_MAX_LEN characters.
+ *  \param[in]  value            The value.
+ *
+ *  \result                      WICED_BADARG if the key is too long, WICED_OUT_OF_HEAP_SPACE if the
+ *                               handle has no room for another field.
+ */
+wiced_result_t parse_object_set_int( parse_object_t* object, const char* key, int64_t value );
+
+/*! \fn wiced_result_t parse_object_set_double( parse_object_t* object, const char* key, double value )
+ *  \brief Set a field to a number, see parse_object_set_int()
+ */
+wiced_result_t parse_object_set_double( parse_object_t* object, const char* key, double value );
+
+/*! \fn wiced_result_t parse_object_set_bool( parse_object_t* object, const char* key, int value )
+ *  \brief Set a field to a boolean, see parse_object_set_int()
+ */
+wiced_result_t parse_object_set_bool( parse_object_t* object, const char* key, int value );
+
+/*! \fn wiced_result_t parse_object_set_string( parse_object_t* object, const char* key, const char* value )
+ *  \brief Set a field to a string of at most PARSE_OBJECT_TEXT_MAX_LEN bytes, see parse_object_set_int()
+ */
+wiced_result_t parse_object_set_string( parse_object_t* object, const char* key, const char* value );
+
+/*! \fn wiced_result_t parse_object_increment( parse_object_t* object, const char* key, int64_t amount )
+ *  \brief Add to a counter
+ *
+ *  The amount is sent as an Increment operation, so that increments of other clients are not
+ *  lost, and the local value is replaced by the server's after the save. A field that was set
+ *  and not saved yet simply changes value.
+ *
+ *  \param[in]  object           The handle.
+ *  \param[in]  key              An integer or number field, added as an integer of 0 if there is none.
+ *  \param[in]  amount           The amount, negative to decrement.
+ *
+ *  \result                      WICED_BADARG if the field is not a number.
+ */
+wiced_result_t parse_object_increment( parse_object_t* object, const char* key, int64_t amount );
+
+/*! \fn wiced_result_t parse_object_add_unique( parse_object_t* object, const char* key, const char* value )
+ *  \brief Add a string to an array field unless it is in it already
+ *
+ *  The strings are sent as one AddUnique operation. The handle does not keep the array, only
+ *  the strings added since the last save.
+ *
+ *  \param[in]  object           The handle.
+ *  \param[in]  key              A set field, added if there is none.
+ *  \param[in]  value            The string.
+ *
+ *  \result                      WICED_BADARG if the field is not a set, WICED_OUT_OF_HEAP_SPACE if the
+ *                               additions would not fit PARSE_OBJECT_TEXT_MAX_LEN.
+ */
+wiced_result_t parse_object_add_unique( parse_object_t* object, const char* key, const char* value );
+
+/*! \fn const parse_object_field_t* parse_object_get( const parse_object_t* object, const char* key )
+ *  \brief The field of a handle
+ *
+ *  \result                      NULL if the handle does not have the field.
+ */
+const parse_object_field_t* parse_object_get( const parse_object_t* object, const char* key );
+
+/*! \fn wiced_bool_t parse_object_is_dirty( const parse_object_t* object )
+ *  \brief Whether a save would send anything
+ */
+wiced_bool_t parse_object_is_dirty( const parse_object_t* object );
+
+/*! \fn wiced_result_t parse_object_save( parse_client_t* client, parse_object_t* object, parse_request_callback_t callback )
+ *  \brief Send the changes of an object
+ *
+ *  Creates the object with a POST if it has no id yet, otherwise sends a PUT with the changed
+ *  fields alone. Nothing is sent if nothing changed. After a successful save the handle takes
+ *  the object id, updatedAt and the values of its incremented fields from the response, and
+ *  its fields are unchanged. The changes are kept if it failed, for the next save. An id or
+ *  date of the response that does not fit or does not decode leaves the one of the handle.
+ *
+ *  The request is synchronous and runs in the thread that made the call. While
+ *  parse_init_async() resolves the installation it is not sent and fails with
+ *  WICED_NOT_CONNECTED.
+ *
+ *  \param[in]  client           The Parse client.
+ *  \param[in]  object           The handle.
+ *  \param[in]  callback         Called with the response, after the handle was updated (optional)
+ *
+ *  \result                      WICED_SUCCESS if the object was saved or nothing changed.
+ */
+wiced_result_t parse_object_save( parse_client_t* client, parse_object_t* object, parse_request_callback_t callback );
+#endif /* PARSE_ENABLE_OBJECTS */
+
+#ifdef PARSE_ENABLE_QUERY_CURSOR
+/*! \fn wiced_result_t parse_query_open( parse_client_t* client, parse_query_t* query, const char* class_name, const char* where, const char* keys, uint16_t limit )
+ *  \brief Start a cursor over the objects of a class and request its first page.
+ *
+ *  The objects come in pages of up to limit objects in order of their object id, each page
+ *  asking for the objects after the last one of the previous page rather than skipping a
+ *  count, so pages stay cheap for the server however far the cursor is and objects created
+ *  meanwhile are not returned twice. All pages share one connection, which is kept open
+ *  between them, and the request for the next page is sent as soon as a page arrives so that
+ *  the server works on it while the application goes through the current one.
+ *
+ *  \param[in]  client           The Parse client whose keys and installation the requests use.
+ *  \param[out] query            The cursor.
+ *  \param[in]  class_name       The class to query.
+ *  \param[in]  where            Constraints as a JSON object, e.g. {"device":3}, or NULL for all
+ *                               objects. They cannot constrain objectId, which the cursor uses
+ *                               for its pages: such constraints are WICED_BADARG.
+ *  \param[in]  keys             Comma separated fields to return, or NULL for all of them.
+ *  \param[in]  limit            Objects per page, at most PARSE_QUERY_MAX_LIMIT. A whole page
+ *                               must fit PARSE_QUERY_WINDOW_SIZE, pages that do not are fetched
+ *                               again with half the limit.
+ *
+ *  \result                      WICED_SUCCESS, WICED_BADARG if an argument is too long or
+ *                               invalid, WICED_NOT_CONNECTED while parse_init_async() resolves
+ *                               the installation, or the result of connecting for the first page.
+ *
+ *  Like other requests, the pages are only sent from the thread that calls the cursor. Pages
+ *  are not part of the latency statistics.
+ */
+wiced_result_t parse_query_open( parse_client_t* client, parse_query_t* query, const char* class_name, const char* where, const char* keys, uint16_t limit );
+
+/*! \fn wiced_result_t parse_query_next( parse_query_t* query, simple_json_value_t* object )
+ *  \brief Return the next object of a cursor, receiving the next page when needed.
+ *
+ *  \param[in]  query            The cursor.
+ *  \param[out] object           View of the object in the cursor's window, valid until the
+ *                               next call. Read it with simpleJsonNextMember() or a schema of
+ *                               parse_schema.h.
+ *
+ *  \result                      WICED_SUCCESS, WICED_NOT_FOUND after the last object, or the
+ *                               error of the page: WICED_ERROR with the HTTP status in
+ *                               query->http_status for error responses, WICED_PARTIAL_RESULTS
+ *                               if a single object does not fit the window, WICED_UNSUPPORTED
+ *                               for a page with a Transfer-Encoding such as chunked. Calling it
+ *                               again after an error requests the same page again.
+ */
+wiced_result_t parse_query_next( parse_query_t* query, simple_json_value_t* object );
+
+/*! \fn void parse_query_close( parse_query_t* query )
+ *  \brief Close the connection of a cursor, also when it was not read to the end.
+ */
+void parse_query_close( parse_query_t* query );
+#endif /* PARSE_ENABLE_QUERY_CURSOR */
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
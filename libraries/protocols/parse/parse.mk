@@ -1,46 +1,86 @@
-#
-# Copyright (c) 2015 Broadcom
-# All rights reserved.
-#
-# Redistribution and use in source and binary forms, with or without modification,
-# are permitted provided that the following conditions are met:
-#
-# 1. Redistributions of source code must retain the above copyright notice, this
-# list of conditions and the following disclaimer.
-#
-# 2. Redistributions in binary form must reproduce the above copyright notice, this
-# list of conditions and the following disclaimer in the documentation and/or
-# other materials provided with the distribution.
-#
-# 3. Neither the name of Broadcom nor the names of other contributors to this 
-# software may be used to endorse or promote products derived from this software 
-# without specific prior written permission.
-#
-# 4. This software may not be used as a standalone product, and may only be used as 
-# incorporated in your product or device that incorporates Broadcom wireless connectivity 
-# products and solely for the purpose of enabling the functionalities of such Broadcom products.
-#
-#
-# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
-# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
-# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
-# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
-# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-#
-
-NAME := Lib_Parse
-
-$(NAME)_SOURCES := parse_internal.c \
-                   parse_http.c
-
-$(NAME)_COMPONENTS := utilities/simple_JSON \
-                      utilities/UUID
-
-GLOBAL_INCLUDES += .
-
-
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+NAME := Lib_Parse
+
+$(NAME)_SOURCES := parse_internal.c \
+                   parse_async.c \
+                   parse_latency.c \
+                   parse_memory.c \
+                   parse_trace.c \
+                   parse_telemetry.c \
+                   parse_object.c \
+                   parse_query.c \
+                   parse_http.c \
+                   parse_push.c
+
+$(NAME)_COMPONENTS := utilities/simple_JSON \
+                      utilities/UUID \
+                      utilities/binary_trace \
+                      utilities/time_series
+
+GLOBAL_INCLUDES += .
+
+
+
+# Define PARSE_ENABLE_LATENCY_STATS, e.g. GLOBAL_DEFINES += PARSE_ENABLE_LATENCY_STATS in the
+# application makefile, to time the phases of every API request
+
+# Define PARSE_ENABLE_MEMORY_STATS to measure the peak usage of the library's buffers and the
+# high-water marks of stacks painted with parse_paint_stack() or parse_paint_current_stack()
+
+# Define PARSE_ENABLE_TRACE to record connection and push events in a binary ring, and
+# PARSE_TRACE_LEVEL to drop the events above a level at compile time. The ring is dumped with
+# parse_trace_dump() or parse_trace_print() and decoded by tools/binary_trace/binary_trace_decode.py
+
+# Define PARSE_ENABLE_ASYNC_INIT for parse_init_async(), which resolves the installation and
+# connects the push service in parallel on two worker threads and queues early requests
+
+# Define PARSE_ENABLE_TELEMETRY for parse_telemetry_record(), which buffers sensor samples in the
+# client and uploads them in one request when a size, age or count threshold is reached, or after
+# the client's other requests. PARSE_TELEMETRY_MAX_METRICS and PARSE_TELEMETRY_MAX_SAMPLES size the
+# buffer. The encoding of the configuration selects the compact time series of
+# utilities/time_series instead of JSON number arrays, decoded by tools/time_series
+
+# Define PARSE_ENABLE_OBJECTS for parse_object_save(), which saves the fields of an object handle
+# that changed since the last save, with Increment and AddUnique operations for counters and sets,
+# and merges the object id and updatedAt of the response into the handle
+
+# Define PARSE_ENABLE_QUERY_CURSOR for parse_query_open() and parse_query_next(), which walk the
+# objects of a query page by page in object id order over one kept connection, requesting the next
+# page while the application reads the current one. PARSE_QUERY_WINDOW_SIZE bounds a page
+
+# parse_schema.h is header only: PARSE_SCHEMA_DECLARE() and PARSE_SCHEMA_DEFINE() generate the
+# struct, writer and reader of an object class from an X-macro list of its fields
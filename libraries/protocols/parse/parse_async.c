@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Asynchronous bootstrap of a Parse client
+ *
+ * parse_init_async() sets the installation id at once and hands the two slow
+ * paths to worker threads: resolving the installation, with root certificates
+ * and up to two requests, and connecting the push service. Whichever finishes
+ * last reports readiness, so the device is ready after the slower of the two
+ * instead of both. The paths share no buffer: the push handshake only uses the
+ * push buffers.
+ *
+ * Requests made before the installation is resolved are copied into a small
+ * queue in the client and sent in order by the installation worker. Requests
+ * with a JSON body writer cannot be copied, they fail until then.
+ */
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_async.h"
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/* The installation worker makes TLS requests, the push worker only plain TCP. The library's own
+ * frames on the deepest paths are 0.9 KB and 0.4 KB (gcc -fstack-usage, x86-64), the rest is left
+ * to the target's TLS and DNS. The x86-64 host build against tools/parse_mock peaks at 7.5 KB and
+ * 5.5 KB, almost all of it OpenSSL and glibc's resolver, so it cannot confirm these sizes: check
+ * the worker stacks in parse_print_memory_stats() on the device. */
+#ifndef PARSE_ASYNC_INSTALLATION_STACK_SIZE
+#define PARSE_ASYNC_INSTALLATION_STACK_SIZE  ( 6 * 1024 )
+#endif
+
+#ifndef PARSE_ASYNC_PUSH_STACK_SIZE
+#define PARSE_ASYNC_PUSH_STACK_SIZE          ( 3 * 1024 )
+#endif
+
+/* Left unpainted at the top of a worker stack for the frames above the first event, see
+ * bootstrap_paint_stack(). The painted part is what the report calls the stack's size. */
+#ifndef PARSE_ASYNC_STACK_PAINT_MARGIN
+#define PARSE_ASYNC_STACK_PAINT_MARGIN       ( 1024 )
+#endif
+
+/* Clients that can bootstrap at the same time */
+#ifndef PARSE_ASYNC_EVENT_QUEUE_SIZE
+#define PARSE_ASYNC_EVENT_QUEUE_SIZE         ( 4 )
+#endif
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static wiced_result_t bootstrap_installation ( void* arg );
+static wiced_result_t bootstrap_push         ( void* arg );
+static void           bootstrap_path_done    ( parse_client_t* client );
+static void           send_deferred_requests ( parse_client_t* client );
+#ifdef PARSE_ENABLE_MEMORY_STATS
+static void           bootstrap_paint_stack  ( parse_client_t* client, wiced_bool_t* painted, const char* name, uint32_t size );
+#endif
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static wiced_worker_thread_t installation_worker;
+static wiced_worker_thread_t push_worker;
+static wiced_bool_t          workers_created = WICED_FALSE;
+#ifdef PARSE_ENABLE_MEMORY_STATS
+static wiced_bool_t          installation_stack_painted = WICED_FALSE;
+static wiced_bool_t          push_stack_painted         = WICED_FALSE;
+#endif
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t parse_init_async( parse_client_t* client, const char* application_id, const char* client_key, const char* installation_id, const char* installation_object_id, parse_installation_callback_t installation_callback, parse_ready_callback_t ready_callback )
+{
+    parse_bootstrap_t* bootstrap = &client->bootstrap;
+
+    if ( workers_created == WICED_FALSE )
+    {
+        if ( wiced_rtos_create_worker_thread( &installation_worker, WICED_DEFAULT_LIBRARY_PRIORITY, PARSE_ASYNC_INSTALLATION_STACK_SIZE, PARSE_ASYNC_EVENT_QUEUE_SIZE ) != WICED_SUCCESS )
+        {
+            return WICED_ERROR;
+        }
+        if ( wiced_rtos_create_worker_thread( &push_worker, WICED_DEFAULT_LIBRARY_PRIORITY, PARSE_ASYNC_PUSH_STACK_SIZE, PARSE_ASYNC_EVENT_QUEUE_SIZE ) != WICED_SUCCESS )
+        {
+            wiced_rtos_delete_worker_thread( &installation_worker );
+            return WICED_ERROR;
+        }
+        workers_created = WICED_TRUE;
+    }
+
+    memset( client, 0, sizeof( *client ) );
+
+    strncpy( client->app_id,     application_id, sizeof( client->app_id ) - 1 );
+    strncpy( client->client_key, client_key,     sizeof( client->client_key ) - 1 );
+    client->installation_callback = installation_callback;
+
+    /* The push handshake needs the installation id, not the installation object */
+    bootstrap->installation_step    = parse_prepare_installation( client, installation_id, installation_object_id );
+    bootstrap->installation_pending = 1;
+    bootstrap->paths                = 2;
+    bootstrap->installation_result  = WICED_ERROR;
+    bootstrap->push_result          = WICED_ERROR;
+    bootstrap->ready_callback       = ready_callback;
+    wiced_rtos_init_mutex( &bootstrap->mutex );
+    bootstrap->started              = WICED_TRUE;
+
+    if ( wiced_rtos_send_asynchronous_event( &installation_worker, bootstrap_installation, client ) != WICED_SUCCESS )
+    {
+        bootstrap->installation_pending = 0;
+        bootstrap->started              = WICED_FALSE;
+        wiced_rtos_deinit_mutex( &bootstrap->mutex );
+        return WICED_ERROR;
+    }
+
+    if ( wiced_rtos_send_asynchronous_event( &push_worker, bootstrap_push, client ) != WICED_SUCCESS )
+    {
+        /* The installation still reports readiness, with the push service down */
+        bootstrap_path_done( client );
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t parse_async_deinit_client( parse_client_t* client )
+{
+    parse_bootstrap_t* bootstrap = &client->bootstrap;
+    wiced_bool_t       finished;
+
+    if ( bootstrap->started == WICED_FALSE )
+    {
+        return WICED_SUCCESS;
+    }
+
+    /* The workers leave the mutex for good when they clear these, the last thing they do under it */
+    wiced_rtos_lock_mutex( &bootstrap->mutex );
+    finished = ( bootstrap->paths == 0 && bootstrap->installation_pending == 0 ) ? WICED_TRUE : WICED_FALSE;
+    wiced_rtos_unlock_mutex( &bootstrap->mutex );
+
+    if ( finished == WICED_FALSE )
+    {
+        return WICED_PENDING;
+    }
+
+    bootstrap->started = WICED_FALSE;
+    wiced_rtos_deinit_mutex( &bootstrap->mutex );
+
+    return WICED_SUCCESS;
+}
+
+void parse_async_deinit( void )
+{
+    if ( workers_created != WICED_FALSE )
+    {
+        wiced_rtos_delete_worker_thread( &installation_worker );
+        wiced_rtos_delete_worker_thread( &push_worker );
+        workers_created = WICED_FALSE;
+#ifdef PARSE_ENABLE_MEMORY_STATS
+        /* New workers get new stacks, which replace these in the report */
+        installation_stack_painted = WICED_FALSE;
+        push_stack_painted         = WICED_FALSE;
+#endif
+    }
+}
+
+wiced_bool_t parse_defer_request( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback )
+{
+    parse_bootstrap_t* bootstrap = &client->bootstrap;
+    size_t             verb_size;
+    size_t             path_size;
+    size_t             body_size;
+    wiced_bool_t       deferred  = WICED_TRUE;
+    wiced_bool_t       full      = WICED_FALSE;
+
+    /* It is only ever cleared, clients that did not use parse_init_async() never lock */
+    if ( bootstrap->installation_pending == 0 )
+    {
+        return WICED_FALSE;
+    }
+
+    if ( httpRequestBody == NULL )
+    {
+        httpRequestBody = "";
+    }
+    verb_size = strlen( httpVerb ) + 1;
+    path_size = strlen( httpPath ) + 1;
+    body_size = strlen( httpRequestBody ) + 1;
+
+    wiced_rtos_lock_mutex( &bootstrap->mutex );
+    if ( bootstrap->installation_pending == 0 )
+    {
+        deferred = WICED_FALSE;
+    }
+    else if ( bootstrap->count == PARSE_DEFERRED_REQUEST_COUNT || bootstrap->used + verb_size + path_size + body_size > sizeof( bootstrap->data ) )
+    {
+        full = WICED_TRUE;
+    }
+    else
+    {
+        char* data = &bootstrap->data[ bootstrap->used ];
+
+        bootstrap->requests[ bootstrap->count ].callback = callback;
+        bootstrap->requests[ bootstrap->count ].offset   = bootstrap->used;
+        memcpy( data,                         httpVerb,        verb_size );
+        memcpy( data + verb_size,             httpPath,        path_size );
+        memcpy( data + verb_size + path_size, httpRequestBody, body_size );
+        bootstrap->used = (uint16_t) ( bootstrap->used + verb_size + path_size + body_size );
+        bootstrap->count++;
+    }
+    wiced_rtos_unlock_mutex( &bootstrap->mutex );
+
+    if ( full != WICED_FALSE )
+    {
+        WPRINT_LIB_INFO( ("[Parse] Request queue full, %s %s dropped.\r\n", httpVerb, httpPath) );
+        if ( callback != NULL )
+        {
+            callback( client, WICED_OUT_OF_HEAP_SPACE, 0, NULL );
+        }
+    }
+
+    return deferred;
+}
+
+wiced_bool_t parse_bootstrap_pending( parse_client_t* client )
+{
+    /* Cleared once the queue is sent, after which the caller has the request buffers */
+    return ( client->bootstrap.installation_pending != 0 ) ? WICED_TRUE : WICED_FALSE;
+}
+
+static wiced_result_t bootstrap_installation( void* arg )
+{
+    parse_client_t*    client    = (parse_client_t*) arg;
+    parse_bootstrap_t* bootstrap = &client->bootstrap;
+    wiced_result_t     result;
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    bootstrap_paint_stack( client, &installation_stack_painted, "parse installation worker", PARSE_ASYNC_INSTALLATION_STACK_SIZE - PARSE_ASYNC_STACK_PAINT_MARGIN );
+#endif
+
+    result = parse_resolve_installation( client, (parse_installation_step_t) bootstrap->installation_step );
+    if ( result == WICED_SUCCESS && parse_get_installation_object_id( client ) == NULL )
+    {
+        result = WICED_ERROR;
+    }
+    bootstrap->installation_result = result;
+
+    /* Ready does not wait for the queue, requests made from now on are still queued behind it */
+    bootstrap_path_done( client );
+    send_deferred_requests( client );
+
+    return WICED_SUCCESS;
+}
+
+static wiced_result_t bootstrap_push( void* arg )
+{
+    parse_client_t* client = (parse_client_t*) arg;
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    bootstrap_paint_stack( client, &push_stack_painted, "parse push worker", PARSE_ASYNC_PUSH_STACK_SIZE - PARSE_ASYNC_STACK_PAINT_MARGIN );
+#endif
+
+    client->bootstrap.push_result = ( parse_start_push_service( client ) == 0 ) ? WICED_SUCCESS : WICED_ERROR;
+    bootstrap_path_done( client );
+
+    return WICED_SUCCESS;
+}
+
+static void bootstrap_path_done( parse_client_t* client )
+{
+    parse_bootstrap_t* bootstrap = &client->bootstrap;
+    int                last;
+
+    wiced_rtos_lock_mutex( &bootstrap->mutex );
+    last = ( --bootstrap->paths == 0 );
+    wiced_rtos_unlock_mutex( &bootstrap->mutex );
+
+    if ( last && bootstrap->ready_callback != NULL )
+    {
+        bootstrap->ready_callback( client, bootstrap->installation_result, bootstrap->push_result );
+    }
+}
+
+/* Requests made while these are sent are queued behind them, so they stay in order */
+static void send_deferred_requests( parse_client_t* client )
+{
+    parse_bootstrap_t* bootstrap = &client->bootstrap;
+
+    while ( 1 )
+    {
+        parse_deferred_request_t request;
+        const char*              verb;
+        const char*              path;
+        const char*              body;
+
+        wiced_rtos_lock_mutex( &bootstrap->mutex );
+        if ( bootstrap->next == bootstrap->count )
+        {
+            /* From now on requests are sent by their callers */
+            bootstrap->installation_pending = 0;
+            wiced_rtos_unlock_mutex( &bootstrap->mutex );
+            return;
+        }
+        request = bootstrap->requests[ bootstrap->next++ ];
+        wiced_rtos_unlock_mutex( &bootstrap->mutex );
+
+        verb = &bootstrap->data[ request.offset ];
+        path = verb + strlen( verb ) + 1;
+        body = path + strlen( path ) + 1;
+
+        parse_send_request_now( client, verb, path, body, request.callback );
+    }
+}
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+/* The library does not own the worker stacks, so each worker paints the rest of its own on its
+ * first event. Both workers start with the same client, whose mutex keeps the two from adding
+ * their stacks to the report at the same time. */
+static void bootstrap_paint_stack( parse_client_t* client, wiced_bool_t* painted, const char* name, uint32_t size )
+{
+    wiced_rtos_lock_mutex( &client->bootstrap.mutex );
+    if ( *painted == WICED_FALSE )
+    {
+        parse_paint_current_stack( name, size );
+        *painted = WICED_TRUE;
+    }
+    wiced_rtos_unlock_mutex( &client->bootstrap.mutex );
+}
+#endif
+
+#endif /* PARSE_ENABLE_ASYNC_INIT */
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "wiced.h"
+#include "parse.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* Queues a request made during parse_init_async(), it compiles to false unless PARSE_ENABLE_ASYNC_INIT is defined */
+#ifdef PARSE_ENABLE_ASYNC_INIT
+#define PARSE_DEFER_REQUEST( client, verb, path, body, callback )  parse_defer_request( ( client ), ( verb ), ( path ), ( body ), ( callback ) )
+#else
+#define PARSE_DEFER_REQUEST( client, verb, path, body, callback )  ( WICED_FALSE )
+#endif
+
+/* True while parse_init_async() resolves the installation, it compiles to false unless PARSE_ENABLE_ASYNC_INIT is defined */
+#ifdef PARSE_ENABLE_ASYNC_INIT
+#define PARSE_BOOTSTRAP_PENDING( client )  parse_bootstrap_pending( client )
+#else
+#define PARSE_BOOTSTRAP_PENDING( client )  ( WICED_FALSE )
+#endif
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/* What is left to do for the installation once its ids are set */
+typedef enum
+{
+    PARSE_INSTALLATION_STORED,  /* Both ids were given, nothing to ask the server     */
+    PARSE_INSTALLATION_LOOKUP,  /* Look the given id up, and create it if it is missing */
+    PARSE_INSTALLATION_CREATE   /* The id was generated, create the installation        */
+} parse_installation_step_t;
+
+/******************************************************
+ *                Function Declarations
+ ******************************************************/
+
+/* parse_internal.c, the two halves of parse_init_with_installation() */
+parse_installation_step_t parse_prepare_installation( parse_client_t* client, const char* installation_id, const char* installation_object_id );
+wiced_result_t            parse_resolve_installation( parse_client_t* client, parse_installation_step_t step );
+
+/* parse_internal.c, parse_send_request() without the queue */
+void parse_send_request_now( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback );
+
+#ifdef PARSE_ENABLE_ASYNC_INIT
+wiced_bool_t parse_defer_request( parse_client_t* client, const char* httpVerb, const char* httpPath, const char* httpRequestBody, parse_request_callback_t callback );
+wiced_bool_t parse_bootstrap_pending( parse_client_t* client );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,43 @@
+/*
+ * Generated by tools/json_keyhash/json_keyhash.py, do not edit.
+ * json_keyhash.py --name parse_keys --prefix PARSE_KEY objectId createdAt updatedAt results code error installationId sessionToken
+ */
+#ifndef INCLUDED_PARSE_KEYS_H_
+#define INCLUDED_PARSE_KEYS_H_
+
+#include "simplejson.h"
+
+typedef enum
+{
+    PARSE_KEY_OBJECT_ID       = 0,
+    PARSE_KEY_CREATED_AT      = 1,
+    PARSE_KEY_UPDATED_AT      = 2,
+    PARSE_KEY_RESULTS         = 3,
+    PARSE_KEY_CODE            = 4,
+    PARSE_KEY_ERROR           = 5,
+    PARSE_KEY_INSTALLATION_ID = 6,
+    PARSE_KEY_SESSION_TOKEN   = 7,
+    PARSE_KEY_COUNT           = 8
+} parse_keys_id_t;
+
+static const simple_json_key_t parse_keys_slots[ 8 ] =
+{
+    SIMPLE_JSON_KEY( "sessionToken", PARSE_KEY_SESSION_TOKEN ),
+    SIMPLE_JSON_KEY( "installationId", PARSE_KEY_INSTALLATION_ID ),
+    SIMPLE_JSON_KEY( "error", PARSE_KEY_ERROR ),
+    SIMPLE_JSON_KEY( "results", PARSE_KEY_RESULTS ),
+    SIMPLE_JSON_KEY( "updatedAt", PARSE_KEY_UPDATED_AT ),
+    SIMPLE_JSON_KEY( "objectId", PARSE_KEY_OBJECT_ID ),
+    SIMPLE_JSON_KEY( "code", PARSE_KEY_CODE ),
+    SIMPLE_JSON_KEY( "createdAt", PARSE_KEY_CREATED_AT )
+};
+
+static const simple_json_key_table_t parse_keys =
+{
+    0x00000157UL,
+    7,
+    SIMPLE_JSON_KEY_HASH_SPARSE,
+    parse_keys_slots
+};
+
+#endif /* INCLUDED_PARSE_KEYS_H_ */
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Per-request latency breakdown and per-endpoint histograms
+ *
+ * While a request runs, phase_us[] holds the time since start_us at which
+ * each phase ended, or LATENCY_NOT_REACHED. parse_latency_end() turns these
+ * into durations and adds them to the histograms of the endpoint.
+ *
+ * The histograms are log-linear: 2^LATENCY_SUB_BUCKET_BITS buckets per power
+ * of two, from LATENCY_RESOLUTION_US up to about a minute. With the default
+ * of two buckets per octave a percentile is within a third of the true value,
+ * enough to tell which phase a slow request spent its time in.
+ *
+ * The histograms are shared by all clients, whose requests can end in
+ * different threads, so they are only touched with latency_mutex held. The
+ * mutex is created by the first user, there is no library wide init call.
+ */
+
+#ifdef PARSE_ENABLE_LATENCY_STATS
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_latency.h"
+#include <string.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#ifndef PARSE_LATENCY_CLOCK_US
+#define PARSE_LATENCY_CLOCK_US( )   latency_clock_us( )
+#define LATENCY_USE_WICED_TIME
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define LATENCY_NOT_REACHED         ( 0xFFFFFFFF )
+
+#ifndef LATENCY_SUB_BUCKET_BITS
+#define LATENCY_SUB_BUCKET_BITS     ( 1 )
+#endif
+#define LATENCY_SUB_BUCKETS         ( 1 << LATENCY_SUB_BUCKET_BITS )
+#define LATENCY_RESOLUTION_SHIFT    ( 6 )     /* 64us, below the resolution of the target's clock */
+#define LATENCY_OCTAVES             ( 20 )    /* Up to 2^26us, about 67s */
+#define LATENCY_BUCKETS             ( ( LATENCY_OCTAVES - LATENCY_SUB_BUCKET_BITS + 1 ) * LATENCY_SUB_BUCKETS )
+
+#define LATENCY_MUTEX_NONE          ( 0 )
+#define LATENCY_MUTEX_CREATING      ( 1 )
+#define LATENCY_MUTEX_READY         ( 2 )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t errors;
+    uint32_t max[ PARSE_LATENCY_PHASE_COUNT ];
+    uint16_t buckets[ PARSE_LATENCY_PHASE_COUNT ][ LATENCY_BUCKETS ];
+} latency_histogram_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static parse_endpoint_t latency_endpoint    ( const char* path );
+static uint32_t         latency_bucket      ( uint32_t value_us );
+static uint32_t         latency_bucket_limit( uint32_t bucket );
+static void             latency_add         ( latency_histogram_t* histogram, parse_latency_phase_t phase, uint32_t value_us );
+static uint32_t         latency_percentile  ( const latency_histogram_t* histogram, parse_latency_phase_t phase, uint32_t total, uint32_t percent );
+static void             latency_lock        ( void );
+static void             latency_unlock      ( void );
+#ifdef LATENCY_USE_WICED_TIME
+static uint32_t         latency_clock_us    ( void );
+#endif
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static latency_histogram_t latency_histograms[ PARSE_ENDPOINT_COUNT ];
+static wiced_mutex_t       latency_mutex;
+static uint8_t             latency_mutex_state = LATENCY_MUTEX_NONE;
+
+static const char* const latency_endpoint_names[ PARSE_ENDPOINT_COUNT ] =
+{
+    [ PARSE_ENDPOINT_INSTALLATIONS ] = "installations",
+    [ PARSE_ENDPOINT_CLASSES       ] = "classes",
+    [ PARSE_ENDPOINT_BATCH         ] = "batch",
+    [ PARSE_ENDPOINT_FUNCTIONS     ] = "functions",
+    [ PARSE_ENDPOINT_OTHER         ] = "other",
+};
+
+static const char* const latency_phase_names[ PARSE_LATENCY_PHASE_COUNT ] =
+{
+    [ PARSE_LATENCY_DNS        ] = "dns",
+    [ PARSE_LATENCY_CONNECT    ] = "connect",
+    [ PARSE_LATENCY_TLS        ] = "tls",
+    [ PARSE_LATENCY_SEND       ] = "send",
+    [ PARSE_LATENCY_FIRST_BYTE ] = "first byte",
+    [ PARSE_LATENCY_BODY       ] = "body",
+    [ PARSE_LATENCY_TOTAL      ] = "total",
+};
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+void parse_latency_begin( parse_latency_record_t* record, const char* path )
+{
+    int phase;
+
+    record->endpoint = latency_endpoint( path );
+    record->result   = WICED_SUCCESS;
+    for ( phase = 0; phase < PARSE_LATENCY_PHASE_COUNT; ++phase )
+    {
+        record->phase_us[ phase ] = LATENCY_NOT_REACHED;
+    }
+    record->start_us = PARSE_LATENCY_CLOCK_US( );
+}
+
+void parse_latency_mark( parse_latency_record_t* record, parse_latency_phase_t phase, wiced_bool_t once )
+{
+    if ( once == WICED_FALSE || record->phase_us[ phase ] == LATENCY_NOT_REACHED )
+    {
+        record->phase_us[ phase ] = PARSE_LATENCY_CLOCK_US( ) - record->start_us;
+    }
+}
+
+void parse_latency_end( parse_latency_record_t* record, int result )
+{
+    latency_histogram_t* histogram = &latency_histograms[ record->endpoint ];
+    uint32_t             previous  = 0;
+    int                  phase;
+
+    /* Turn the end times into durations, the total runs to the last phase reached */
+    for ( phase = 0; phase < PARSE_LATENCY_TOTAL; ++phase )
+    {
+        uint32_t end = record->phase_us[ phase ];
+
+        if ( end == LATENCY_NOT_REACHED )
+        {
+            record->phase_us[ phase ] = 0;
+            continue;
+        }
+
+        record->phase_us[ phase ] = end - previous;
+        previous = end;
+    }
+    record->phase_us[ PARSE_LATENCY_TOTAL ] = previous;
+    record->result = result;
+
+    latency_lock( );
+    if ( result != WICED_SUCCESS )
+    {
+        ++histogram->errors;
+    }
+    else
+    {
+        ++histogram->count;
+        for ( phase = 0; phase < PARSE_LATENCY_PHASE_COUNT; ++phase )
+        {
+            latency_add( histogram, (parse_latency_phase_t) phase, record->phase_us[ phase ] );
+        }
+    }
+    latency_unlock( );
+}
+
+const parse_latency_record_t* parse_get_request_latency( parse_client_t* client )
+{
+    return &client->latency;
+}
+
+void parse_set_latency_callback( parse_client_t* client, parse_latency_callback_t callback )
+{
+    client->latency_callback = callback;
+}
+
+wiced_result_t parse_get_latency_percentiles( parse_endpoint_t endpoint, parse_latency_phase_t phase, parse_latency_percentiles_t* percentiles )
+{
+    const latency_histogram_t* histogram;
+    uint32_t                   total = 0;
+    uint32_t                   bucket;
+
+    if ( (unsigned) endpoint >= PARSE_ENDPOINT_COUNT || (unsigned) phase >= PARSE_LATENCY_PHASE_COUNT )
+    {
+        return WICED_BADARG;
+    }
+
+    histogram = &latency_histograms[ endpoint ];
+
+    latency_lock( );
+
+    /* Bucket counts may have been halved, so the total is summed rather than taken from count */
+    for ( bucket = 0; bucket < LATENCY_BUCKETS; ++bucket )
+    {
+        total += histogram->buckets[ phase ][ bucket ];
+    }
+
+    percentiles->count  = histogram->count;
+    percentiles->errors = histogram->errors;
+    percentiles->p50    = latency_percentile( histogram, phase, total, 50 );
+    percentiles->p90    = latency_percentile( histogram, phase, total, 90 );
+    percentiles->p99    = latency_percentile( histogram, phase, total, 99 );
+    percentiles->max    = histogram->max[ phase ];
+
+    latency_unlock( );
+
+    return WICED_SUCCESS;
+}
+
+void parse_reset_latency_stats( void )
+{
+    latency_lock( );
+    memset( latency_histograms, 0, sizeof( latency_histograms ) );
+    latency_unlock( );
+}
+
+const char* parse_get_latency_phase_name( parse_latency_phase_t phase )
+{
+    return ( (unsigned) phase < PARSE_LATENCY_PHASE_COUNT ) ? latency_phase_names[ phase ] : "unknown";
+}
+
+const char* parse_get_endpoint_name( parse_endpoint_t endpoint )
+{
+    return ( (unsigned) endpoint < PARSE_ENDPOINT_COUNT ) ? latency_endpoint_names[ endpoint ] : "unknown";
+}
+
+void parse_print_latency_stats( void )
+{
+    int endpoint;
+    int phase;
+
+    for ( endpoint = 0; endpoint < PARSE_ENDPOINT_COUNT; ++endpoint )
+    {
+        parse_latency_percentiles_t totals;
+
+        /* The counts come with the percentiles, read under the lock */
+        parse_get_latency_percentiles( (parse_endpoint_t) endpoint, PARSE_LATENCY_TOTAL, &totals );
+        if ( totals.count == 0 && totals.errors == 0 )
+        {
+            continue;
+        }
+
+        WPRINT_LIB_INFO( ("[Parse] %s: %lu requests, %lu errors\r\n", parse_get_endpoint_name( (parse_endpoint_t) endpoint ),
+                          (unsigned long) totals.count, (unsigned long) totals.errors) );
+
+        for ( phase = 0; phase < PARSE_LATENCY_PHASE_COUNT; ++phase )
+        {
+            parse_latency_percentiles_t percentiles;
+
+            parse_get_latency_percentiles( (parse_endpoint_t) endpoint, (parse_latency_phase_t) phase, &percentiles );
+            WPRINT_LIB_INFO( ("[Parse]   %-10s p50 %8lu  p90 %8lu  p99 %8lu  max %8lu us\r\n", parse_get_latency_phase_name( (parse_latency_phase_t) phase ),
+                              (unsigned long) percentiles.p50, (unsigned long) percentiles.p90,
+                              (unsigned long) percentiles.p99, (unsigned long) percentiles.max) );
+        }
+    }
+}
+
+static parse_endpoint_t latency_endpoint( const char* path )
+{
+    static const struct
+    {
+        const char*      prefix;
+        uint8_t          length;
+        parse_endpoint_t endpoint;
+    } endpoints[ ] =
+    {
+        { "/1/installations", 16, PARSE_ENDPOINT_INSTALLATIONS },
+        { "/1/classes/",      11, PARSE_ENDPOINT_CLASSES       },
+        { "/1/batch",          8, PARSE_ENDPOINT_BATCH         },
+        { "/1/functions/",    13, PARSE_ENDPOINT_FUNCTIONS     },
+    };
+    unsigned int a;
+
+    for ( a = 0; path != NULL && a < sizeof( endpoints ) / sizeof( endpoints[ 0 ] ); ++a )
+    {
+        if ( strncmp( path, endpoints[ a ].prefix, endpoints[ a ].length ) == 0 )
+        {
+            return endpoints[ a ].endpoint;
+        }
+    }
+
+    return PARSE_ENDPOINT_OTHER;
+}
+
+static uint32_t latency_bucket( uint32_t value_us )
+{
+    uint32_t value  = value_us >> LATENCY_RESOLUTION_SHIFT;
+    uint32_t octave;
+
+    if ( value < LATENCY_SUB_BUCKETS )
+    {
+        return value;
+    }
+
+    octave = 31 - (uint32_t) __builtin_clz( value );
+    if ( octave >= LATENCY_OCTAVES )
+    {
+        return LATENCY_BUCKETS - 1;
+    }
+
+    return ( octave - LATENCY_SUB_BUCKET_BITS + 1 ) * LATENCY_SUB_BUCKETS + ( ( value >> ( octave - LATENCY_SUB_BUCKET_BITS ) ) & ( LATENCY_SUB_BUCKETS - 1 ) );
+}
+
+/* First value of the next bucket, in microseconds */
+static uint32_t latency_bucket_limit( uint32_t bucket )
+{
+    uint32_t next = bucket + 1;
+    uint32_t octave;
+
+    if ( next < LATENCY_SUB_BUCKETS )
+    {
+        return next << LATENCY_RESOLUTION_SHIFT;
+    }
+
+    octave = next / LATENCY_SUB_BUCKETS + LATENCY_SUB_BUCKET_BITS - 1;
+
+    return ( ( LATENCY_SUB_BUCKETS + next % LATENCY_SUB_BUCKETS ) << ( octave - LATENCY_SUB_BUCKET_BITS ) ) << LATENCY_RESOLUTION_SHIFT;
+}
+
+static void latency_add( latency_histogram_t* histogram, parse_latency_phase_t phase, uint32_t value_us )
+{
+    uint16_t* buckets = histogram->buckets[ phase ];
+    uint32_t  bucket  = latency_bucket( value_us );
+
+    /* Halve a full histogram, which keeps its shape and so its percentiles */
+    if ( buckets[ bucket ] == 0xFFFF )
+    {
+        uint32_t a;
+
+        for ( a = 0; a < LATENCY_BUCKETS; ++a )
+        {
+            buckets[ a ] = (uint16_t) ( buckets[ a ] >> 1 );
+        }
+    }
+
+    ++buckets[ bucket ];
+    if ( value_us > histogram->max[ phase ] )
+    {
+        histogram->max[ phase ] = value_us;
+    }
+}
+
+static uint32_t latency_percentile( const latency_histogram_t* histogram, parse_latency_phase_t phase, uint32_t total, uint32_t percent )
+{
+    uint32_t rank = ( total * percent + 99 ) / 100;
+    uint32_t seen = 0;
+    uint32_t bucket;
+
+    if ( total == 0 )
+    {
+        return 0;
+    }
+
+    for ( bucket = 0; bucket < LATENCY_BUCKETS; ++bucket )
+    {
+        seen += histogram->buckets[ phase ][ bucket ];
+        if ( seen >= rank )
+        {
+            uint32_t limit = latency_bucket_limit( bucket ) - 1;
+            return ( limit < histogram->max[ phase ] ) ? limit : histogram->max[ phase ];
+        }
+    }
+
+    return histogram->max[ phase ];
+}
+
+static void latency_lock( void )
+{
+    uint8_t state = __atomic_load_n( &latency_mutex_state, __ATOMIC_ACQUIRE );
+
+    if ( state != LATENCY_MUTEX_READY )
+    {
+        uint8_t expected = LATENCY_MUTEX_NONE;
+
+        if ( __atomic_compare_exchange_n( &latency_mutex_state, &expected, LATENCY_MUTEX_CREATING, WICED_FALSE, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE ) )
+        {
+            wiced_rtos_init_mutex( &latency_mutex );
+            __atomic_store_n( &latency_mutex_state, LATENCY_MUTEX_READY, __ATOMIC_RELEASE );
+        }
+
+        /* Another thread is creating it, which takes no time */
+        while ( __atomic_load_n( &latency_mutex_state, __ATOMIC_ACQUIRE ) != LATENCY_MUTEX_READY )
+        {
+            wiced_rtos_delay_milliseconds( 1 );
+        }
+    }
+
+    wiced_rtos_lock_mutex( &latency_mutex );
+}
+
+static void latency_unlock( void )
+{
+    wiced_rtos_unlock_mutex( &latency_mutex );
+}
+
+#ifdef LATENCY_USE_WICED_TIME
+static uint32_t latency_clock_us( void )
+{
+    wiced_time_t now;
+
+    wiced_time_get_time( &now );
+
+    return (uint32_t) now * 1000;
+}
+#endif
+
+#endif /* PARSE_ENABLE_LATENCY_STATS */
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "wiced.h"
+#include "parse.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* Request timing hooks, they compile to nothing unless PARSE_ENABLE_LATENCY_STATS is defined */
+#ifdef PARSE_ENABLE_LATENCY_STATS
+#define PARSE_LATENCY_BEGIN( client, path )       parse_latency_begin( &( client )->latency, ( path ) )
+#define PARSE_LATENCY_MARK( client, phase )       parse_latency_mark( &( client )->latency, ( phase ), WICED_FALSE )
+#define PARSE_LATENCY_MARK_ONCE( client, phase )  parse_latency_mark( &( client )->latency, ( phase ), WICED_TRUE )
+#define PARSE_LATENCY_END( client, result )       parse_latency_end( &( client )->latency, ( result ) )
+#else
+#define PARSE_LATENCY_BEGIN( client, path )
+#define PARSE_LATENCY_MARK( client, phase )
+#define PARSE_LATENCY_MARK_ONCE( client, phase )
+#define PARSE_LATENCY_END( client, result )
+#endif
+
+/******************************************************
+ *                Function Declarations
+ ******************************************************/
+
+#ifdef PARSE_ENABLE_LATENCY_STATS
+void parse_latency_begin( parse_latency_record_t* record, const char* path );
+void parse_latency_mark ( parse_latency_record_t* record, parse_latency_phase_t phase, wiced_bool_t once );
+void parse_latency_end  ( parse_latency_record_t* record, int result );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Peak usage of the library's buffers and high-water marks of painted stacks
+ *
+ * Every place that fills a buffer reports how many bytes it needed, which
+ * is kept as the buffer's peak. Stacks are measured by painting them with a
+ * pattern and later counting, from the deep end, how much of it is intact.
+ */
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_memory.h"
+#include <string.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#ifndef NEVER_INLINE
+#define NEVER_INLINE                __attribute__(( noinline ))
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#ifndef PARSE_MEMORY_MAX_STACKS
+#define PARSE_MEMORY_MAX_STACKS     ( 6 )
+#endif
+
+#define STACK_PAINT                 ( 0xA5 )
+
+/* Left unpainted below the frame of parse_paint_current_stack(), it covers the
+ * painting loop's own spills and the red zone of ABIs that have one */
+#define STACK_PAINT_SKIP            ( 256 )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    const char*    name;
+    const uint8_t* base;    /* Deep end, the lowest address */
+    uint32_t       size;
+} memory_stack_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static wiced_result_t memory_add_stack( const char* name, const uint8_t* base, uint32_t size );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static parse_memory_usage_t memory_usage[ PARSE_MEMORY_BUFFER_COUNT ];
+static memory_stack_t       memory_stacks[ PARSE_MEMORY_MAX_STACKS ];
+static uint32_t             memory_stack_count;
+
+static const parse_memory_location_t memory_locations[ PARSE_MEMORY_BUFFER_COUNT ] =
+{
+    [ PARSE_MEMORY_SENDING_DATA      ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_CLIENT_BUFFER     ] = PARSE_MEMORY_PER_CLIENT,
+    [ PARSE_MEMORY_RECEIVED_DATA     ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_JSON_DATA         ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_PUSH_NOTIFICATION ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_KEEPALIVE         ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_REQUEST_PATH      ] = PARSE_MEMORY_STACK,
+    [ PARSE_MEMORY_TLS_CONTEXT       ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_TELEMETRY_DATA    ] = PARSE_MEMORY_STATIC,
+    [ PARSE_MEMORY_QUERY_WINDOW      ] = PARSE_MEMORY_PER_CLIENT,
+};
+
+static const char* const memory_buffer_names[ PARSE_MEMORY_BUFFER_COUNT ] =
+{
+    [ PARSE_MEMORY_SENDING_DATA      ] = "sending data",
+    [ PARSE_MEMORY_CLIENT_BUFFER     ] = "client buffer",
+    [ PARSE_MEMORY_RECEIVED_DATA     ] = "received data",
+    [ PARSE_MEMORY_JSON_DATA         ] = "JSON data",
+    [ PARSE_MEMORY_PUSH_NOTIFICATION ] = "push",
+    [ PARSE_MEMORY_KEEPALIVE         ] = "keep-alive",
+    [ PARSE_MEMORY_REQUEST_PATH      ] = "request path",
+    [ PARSE_MEMORY_TLS_CONTEXT       ] = "TLS context",
+    [ PARSE_MEMORY_TELEMETRY_DATA    ] = "telemetry data",
+    [ PARSE_MEMORY_QUERY_WINDOW      ] = "query window",
+};
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+void parse_memory_use( parse_memory_buffer_t buffer, uint32_t size, uint32_t used )
+{
+    parse_memory_usage_t* usage = &memory_usage[ buffer ];
+
+    if ( used >= size )
+    {
+        used = size;
+        ++usage->full;
+    }
+
+    usage->size = size;
+    usage->peak = MAX( usage->peak, used );
+    ++usage->uses;
+}
+
+void parse_memory_reserve( parse_memory_buffer_t buffer, uint32_t size )
+{
+    parse_memory_usage_t* usage = &memory_usage[ buffer ];
+
+    usage->size = size;
+    usage->peak = size;
+    ++usage->uses;
+}
+
+wiced_result_t parse_get_memory_usage( parse_memory_buffer_t buffer, parse_memory_usage_t* usage )
+{
+    if ( (unsigned) buffer >= PARSE_MEMORY_BUFFER_COUNT )
+    {
+        return WICED_BADARG;
+    }
+
+    *usage          = memory_usage[ buffer ];
+    usage->location = memory_locations[ buffer ];
+
+    return WICED_SUCCESS;
+}
+
+const char* parse_get_memory_buffer_name( parse_memory_buffer_t buffer )
+{
+    return ( (unsigned) buffer < PARSE_MEMORY_BUFFER_COUNT ) ? memory_buffer_names[ buffer ] : "unknown";
+}
+
+wiced_result_t parse_paint_stack( const char* name, void* stack, uint32_t size )
+{
+    memset( stack, STACK_PAINT, size );
+
+    return memory_add_stack( name, (const uint8_t*) stack, size );
+}
+
+NEVER_INLINE wiced_result_t parse_paint_current_stack( const char* name, uint32_t size )
+{
+    volatile uint8_t frame;
+    uintptr_t        top  = (uintptr_t) &frame - STACK_PAINT_SKIP;
+    uintptr_t        base = top - size;
+    uintptr_t        p;
+
+    /* No calls until the loop is done, they would use the stack being painted */
+    for ( p = base; p < top; ++p )
+    {
+        *(volatile uint8_t*) p = STACK_PAINT;
+    }
+
+    return memory_add_stack( name, (const uint8_t*) base, size );
+}
+
+wiced_result_t parse_get_stack_usage( uint32_t index, parse_stack_usage_t* usage )
+{
+    const memory_stack_t* stack;
+    uint32_t              intact = 0;
+
+    if ( index >= memory_stack_count )
+    {
+        return WICED_NOT_FOUND;
+    }
+
+    stack = &memory_stacks[ index ];
+    while ( intact < stack->size && stack->base[ intact ] == STACK_PAINT )
+    {
+        ++intact;
+    }
+
+    usage->name = stack->name;
+    usage->size = stack->size;
+    usage->used = stack->size - intact;
+
+    return WICED_SUCCESS;
+}
+
+void parse_reset_memory_stats( void )
+{
+    memset( memory_usage, 0, sizeof( memory_usage ) );
+}
+
+void parse_print_memory_stats( void )
+{
+    parse_stack_usage_t stack;
+    uint32_t            totals[ 3 ] = { 0, 0, 0 };
+    uint32_t            a;
+
+    for ( a = 0; a < PARSE_MEMORY_BUFFER_COUNT; ++a )
+    {
+        parse_memory_usage_t usage;
+
+        parse_get_memory_usage( (parse_memory_buffer_t) a, &usage );
+        if ( usage.uses == 0 )
+        {
+            WPRINT_LIB_INFO( ("[Parse] %-14s unused\r\n", memory_buffer_names[ a ]) );
+            continue;
+        }
+
+        totals[ usage.location ] += usage.size;
+        WPRINT_LIB_INFO( ("[Parse] %-14s %-6s %5lu bytes, peak %5lu, headroom %5lu, full %lu of %lu\r\n", memory_buffer_names[ a ],
+                          ( usage.location == PARSE_MEMORY_STATIC ) ? "static" : ( usage.location == PARSE_MEMORY_PER_CLIENT ) ? "client" : "stack",
+                          (unsigned long) usage.size, (unsigned long) usage.peak, (unsigned long) ( usage.size - usage.peak ),
+                          (unsigned long) usage.full, (unsigned long) usage.uses) );
+    }
+
+    WPRINT_LIB_INFO( ("[Parse] Measured buffers: %lu bytes static, %lu per client (of %lu), %lu on the stack\r\n",
+                      (unsigned long) totals[ PARSE_MEMORY_STATIC ], (unsigned long) totals[ PARSE_MEMORY_PER_CLIENT ],
+                      (unsigned long) sizeof( parse_client_t ), (unsigned long) totals[ PARSE_MEMORY_STACK ]) );
+
+    for ( a = 0; parse_get_stack_usage( a, &stack ) == WICED_SUCCESS; ++a )
+    {
+        WPRINT_LIB_INFO( ("[Parse] Stack %-14s %5lu bytes painted, %5lu used, headroom %5lu\r\n", stack.name, (unsigned long) stack.size,
+                          (unsigned long) stack.used, (unsigned long) ( stack.size - stack.used )) );
+    }
+}
+
+/* A stack painted again under the same name, like a thread that was deleted and created again,
+ * replaces the old one */
+static wiced_result_t memory_add_stack( const char* name, const uint8_t* base, uint32_t size )
+{
+    uint32_t index;
+
+    for ( index = 0; index < memory_stack_count; ++index )
+    {
+        if ( strcmp( memory_stacks[ index ].name, name ) == 0 )
+        {
+            memory_stacks[ index ].base = base;
+            memory_stacks[ index ].size = size;
+            return WICED_SUCCESS;
+        }
+    }
+
+    if ( memory_stack_count >= PARSE_MEMORY_MAX_STACKS )
+    {
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+
+    memory_stacks[ memory_stack_count ].name = name;
+    memory_stacks[ memory_stack_count ].base = base;
+    memory_stacks[ memory_stack_count ].size = size;
+    ++memory_stack_count;
+
+    return WICED_SUCCESS;
+}
+
+#endif /* PARSE_ENABLE_MEMORY_STATS */
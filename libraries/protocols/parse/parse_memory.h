@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "wiced.h"
+#include "parse.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* Buffer usage hooks, they compile to nothing unless PARSE_ENABLE_MEMORY_STATS is defined.
+ * PARSE_MEMORY_USE is for buffers filled with data, PARSE_MEMORY_RESERVE for whole objects. */
+#ifdef PARSE_ENABLE_MEMORY_STATS
+#define PARSE_MEMORY_USE( buffer, size, used )  parse_memory_use( ( buffer ), (uint32_t) ( size ), (uint32_t) ( used ) )
+#define PARSE_MEMORY_RESERVE( buffer, size )    parse_memory_reserve( ( buffer ), (uint32_t) ( size ) )
+#else
+#define PARSE_MEMORY_USE( buffer, size, used )
+#define PARSE_MEMORY_RESERVE( buffer, size )
+#endif
+
+/******************************************************
+ *                Function Declarations
+ ******************************************************/
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+void parse_memory_use    ( parse_memory_buffer_t buffer, uint32_t size, uint32_t used );
+void parse_memory_reserve( parse_memory_buffer_t buffer, uint32_t size );
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Object handles with dirty field tracking
+ *
+ * A handle mirrors the fields the application sets on an object, each with
+ * the change the next save has to send: the value, an Increment amount, or
+ * the strings of an AddUnique. A save writes only the changed fields, straight
+ * into the request buffer like the other JSON bodies, and merges the object
+ * id, dates and operation results of the response back into the handle.
+ *
+ * Requests are synchronous, so the handle being saved is reached from the
+ * body writer and the response callback through the client.
+ */
+
+#ifdef PARSE_ENABLE_OBJECTS
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_keys.h"
+#include "parse_request.h"
+#include <string.h>
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define OBJECT_CLASSES_PATH     "/1/classes/"
+#define OBJECT_PATH_MAX_LEN     ( sizeof( OBJECT_CLASSES_PATH ) + PARSE_OBJECT_CLASS_MAX_LEN + OBJECT_ID_MAX_LEN )
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static wiced_result_t        object_field        ( parse_object_t* object, const char* key, parse_field_type_t type, parse_object_field_t** field );
+static wiced_result_t        object_set          ( parse_object_t* object, const char* key, parse_field_type_t type, parse_object_field_t** field );
+static parse_object_field_t* object_find         ( const parse_object_t* object, const char* key );
+static void                  object_write_body   ( parse_client_t* client, simple_json_writer_t* writer );
+static void                  object_write_field  ( simple_json_writer_t* writer, const parse_object_field_t* field );
+static void                  object_saved        ( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody );
+static int                   object_member       ( void* context, int id, const simple_json_value_t* key, const simple_json_value_t* value );
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t parse_object_init( parse_object_t* object, const char* class_name, const char* object_id )
+{
+    if ( class_name == NULL || class_name[ 0 ] == '\0' || strlen( class_name ) > PARSE_OBJECT_CLASS_MAX_LEN ||
+         ( object_id != NULL && strlen( object_id ) > OBJECT_ID_MAX_LEN ) )
+    {
+        return WICED_BADARG;
+    }
+
+    memset( object, 0, sizeof( *object ) );
+    strcpy( object->class_name, class_name );
+    if ( object_id != NULL )
+    {
+        strcpy( object->object_id, object_id );
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t parse_object_set_int( parse_object_t* object, const char* key, int64_t value )
+{
+    parse_object_field_t* field;
+    wiced_result_t        result = object_set( object, key, PARSE_FIELD_INTEGER, &field );
+
+    if ( result == WICED_SUCCESS )
+    {
+        field->value.integer = value;
+    }
+
+    return result;
+}
+
+wiced_result_t parse_object_set_double( parse_object_t* object, const char* key, double value )
+{
+    parse_object_field_t* field;
+    wiced_result_t        result = object_set( object, key, PARSE_FIELD_NUMBER, &field );
+
+    if ( result == WICED_SUCCESS )
+    {
+        field->value.number = value;
+    }
+
+    return result;
+}
+
+wiced_result_t parse_object_set_bool( parse_object_t* object, const char* key, int value )
+{
+    parse_object_field_t* field;
+    wiced_result_t        result = object_set( object, key, PARSE_FIELD_BOOL, &field );
+
+    if ( result == WICED_SUCCESS )
+    {
+        field->value.boolean = ( value != 0 );
+    }
+
+    return result;
+}
+
+wiced_result_t parse_object_set_string( parse_object_t* object, const char* key, const char* value )
+{
+    parse_object_field_t* field;
+    wiced_result_t        result;
+
+    if ( strlen( value ) > PARSE_OBJECT_TEXT_MAX_LEN )
+    {
+        return WICED_BADARG;
+    }
+
+    result = object_set( object, key, PARSE_FIELD_STRING, &field );
+    if ( result == WICED_SUCCESS )
+    {
+        strcpy( field->text, value );
+    }
+
+    return result;
+}
+
+wiced_result_t parse_object_increment( parse_object_t* object, const char* key, int64_t amount )
+{
+    parse_object_field_t* field;
+    wiced_result_t        result = object_field( object, key, PARSE_FIELD_INTEGER, &field );
+
+    if ( result != WICED_SUCCESS )
+    {
+        return result;
+    }
+    if ( field->type != PARSE_FIELD_INTEGER && field->type != PARSE_FIELD_NUMBER )
+    {
+        return WICED_BADARG;
+    }
+
+    if ( field->type == PARSE_FIELD_INTEGER )
+    {
+        field->value.integer += amount;
+        field->increment.integer += amount;
+    }
+    else
+    {
+        field->value.number += (double) amount;
+        field->increment.number += (double) amount;
+    }
+
+    /* A value that was not saved yet is sent as it is now */
+    if ( field->change != PARSE_FIELD_CHANGED )
+    {
+        field->change = PARSE_FIELD_INCREMENTED;
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t parse_object_add_unique( parse_object_t* object, const char* key, const char* value )
+{
+    parse_object_field_t* field;
+    wiced_result_t        result = object_field( object, key, PARSE_FIELD_SET, &field );
+    size_t                used   = 0;
+    size_t                length = strlen( value );
+    uint8_t               item;
+
+    if ( result != WICED_SUCCESS )
+    {
+        return result;
+    }
+    if ( field->type != PARSE_FIELD_SET )
+    {
+        return WICED_BADARG;
+    }
+
+    for ( item = 0; item < field->items; item++ )
+    {
+        if ( strcmp( field->text + used, value ) == 0 )
+        {
+            return WICED_SUCCESS;
+        }
+        used += strlen( field->text + used ) + 1;
+    }
+
+    /* The last string keeps the terminator of text */
+    if ( used + length > PARSE_OBJECT_TEXT_MAX_LEN )
+    {
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+
+    memcpy( field->text + used, value, length + 1 );
+    field->items++;
+    field->change = PARSE_FIELD_ADDED;
+
+    return WICED_SUCCESS;
+}
+
+const parse_object_field_t* parse_object_get( const parse_object_t* object, const char* key )
+{
+    return object_find( object, key );
+}
+
+wiced_bool_t parse_object_is_dirty( const parse_object_t* object )
+{
+    uint8_t field;
+
+    if ( object->object_id[ 0 ] == '\0' )
+    {
+        return WICED_TRUE;
+    }
+
+    for ( field = 0; field < object->field_count; field++ )
+    {
+        if ( object->fields[ field ].change != PARSE_FIELD_UNCHANGED )
+        {
+            return WICED_TRUE;
+        }
+    }
+
+    return WICED_FALSE;
+}
+
+wiced_result_t parse_object_save( parse_client_t* client, parse_object_t* object, parse_request_callback_t callback )
+{
+    char path[ OBJECT_PATH_MAX_LEN + 1 ];
+
+    if ( !parse_object_is_dirty( object ) )
+    {
+        return WICED_SUCCESS;
+    }
+
+    strcpy( path, OBJECT_CLASSES_PATH );
+    strcat( path, object->class_name );
+    if ( object->object_id[ 0 ] != '\0' )
+    {
+        strcat( path, "/" );
+        strcat( path, object->object_id );
+    }
+
+    object->callback = callback;
+    object->result   = WICED_ERROR;
+    client->object   = object;
+
+    parse_send_json_request( client, ( object->object_id[ 0 ] == '\0' ) ? "POST" : "PUT", path, object_write_body, object_saved );
+
+    client->object = NULL;
+
+    return object->result;
+}
+
+/* The field of a key, added with the type if the handle does not have it */
+static wiced_result_t object_field( parse_object_t* object, const char* key, parse_field_type_t type, parse_object_field_t** field )
+{
+    *field = object_find( object, key );
+    if ( *field != NULL )
+    {
+        return WICED_SUCCESS;
+    }
+
+    if ( key == NULL || key[ 0 ] == '\0' || strlen( key ) > PARSE_OBJECT_KEY_MAX_LEN )
+    {
+        return WICED_BADARG;
+    }
+    if ( object->field_count >= PARSE_OBJECT_MAX_FIELDS )
+    {
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+
+    *field = &object->fields[ object->field_count++ ];
+    memset( *field, 0, sizeof( **field ) );
+    strcpy( ( *field )->key, key );
+    ( *field )->type = (uint8_t) type;
+
+    return WICED_SUCCESS;
+}
+
+/* The field of a key, reset to a changed value of the type */
+static wiced_result_t object_set( parse_object_t* object, const char* key, parse_field_type_t type, parse_object_field_t** field )
+{
+    wiced_result_t result = object_field( object, key, type, field );
+
+    if ( result != WICED_SUCCESS )
+    {
+        return result;
+    }
+
+    ( *field )->type   = (uint8_t) type;
+    ( *field )->change = PARSE_FIELD_CHANGED;
+    ( *field )->items  = 0;
+    ( *field )->text[ 0 ] = '\0';
+    memset( &( *field )->increment, 0, sizeof( ( *field )->increment ) );
+
+    return WICED_SUCCESS;
+}
+
+static parse_object_field_t* object_find( const parse_object_t* object, const char* key )
+{
+    uint8_t field;
+
+    if ( key == NULL )
+    {
+        return NULL;
+    }
+
+    for ( field = 0; field < object->field_count; field++ )
+    {
+        if ( strcmp( object->fields[ field ].key, key ) == 0 )
+        {
+            return (parse_object_field_t*) &object->fields[ field ];
+        }
+    }
+
+    return NULL;
+}
+
+static void object_write_body( parse_client_t* client, simple_json_writer_t* writer )
+{
+    const parse_object_t* object = client->object;
+    uint8_t               field;
+
+    simpleJsonWriteStartObject( writer );
+    for ( field = 0; field < object->field_count; field++ )
+    {
+        if ( object->fields[ field ].change != PARSE_FIELD_UNCHANGED )
+        {
+            object_write_field( writer, &object->fields[ field ] );
+        }
+    }
+    simpleJsonWriteEndObject( writer );
+}
+
+static void object_write_field( simple_json_writer_t* writer, const parse_object_field_t* field )
+{
+    const char* text = field->text;
+    uint8_t     item;
+
+    simpleJsonWriteKey( writer, field->key );
+
+    switch ( field->change )
+    {
+        case PARSE_FIELD_INCREMENTED:
+            simpleJsonWriteStartObject( writer );
+            simpleJsonWriteKey( writer, "__op" );
+            simpleJsonWriteString( writer, "Increment" );
+            simpleJsonWriteKey( writer, "amount" );
+            if ( field->type == PARSE_FIELD_INTEGER )
+            {
+                simpleJsonWriteInt( writer, field->increment.integer );
+            }
+            else
+            {
+                simpleJsonWriteDouble( writer, field->increment.number );
+            }
+            simpleJsonWriteEndObject( writer );
+            break;
+
+        case PARSE_FIELD_ADDED:
+            simpleJsonWriteStartObject( writer );
+            simpleJsonWriteKey( writer, "__op" );
+            simpleJsonWriteString( writer, "AddUnique" );
+            simpleJsonWriteKey( writer, "objects" );
+            simpleJsonWriteStartArray( writer );
+            for ( item = 0; item < field->items; item++ )
+            {
+                simpleJsonWriteString( writer, text );
+                text += strlen( text ) + 1;
+            }
+            simpleJsonWriteEndArray( writer );
+            simpleJsonWriteEndObject( writer );
+            break;
+
+        default:
+            switch ( field->type )
+            {
+                case PARSE_FIELD_INTEGER:
+                    simpleJsonWriteInt( writer, field->value.integer );
+                    break;
+                case PARSE_FIELD_NUMBER:
+                    simpleJsonWriteDouble( writer, field->value.number );
+                    break;
+                case PARSE_FIELD_BOOL:
+                    simpleJsonWriteBool( writer, field->value.boolean );
+                    break;
+                default:
+                    simpleJsonWriteString( writer, field->text );
+                    break;
+            }
+            break;
+    }
+}
+
+static void object_saved( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody )
+{
+    parse_object_t*     object = client->object;
+    simple_json_value_t response;
+    char                updated_at[ PARSE_OBJECT_DATE_MAX_LEN + 1 ];
+    uint8_t             field;
+
+    if ( error != 0 )
+    {
+        object->result = (wiced_result_t) error;
+    }
+    else if ( httpStatus < 200 || httpStatus >= 300 )
+    {
+        object->result = WICED_ERROR;
+    }
+    else
+    {
+        object->result = WICED_SUCCESS;
+        for ( field = 0; field < object->field_count; field++ )
+        {
+            parse_object_field_t* saved = &object->fields[ field ];
+
+            saved->change = PARSE_FIELD_UNCHANGED;
+            saved->items  = 0;
+            memset( &saved->increment, 0, sizeof( saved->increment ) );
+            if ( saved->type == PARSE_FIELD_SET )
+            {
+                saved->text[ 0 ] = '\0';
+            }
+        }
+
+        /* {"objectId","createdAt"} of a creation, {"updatedAt"} and the operation results of an update */
+        strcpy( updated_at, object->updated_at );
+        object->updated_at[ 0 ] = '\0';
+        if ( httpResponseBody != NULL && simpleJsonGetValue( httpResponseBody, strlen( httpResponseBody ), &response ) != 0 &&
+             response.type == SIMPLE_JSON_OBJECT )
+        {
+            simpleJsonDispatch( &response, &parse_keys, object_member, object );
+        }
+        if ( object->updated_at[ 0 ] == '\0' )
+        {
+            /* Neither date decoded, keep the one of the last save */
+            strcpy( object->updated_at, updated_at );
+        }
+    }
+
+    if ( object->callback != NULL )
+    {
+        object->callback( client, error, httpStatus, httpResponseBody );
+    }
+}
+
+static int object_member( void* context, int id, const simple_json_value_t* key, const simple_json_value_t* value )
+{
+    parse_object_t*       object = (parse_object_t*) context;
+    parse_object_field_t* field;
+    uint8_t               f;
+
+    switch ( id )
+    {
+        case PARSE_KEY_OBJECT_ID:
+            parse_copy_json_string( value, object->object_id, sizeof( object->object_id ) );
+            break;
+
+        case PARSE_KEY_CREATED_AT:
+            /* The last change of a new object, unless the response also has updatedAt */
+            if ( object->updated_at[ 0 ] == '\0' )
+            {
+                parse_copy_json_string( value, object->updated_at, sizeof( object->updated_at ) );
+            }
+            break;
+
+        case PARSE_KEY_UPDATED_AT:
+            parse_copy_json_string( value, object->updated_at, sizeof( object->updated_at ) );
+            break;
+
+        default:
+            /* The value of a counter after the increments of every client */
+            for ( f = 0; f < object->field_count; f++ )
+            {
+                field = &object->fields[ f ];
+                if ( key->length == strlen( field->key ) && memcmp( key->data, field->key, key->length ) == 0 )
+                {
+                    if ( field->type == PARSE_FIELD_INTEGER )
+                    {
+                        simpleJsonGetInt64( value, &field->value.integer );
+                    }
+                    else if ( field->type == PARSE_FIELD_NUMBER )
+                    {
+                        simpleJsonGetDouble( value, &field->value.number );
+                    }
+                    break;
+                }
+            }
+            break;
+    }
+
+    return 0;
+}
+
+#endif /* PARSE_ENABLE_OBJECTS */
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Single-pass decoding of Parse push notifications
+ */
+
+#include "wiced.h"
+#include "parse.h"
+#include "simplejson.h"
+#include "parse_push_keys.h"
+#include <string.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static int                  decode_notification_member( void* context, int id, const simple_json_value_t* key, const simple_json_value_t* value );
+static int                  decode_data_member        ( void* context, int id, const simple_json_value_t* key, const simple_json_value_t* value );
+static simple_json_value_t* well_known_field          ( parse_push_t* push, int id );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t parse_push_decode( const char* data, size_t data_size, parse_push_t* push )
+{
+    simple_json_value_t notification;
+
+    if ( data == NULL || push == NULL )
+    {
+        return WICED_BADARG;
+    }
+
+    memset( push, 0, sizeof( *push ) );
+
+    if ( simpleJsonGetValue( data, data_size, &notification ) == 0 || notification.type != SIMPLE_JSON_OBJECT )
+    {
+        return WICED_ERROR;
+    }
+
+    // Validate the text once, so the fields can be unescaped without surprises
+    if ( simpleJsonValidateUtf8( notification.data, notification.length ) == 0 )
+    {
+        return WICED_ERROR;
+    }
+
+    simpleJsonDispatch( &notification, &parse_push_keys, decode_notification_member, push );
+
+    return WICED_SUCCESS;
+}
+
+unsigned int parse_push_get_custom_count( const parse_push_t* push )
+{
+    return push->custom_count;
+}
+
+const parse_push_field_t* parse_push_get_custom( const parse_push_t* push, unsigned int index )
+{
+    if ( index >= push->custom_count )
+    {
+        return NULL;
+    }
+
+    return &push->custom[ index ];
+}
+
+const simple_json_value_t* parse_push_find_custom( const parse_push_t* push, const char* key )
+{
+    unsigned int i;
+
+    for ( i = 0; i < push->custom_count; i++ )
+    {
+        if ( simpleJsonValueEquals( &push->custom[ i ].key, key ) )
+        {
+            return &push->custom[ i ].value;
+        }
+    }
+
+    return NULL;
+}
+
+static int decode_notification_member( void* context, int id, const simple_json_value_t* key, const simple_json_value_t* value )
+{
+    parse_push_t*        push  = (parse_push_t*) context;
+    simple_json_value_t* field = well_known_field( push, id );
+
+    UNUSED_PARAMETER( key );
+
+    if ( field != NULL )
+    {
+        *field = *value;
+    }
+    else if ( id == PARSE_PUSH_KEY_DATA )
+    {
+        push->data = *value;
+
+        // The notification data may also be sent as a JSON encoded string, which is left to the application
+        if ( value->type == SIMPLE_JSON_OBJECT )
+        {
+            simpleJsonDispatch( value, &parse_push_keys, decode_data_member, push );
+        }
+    }
+
+    return 0;
+}
+
+static int decode_data_member( void* context, int id, const simple_json_value_t* key, const simple_json_value_t* value )
+{
+    parse_push_t*        push  = (parse_push_t*) context;
+    simple_json_value_t* field = well_known_field( push, id );
+
+    if ( field != NULL )
+    {
+        *field = *value;
+    }
+    else if ( push->custom_count < PARSE_PUSH_MAX_CUSTOM_FIELDS )
+    {
+        push->custom[ push->custom_count ].key   = *key;
+        push->custom[ push->custom_count ].value = *value;
+        push->custom_count++;
+    }
+
+    return 0;
+}
+
+static simple_json_value_t* well_known_field( parse_push_t* push, int id )
+{
+    switch ( id )
+    {
+        case PARSE_PUSH_KEY_ALERT:
+            return &push->alert;
+        case PARSE_PUSH_KEY_TITLE:
+            return &push->title;
+        case PARSE_PUSH_KEY_BADGE:
+            return &push->badge;
+        case PARSE_PUSH_KEY_SOUND:
+            return &push->sound;
+        case PARSE_PUSH_KEY_CHANNELS:
+            return &push->channels;
+        case PARSE_PUSH_KEY_TIME:
+            return &push->time;
+        case PARSE_PUSH_KEY_PUSH_ID:
+            return &push->push_id;
+        default:
+            return NULL;
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * Generated by tools/json_keyhash/json_keyhash.py, do not edit.
+ * json_keyhash.py --name parse_push_keys --prefix PARSE_PUSH_KEY alert title badge sound channels time push_id data
+ */
+#ifndef INCLUDED_PARSE_PUSH_KEYS_H_
+#define INCLUDED_PARSE_PUSH_KEYS_H_
+
+#include "simplejson.h"
+
+typedef enum
+{
+    PARSE_PUSH_KEY_ALERT    = 0,
+    PARSE_PUSH_KEY_TITLE    = 1,
+    PARSE_PUSH_KEY_BADGE    = 2,
+    PARSE_PUSH_KEY_SOUND    = 3,
+    PARSE_PUSH_KEY_CHANNELS = 4,
+    PARSE_PUSH_KEY_TIME     = 5,
+    PARSE_PUSH_KEY_PUSH_ID  = 6,
+    PARSE_PUSH_KEY_DATA     = 7,
+    PARSE_PUSH_KEY_COUNT    = 8
+} parse_push_keys_id_t;
+
+static const simple_json_key_t parse_push_keys_slots[ 8 ] =
+{
+    SIMPLE_JSON_KEY( "time", PARSE_PUSH_KEY_TIME ),
+    SIMPLE_JSON_KEY( "channels", PARSE_PUSH_KEY_CHANNELS ),
+    SIMPLE_JSON_KEY( "sound", PARSE_PUSH_KEY_SOUND ),
+    SIMPLE_JSON_KEY( "data", PARSE_PUSH_KEY_DATA ),
+    SIMPLE_JSON_KEY( "badge", PARSE_PUSH_KEY_BADGE ),
+    SIMPLE_JSON_KEY( "alert", PARSE_PUSH_KEY_ALERT ),
+    SIMPLE_JSON_KEY( "push_id", PARSE_PUSH_KEY_PUSH_ID ),
+    SIMPLE_JSON_KEY( "title", PARSE_PUSH_KEY_TITLE )
+};
+
+static const simple_json_key_table_t parse_push_keys =
+{
+    0x0000029bUL,
+    7,
+    SIMPLE_JSON_KEY_HASH_SPARSE,
+    parse_push_keys_slots
+};
+
+#endif /* INCLUDED_PARSE_PUSH_KEYS_H_ */
@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Streaming query cursor
+ *
+ * A cursor walks the objects of a query in pages ordered by object id, each
+ * page asking for the objects after the last one received ("keyset"
+ * pagination), so the server never counts through skipped objects and a page
+ * that failed can be asked for again. The pages go over one connection of the
+ * cursor's own, kept open between them; a page that arrives on a connection
+ * the server has meanwhile closed is requested again on a new one.
+ *
+ * As soon as a page is in the window, the request for the next one is sent,
+ * so the server answers it while the application reads the objects of the
+ * current page. The answer waits in the network stack until the window is
+ * free again, which is the whole of the prefetch: there is no second page
+ * buffer and no thread. Memory stays bounded by the window, a page that does
+ * not fit is fetched again with half as many objects.
+ */
+
+#ifdef PARSE_ENABLE_QUERY_CURSOR
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_async.h"
+#include "parse_http.h"
+#include "parse_memory.h"
+#include "parse_request.h"
+#include "parse_trace.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define QUERY_CLASSES_PATH          "/1/classes/"
+#define QUERY_PATH_MAX_LEN          ( sizeof( QUERY_CLASSES_PATH ) + PARSE_QUERY_CLASS_MAX_LEN )
+#define QUERY_STRING_MAX_LEN        ( 640 )
+#define QUERY_RECEIVE_TIMEOUT_MS    ( 5000 )
+#define QUERY_HEADERS_END           "\r\n\r\n"
+#define QUERY_IDENTITY_ENCODING     "identity"
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static wiced_result_t query_request_page   ( parse_query_t* query );
+static wiced_result_t query_send           ( parse_query_t* query, int length );
+static wiced_result_t query_fetch_page     ( parse_query_t* query );
+static wiced_result_t query_receive        ( parse_query_t* query, uint32_t* length, uint32_t* body );
+static wiced_result_t query_read_page      ( parse_query_t* query, uint32_t length, uint32_t body );
+static void           query_disconnect     ( parse_query_t* query );
+static int            query_build_string   ( const parse_query_t* query, char* buffer, size_t size );
+static int            query_append         ( char* buffer, size_t size, int length, const char* text, int encode );
+static const char*    query_header         ( const char* headers, uint32_t length, const char* name );
+static int            query_has_member     ( const simple_json_value_t* object, const char* name );
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t parse_query_open( parse_client_t* client, parse_query_t* query, const char* class_name, const char* where, const char* keys, uint16_t limit )
+{
+    simple_json_value_t constraints;
+
+    if ( class_name == NULL || class_name[ 0 ] == '\0' || strlen( class_name ) > PARSE_QUERY_CLASS_MAX_LEN ||
+         ( keys != NULL && strlen( keys ) > PARSE_QUERY_KEYS_MAX_LEN ) || limit == 0 || limit > PARSE_QUERY_MAX_LIMIT )
+    {
+        return WICED_BADARG;
+    }
+
+    memset( query, 0, sizeof( *query ) );
+
+    if ( where != NULL )
+    {
+        const char* members;
+        size_t      length;
+
+        /* Only the members are kept, each page puts its objectId constraint in front of them */
+        if ( simpleJsonGetValue( where, strlen( where ), &constraints ) == 0 || constraints.type != SIMPLE_JSON_OBJECT )
+        {
+            return WICED_BADARG;
+        }
+
+        members = constraints.data + 1;
+        length  = constraints.length - 2;
+        while ( length > 0 && isspace( (unsigned char) members[ 0 ] ) )
+        {
+            ++members;
+            --length;
+        }
+        while ( length > 0 && isspace( (unsigned char) members[ length - 1 ] ) )
+        {
+            --length;
+        }
+
+        if ( length > PARSE_QUERY_WHERE_MAX_LEN || query_has_member( &constraints, "objectId" ) )
+        {
+            return WICED_BADARG;
+        }
+        memcpy( query->where, members, length );
+    }
+
+    query->client = client;
+    query->limit  = limit;
+    strcpy( query->class_name, class_name );
+    if ( keys != NULL )
+    {
+        strcpy( query->keys, keys );
+    }
+
+    PARSE_MEMORY_RESERVE( PARSE_MEMORY_QUERY_WINDOW, sizeof( query->window ) );
+
+    return query_request_page( query );
+}
+
+wiced_result_t parse_query_next( parse_query_t* query, simple_json_value_t* object )
+{
+    while ( 1 )
+    {
+        if ( query->results.data != NULL && simpleJsonNextElement( &query->results, &query->offset, object ) )
+        {
+            ++query->objects;
+            return WICED_SUCCESS;
+        }
+        query->results.data = NULL;
+
+        if ( query->finished )
+        {
+            return WICED_NOT_FOUND;
+        }
+
+        query->result = query_fetch_page( query );
+        if ( query->result != WICED_SUCCESS )
+        {
+            return query->result;
+        }
+    }
+}
+
+void parse_query_close( parse_query_t* query )
+{
+    query_disconnect( query );
+    query->requested    = 0;
+    query->results.data = NULL;
+}
+
+static wiced_result_t query_request_page( parse_query_t* query )
+{
+    char path  [ QUERY_PATH_MAX_LEN ];
+    char string[ QUERY_STRING_MAX_LEN ];
+    int  length;
+
+    /* The request is built in the client's parse_buffer, the installation worker's until then */
+    if ( PARSE_BOOTSTRAP_PENDING( query->client ) )
+    {
+        return WICED_NOT_CONNECTED;
+    }
+
+    if ( query_build_string( query, string, sizeof( string ) ) < 0 )
+    {
+        return WICED_BADARG;
+    }
+    snprintf( path, sizeof( path ), QUERY_CLASSES_PATH "%s", query->class_name );
+
+    length = parse_build_get_request( query->client, path, string );
+    if ( length < 0 )
+    {
+        WPRINT_LIB_INFO( ("[Parse] Query does not fit in the send buffer.\r\n") );
+        return WICED_BADARG;
+    }
+
+    return query_send( query, length );
+}
+
+static wiced_result_t query_send( parse_query_t* query, int length )
+{
+    wiced_result_t result = WICED_ERROR;
+
+    /* The server may have closed the kept connection meanwhile, then a new one is made */
+    query->reused = query->connected;
+    if ( query->connected )
+    {
+        result = wiced_tcp_send_buffer( &query->socket, query->client->parse_buffer, (uint16_t) length );
+        if ( result != WICED_SUCCESS )
+        {
+            query_disconnect( query );
+            query->reused = 0;
+        }
+    }
+
+    if ( !query->connected )
+    {
+        /* Not timed: the client's record belongs to its own requests, and a prefetched page waits
+         * in the network stack for the application, so its response time would measure that */
+        result = parse_connect_api_socket( query->client, &query->socket, &query->tls_context, WICED_FALSE );
+        ++query->connects;
+        PARSE_TRACE( PARSE_TRACE_QUERY_CONNECT, result );
+        if ( result == WICED_SUCCESS )
+        {
+            query->connected = 1;
+            result = wiced_tcp_send_buffer( &query->socket, query->client->parse_buffer, (uint16_t) length );
+            if ( result != WICED_SUCCESS )
+            {
+                query_disconnect( query );
+            }
+        }
+    }
+    PARSE_TRACE( PARSE_TRACE_REQUEST_SENT, length, result );
+
+    query->requested = ( result == WICED_SUCCESS );
+    return result;
+}
+
+static wiced_result_t query_fetch_page( parse_query_t* query )
+{
+    wiced_result_t result;
+    uint32_t       length;
+    uint32_t       body;
+    int            reused;
+
+    while ( 1 )
+    {
+        if ( !query->requested )
+        {
+            result = query_request_page( query );
+            if ( result != WICED_SUCCESS )
+            {
+                return result;
+            }
+        }
+
+        reused           = query->reused;
+        query->requested = 0;
+        result           = query_receive( query, &length, &body );
+
+        if ( result == WICED_PARTIAL_RESULTS && query->limit > 1 )
+        {
+            /* The page does not fit the window, the rest of it is dropped with the connection */
+            query->limit = (uint16_t) ( query->limit / 2 );
+            continue;
+        }
+
+        if ( result != WICED_SUCCESS && length == 0 && reused )
+        {
+            /* Closed by the server before the request got there, it is asked again on a new connection */
+            continue;
+        }
+
+        if ( result != WICED_SUCCESS )
+        {
+            return result;
+        }
+
+        return query_read_page( query, length, body );
+    }
+}
+
+static wiced_result_t query_receive( parse_query_t* query, uint32_t* length, uint32_t* body )
+{
+    const char* value;
+    long        content_length = -1;
+    int         close          = 0;
+
+    *length = 0;
+    *body   = 0;
+    query->http_status = 0;
+
+    while ( *body == 0 || content_length < 0 || *length < *body + (uint32_t) content_length )
+    {
+        wiced_packet_t* packet;
+        uint8_t*        data;
+        uint16_t        fragment;
+        uint16_t        available;
+        uint16_t        offset = 0;
+        wiced_result_t  result = wiced_tcp_receive( &query->socket, &packet, QUERY_RECEIVE_TIMEOUT_MS );
+
+        if ( result != WICED_SUCCESS )
+        {
+            if ( *body != 0 && content_length < 0 )
+            {
+                /* No length, the body ends with the connection */
+                close = 1;
+                break;
+            }
+            query_disconnect( query );
+            return result;
+        }
+
+        while ( wiced_packet_get_data( packet, offset, &data, &fragment, &available ) == WICED_SUCCESS && fragment > 0 )
+        {
+            if ( *length + fragment >= sizeof( query->window ) )
+            {
+                wiced_packet_delete( packet );
+                query_disconnect( query );
+                PARSE_MEMORY_USE( PARSE_MEMORY_QUERY_WINDOW, sizeof( query->window ), sizeof( query->window ) );
+                return WICED_PARTIAL_RESULTS;
+            }
+            memcpy( query->window + *length, data, fragment );
+            *length += fragment;
+            offset   = (uint16_t) ( offset + fragment );
+        }
+        wiced_packet_delete( packet );
+        query->window[ *length ] = '\0';
+
+        if ( *body == 0 )
+        {
+            const char* end = strstr( query->window, QUERY_HEADERS_END );
+
+            if ( end == NULL )
+            {
+                continue;
+            }
+
+            *body              = (uint32_t) ( end - query->window ) + sizeof( QUERY_HEADERS_END ) - 1;
+            query->http_status = getHttpResponseStatus( query->window );
+
+            /* Pages are parsed in place in the window, which a chunked body would interrupt with
+             * chunk sizes. The request asks for no encoding, so this takes a broken proxy. */
+            value = query_header( query->window, *body, "Transfer-Encoding" );
+            if ( value != NULL && strncasecmp( value, QUERY_IDENTITY_ENCODING, sizeof( QUERY_IDENTITY_ENCODING ) - 1 ) != 0 )
+            {
+                WPRINT_LIB_INFO( ("[Parse] Query page with a Transfer-Encoding, not supported.\r\n") );
+                query_disconnect( query );
+                return WICED_UNSUPPORTED;
+            }
+
+            value = query_header( query->window, *body, "Content-Length" );
+            if ( value != NULL )
+            {
+                content_length = strtol( value, NULL, 10 );
+            }
+            value = query_header( query->window, *body, "Connection" );
+            close = ( value != NULL && strncasecmp( value, "close", 5 ) == 0 );
+        }
+    }
+
+    PARSE_MEMORY_USE( PARSE_MEMORY_QUERY_WINDOW, sizeof( query->window ), *length + 1 );
+
+    if ( close )
+    {
+        query_disconnect( query );
+    }
+
+    return WICED_SUCCESS;
+}
+
+static wiced_result_t query_read_page( parse_query_t* query, uint32_t length, uint32_t body )
+{
+    simple_json_value_t results;
+    simple_json_value_t object;
+    simple_json_value_t last;
+    simple_json_value_t key;
+    simple_json_value_t value;
+    size_t              offset = 0;
+    uint32_t            count  = 0;
+
+    if ( query->http_status != 200 || !simpleJsonQuery( query->window + body, length - body, "results", &results ) ||
+         results.type != SIMPLE_JSON_ARRAY )
+    {
+        PARSE_TRACE( PARSE_TRACE_QUERY_PAGE, 0, length, query->http_status );
+        return WICED_ERROR;
+    }
+
+    while ( simpleJsonNextElement( &results, &offset, &object ) )
+    {
+        last = object;
+        ++count;
+    }
+    ++query->pages;
+    PARSE_TRACE( PARSE_TRACE_QUERY_PAGE, count, length, query->http_status );
+
+    query->results = results;
+    query->offset  = 0;
+
+    if ( count < query->limit )
+    {
+        /* A short page is the last one, the connection is not needed anymore */
+        query->finished = 1;
+        query_disconnect( query );
+        return WICED_SUCCESS;
+    }
+
+    /* The next page starts after the last object of this one */
+    query->last_object_id[ 0 ] = '\0';
+    offset = 0;
+    while ( simpleJsonNextMember( &last, &offset, &key, &value ) )
+    {
+        if ( simpleJsonValueEquals( &key, "objectId" ) && value.type == SIMPLE_JSON_STRING && value.length <= OBJECT_ID_MAX_LEN )
+        {
+            memcpy( query->last_object_id, value.data, value.length );
+            query->last_object_id[ value.length ] = '\0';
+            break;
+        }
+    }
+    if ( query->last_object_id[ 0 ] == '\0' )
+    {
+        query->results.data = NULL;
+        return WICED_ERROR;
+    }
+
+    /* Prefetch: the server prepares the next page while the application reads this one. If the
+     * request fails it is sent again when the page is needed. */
+    query_request_page( query );
+
+    return WICED_SUCCESS;
+}
+
+static void query_disconnect( parse_query_t* query )
+{
+    if ( query->connected )
+    {
+        wiced_tcp_disconnect( &query->socket );
+        wiced_tcp_delete_socket( &query->socket );
+        query->connected = 0;
+    }
+}
+
+static int query_build_string( const parse_query_t* query, char* buffer, size_t size )
+{
+    int length = 0;
+
+    /* where={"objectId":{"$gt":"<last>"},<constraints>}&order=objectId&limit=<n>&keys=<keys> */
+    if ( query->last_object_id[ 0 ] != '\0' || query->where[ 0 ] != '\0' )
+    {
+        length = query_append( buffer, size, length, "where=", 0 );
+        length = query_append( buffer, size, length, "{", 1 );
+        if ( query->last_object_id[ 0 ] != '\0' )
+        {
+            length = query_append( buffer, size, length, "\"objectId\":{\"$gt\":\"", 1 );
+            length = query_append( buffer, size, length, query->last_object_id, 1 );
+            length = query_append( buffer, size, length, ( query->where[ 0 ] != '\0' ) ? "\"}," : "\"}", 1 );
+        }
+        length = query_append( buffer, size, length, query->where, 1 );
+        length = query_append( buffer, size, length, "}", 1 );
+        length = query_append( buffer, size, length, "&", 0 );
+    }
+
+    length = query_append( buffer, size, length, "order=objectId&limit=", 0 );
+    if ( length >= 0 && snprintf( buffer + length, size - length, "%u", (unsigned int) query->limit ) < (int) ( size - length ) )
+    {
+        length += (int) strlen( buffer + length );
+    }
+    else
+    {
+        length = -1;
+    }
+
+    if ( query->keys[ 0 ] != '\0' )
+    {
+        length = query_append( buffer, size, length, "&keys=", 0 );
+        length = query_append( buffer, size, length, query->keys, 1 );
+    }
+
+    return length;
+}
+
+static int query_append( char* buffer, size_t size, int length, const char* text, int encode )
+{
+    static const char hex[ ] = "0123456789ABCDEF";
+
+    if ( length < 0 )
+    {
+        return length;
+    }
+
+    for ( ; *text != '\0'; ++text )
+    {
+        unsigned char c = (unsigned char) *text;
+
+        /* Percent-encode everything but the unreserved characters of RFC 3986 */
+        if ( !encode || isalnum( c ) || c == '-' || c == '_' || c == '.' || c == '~' )
+        {
+            if ( (size_t) length + 1 >= size )
+            {
+                return -1;
+            }
+            buffer[ length++ ] = (char) c;
+        }
+        else
+        {
+            if ( (size_t) length + 3 >= size )
+            {
+                return -1;
+            }
+            buffer[ length++ ] = '%';
+            buffer[ length++ ] = hex[ c >> 4 ];
+            buffer[ length++ ] = hex[ c & 0x0F ];
+        }
+    }
+    buffer[ length ] = '\0';
+
+    return length;
+}
+
+static const char* query_header( const char* headers, uint32_t length, const char* name )
+{
+    size_t      name_length = strlen( name );
+    const char* line        = strstr( headers, "\r\n" );
+    const char* end         = headers + length;
+
+    /* Header names are case insensitive, the value is returned without leading spaces */
+    while ( line != NULL && line + 2 < end )
+    {
+        line += 2;
+        if ( strncasecmp( line, name, name_length ) == 0 && line[ name_length ] == ':' )
+        {
+            line += name_length + 1;
+            while ( *line == ' ' || *line == '\t' )
+            {
+                ++line;
+            }
+            return line;
+        }
+        line = strstr( line, "\r\n" );
+    }
+
+    return NULL;
+}
+
+/* Each page puts its own objectId constraint in front of the caller's, which must not have one */
+static int query_has_member( const simple_json_value_t* object, const char* name )
+{
+    simple_json_value_t key;
+    simple_json_value_t value;
+    size_t              offset = 0;
+
+    while ( simpleJsonNextMember( object, &offset, &key, &value ) )
+    {
+        if ( simpleJsonValueEquals( &key, name ) )
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+#endif /* PARSE_ENABLE_QUERY_CURSOR */
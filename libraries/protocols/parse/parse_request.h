@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "wiced.h"
+#include "parse.h"
+#include "simplejson.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define PARSE_STRING_FIELD_MAX_LEN  ( INSTALLATION_ID_MAX_LEN )
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/* Writes a JSON request body. Called twice per request: once to measure the
+ * body for Content-Length, once to write it after the headers. */
+typedef void (*parse_json_body_t)( parse_client_t* client, simple_json_writer_t* writer );
+
+/******************************************************
+ *                Function Declarations
+ ******************************************************/
+
+/* parse_internal.c, parse_send_request() with a body written straight into the request buffer. It
+ * fails with WICED_NOT_CONNECTED while parse_init_async() resolves the installation. */
+void parse_send_json_request( parse_client_t* client, const char* httpVerb, const char* httpPath, parse_json_body_t jsonBody, parse_request_callback_t callback );
+
+/* parse_internal.c, resolves the API server and connects a socket to it with TLS. The socket is
+ * deleted again on failure. With timed, the phases are marked in the latency record of the
+ * client's request, which the caller has begun. */
+wiced_result_t parse_connect_api_socket( parse_client_t* client, wiced_tcp_socket_t* socket, wiced_tls_simple_context_t* context, wiced_bool_t timed );
+
+/* parse_internal.c, builds a GET request of the client in its parse_buffer, returns its length or
+ * -1 if it does not fit */
+int parse_build_get_request( parse_client_t* client, const char* httpPath, const char* httpQuery );
+
+/* parse_internal.c, simpleJsonUnescape() of a response value into a field of at most
+ * PARSE_STRING_FIELD_MAX_LEN characters. The field keeps its value if the string does not fit or is
+ * not valid, it is only overwritten on success. Returns the length, or -1. */
+int parse_copy_json_string( const simple_json_value_t* value, char* field, size_t size );
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "simplejson.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file
+ *
+ * Typed objects generated from a schema
+ *
+ * A class is declared once as a list of fields, an X-macro that calls its
+ * argument with the type, name and, for strings, the maximum length of
+ * each field:
+ *
+ *     #define DEVICE_FIELDS( FIELD )          \
+ *         FIELD( STRING, name,        15 )    \
+ *         FIELD( INT,    boots,       0  )    \
+ *         FIELD( FLOAT,  temperature, 0  )    \
+ *         FIELD( BOOL,   online,      0  )
+ *
+ *     PARSE_SCHEMA_DECLARE( device, DEVICE_FIELDS )     in a header
+ *     PARSE_SCHEMA_DEFINE( device, DEVICE_FIELDS )      in one source file
+ *
+ * which gives the struct device_t, with a member of the field's C type for
+ * every field and a bit per field in device_t.present, and
+ *
+ *     void device_write( simple_json_writer_t* writer, const device_t* object );
+ *     int  device_read( const char* json, size_t length, device_t* object );
+ *     int  device_read_value( const simple_json_value_t* json, device_t* object );
+ *
+ * The writer writes the present fields, so the same struct makes creations
+ * and partial updates. The readers walk the members of the object once,
+ * without scanning the document first, and match each key against the field
+ * names with a length check and a compare of constant size, instead of one
+ * search of the document per field.
+ * Unknown members, and members whose JSON type does not fit the field, are
+ * skipped.
+ *
+ * Field types and their members:
+ *
+ *     BOOL                 uint8_t
+ *     INT                  int32_t, larger numbers are skipped
+ *     INT64                int64_t
+ *     FLOAT                float
+ *     DOUBLE               double
+ *     STRING               char[ length + 1 ], longer strings are skipped
+ *
+ * Field names are the JSON keys, escape sequences in keys are not decoded.
+ */
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/*! \def PARSE_SCHEMA_DECLARE
+ *  \brief The struct of a schema and the declarations of its functions
+ */
+#define PARSE_SCHEMA_DECLARE( schema, FIELDS )                                                              \
+    typedef struct                                                                                          \
+    {                                                                                                       \
+        FIELDS( PARSE_SCHEMA_MEMBER )                                                                       \
+        struct                                                                                              \
+        {                                                                                                   \
+            FIELDS( PARSE_SCHEMA_PRESENT_BIT )                                                              \
+        } present;                                                                                          \
+    } schema##_t;                                                                                           \
+                                                                                                            \
+    void schema##_write     ( simple_json_writer_t* writer, const schema##_t* object );                     \
+    int  schema##_read      ( const char* json, size_t length, schema##_t* object );                        \
+    int  schema##_read_value( const simple_json_value_t* json, schema##_t* object );
+
+/*! \def PARSE_SCHEMA_DEFINE
+ *  \brief The functions of a schema declared with PARSE_SCHEMA_DECLARE()
+ *
+ *  The readers clear the object first and return the number of fields read, or -1 if the
+ *  JSON is not an object.
+ */
+#define PARSE_SCHEMA_DEFINE( schema, FIELDS )                                                               \
+    void schema##_write( simple_json_writer_t* writer, const schema##_t* object )                           \
+    {                                                                                                       \
+        simpleJsonWriteStartObject( writer );                                                               \
+        FIELDS( PARSE_SCHEMA_WRITE_FIELD )                                                                  \
+        simpleJsonWriteEndObject( writer );                                                                 \
+    }                                                                                                       \
+                                                                                                            \
+    int schema##_read_value( const simple_json_value_t* json, schema##_t* object )                          \
+    {                                                                                                       \
+        simple_json_value_t key;                                                                            \
+        simple_json_value_t value;                                                                          \
+        size_t              offset = 0;                                                                     \
+        int                 count  = 0;                                                                     \
+        int64_t             schema_integer;                                                                 \
+        double              schema_number;                                                                  \
+        int                 schema_boolean;                                                                 \
+                                                                                                            \
+        (void) schema_integer;                                                                              \
+        (void) schema_number;                                                                               \
+        (void) schema_boolean;                                                                              \
+        memset( object, 0, sizeof( *object ) );                                                             \
+        if ( json->type != SIMPLE_JSON_OBJECT )                                                             \
+        {                                                                                                   \
+            return -1;                                                                                      \
+        }                                                                                                   \
+        while ( simpleJsonNextMember( json, &offset, &key, &value ) )                                       \
+        {                                                                                                   \
+            FIELDS( PARSE_SCHEMA_READ_FIELD )                                                               \
+        }                                                                                                   \
+        return count;                                                                                       \
+    }                                                                                                       \
+                                                                                                            \
+    int schema##_read( const char* json, size_t length, schema##_t* object )                                \
+    {                                                                                                       \
+        simple_json_value_t value;                                                                          \
+                                                                                                            \
+        if ( simpleJsonBeginObject( json, length, &value ) == 0 )                                           \
+        {                                                                                                   \
+            memset( object, 0, sizeof( *object ) );                                                         \
+            return -1;                                                                                      \
+        }                                                                                                   \
+        return schema##_read_value( &value, object );                                                       \
+    }
+
+/*! \def PARSE_SCHEMA_SET_ALL
+ *  \brief Mark every field of an object present, for a write of the whole object
+ */
+#define PARSE_SCHEMA_SET_ALL( object )  memset( &( object )->present, 0xFF, sizeof( ( object )->present ) )
+
+/* Expansions of a field, by type. The readers are expressions that are true when the value fit */
+
+#define PARSE_SCHEMA_MEMBER( type, name, max_len )           PARSE_SCHEMA_MEMBER_##type( name, max_len )
+#define PARSE_SCHEMA_PRESENT_BIT( type, name, max_len )      unsigned int name : 1;
+
+#define PARSE_SCHEMA_MEMBER_BOOL( name, max_len )            uint8_t name;
+#define PARSE_SCHEMA_MEMBER_INT( name, max_len )             int32_t name;
+#define PARSE_SCHEMA_MEMBER_INT64( name, max_len )           int64_t name;
+#define PARSE_SCHEMA_MEMBER_FLOAT( name, max_len )           float   name;
+#define PARSE_SCHEMA_MEMBER_DOUBLE( name, max_len )          double  name;
+#define PARSE_SCHEMA_MEMBER_STRING( name, max_len )          char    name[ ( max_len ) + 1 ];
+
+#define PARSE_SCHEMA_WRITE_FIELD( type, name, max_len )                                                      \
+    if ( object->present.name )                                                                             \
+    {                                                                                                       \
+        simpleJsonWriteKey( writer, #name );                                                                \
+        PARSE_SCHEMA_WRITE_##type( writer, object->name );                                                  \
+    }
+
+#define PARSE_SCHEMA_WRITE_BOOL( writer, member )           simpleJsonWriteBool( writer, member )
+#define PARSE_SCHEMA_WRITE_INT( writer, member )            simpleJsonWriteInt( writer, member )
+#define PARSE_SCHEMA_WRITE_INT64( writer, member )          simpleJsonWriteInt( writer, member )
+#define PARSE_SCHEMA_WRITE_FLOAT( writer, member )          simpleJsonWriteDouble( writer, member )
+#define PARSE_SCHEMA_WRITE_DOUBLE( writer, member )         simpleJsonWriteDouble( writer, member )
+#define PARSE_SCHEMA_WRITE_STRING( writer, member )         simpleJsonWriteString( writer, member )
+
+#define PARSE_SCHEMA_READ_FIELD( type, name, max_len )                                                       \
+    if ( key.length == sizeof( #name ) - 1 && memcmp( key.data, #name, sizeof( #name ) - 1 ) == 0 )         \
+    {                                                                                                       \
+        if ( PARSE_SCHEMA_READ_##type( &value, object->name ) )                                             \
+        {                                                                                                   \
+            object->present.name = 1;                                                                       \
+            ++count;                                                                                        \
+        }                                                                                                   \
+        continue;                                                                                           \
+    }
+
+#define PARSE_SCHEMA_READ_BOOL( value, member )                                                             \
+    ( simpleJsonGetBool( value, &schema_boolean ) && ( ( member ) = (uint8_t) schema_boolean, 1 ) )
+#define PARSE_SCHEMA_READ_INT( value, member )                                                              \
+    ( simpleJsonGetInt64( value, &schema_integer ) && schema_integer >= INT32_MIN && schema_integer <= INT32_MAX && \
+      ( ( member ) = (int32_t) schema_integer, 1 ) )
+#define PARSE_SCHEMA_READ_INT64( value, member )                                                            \
+    simpleJsonGetInt64( value, &( member ) )
+#define PARSE_SCHEMA_READ_FLOAT( value, member )                                                            \
+    ( simpleJsonGetDouble( value, &schema_number ) && ( ( member ) = (float) schema_number, 1 ) )
+#define PARSE_SCHEMA_READ_DOUBLE( value, member )                                                           \
+    simpleJsonGetDouble( value, &( member ) )
+#define PARSE_SCHEMA_READ_STRING( value, member )                                                           \
+    ( ( value )->type == SIMPLE_JSON_STRING && simpleJsonUnescape( value, member, sizeof( member ) ) >= 0 )
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,599 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Buffered telemetry uploads
+ *
+ * Samples are appended to per-metric columns in the client and uploaded
+ * together, as one object per metric. The size of the upload is kept up to
+ * date as samples come and go, so that thresholds are checked without
+ * formatting the whole body: every sample adds the length of its two numbers
+ * and two commas, the first sample of a metric also the object around them
+ * with an empty dt and v. The estimate is never below the real size.
+ *
+ * With the compact encoding each metric keeps a time_series_encoder_t that
+ * only counts bits, and a sample adds the growth of the base64 text and of
+ * the sample count "n", which is exact. The stream itself is only built when
+ * the body is written, in one static buffer large enough for a full metric.
+ *
+ * The body is written by the request path straight into the request buffer,
+ * once to measure it and once after the headers, so it must not change
+ * between the two: the wall clock times are computed from the clocks read
+ * when the upload starts.
+ */
+
+#ifdef PARSE_ENABLE_TELEMETRY
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_request.h"
+#include "parse_telemetry.h"
+#include "parse_memory.h"
+#include <string.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#ifndef PARSE_BUFFER_STORAGE
+#define PARSE_BUFFER_STORAGE    static
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define TELEMETRY_CLASSES_PATH          "/1/classes/"
+#define TELEMETRY_BATCH_PATH            "/1/batch"
+#define TELEMETRY_PATH_MAX_LEN          ( sizeof( TELEMETRY_CLASSES_PATH ) - 1 + PARSE_TELEMETRY_CLASS_MAX_LEN )
+
+/* {"requests":[]} around the objects of a batch upload */
+#define TELEMETRY_BATCH_BYTES           ( 15 )
+
+/* "enc" of objects with PARSE_TELEMETRY_ENCODING_TIME_SERIES, and the base64 of a full metric */
+#define TELEMETRY_TIME_SERIES_ENCODING  "ts1"
+#define TELEMETRY_TIME_SERIES_SIZE      TIME_SERIES_BASE64_LENGTH( TIME_SERIES_MAX_BYTES( PARSE_TELEMETRY_MAX_SAMPLES ) )
+
+/* Threshold uploads wait this long after a failed one, samples keep being recorded */
+#ifndef TELEMETRY_RETRY_INTERVAL_MS
+#define TELEMETRY_RETRY_INTERVAL_MS     ( 30000 )
+#endif
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static wiced_result_t telemetry_upload         ( parse_client_t* client );
+static void           telemetry_uploaded       ( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody );
+static void           telemetry_write_body     ( parse_client_t* client, simple_json_writer_t* writer );
+static void           telemetry_write_object   ( parse_client_t* client, simple_json_writer_t* writer, const parse_telemetry_metric_t* metric, uint16_t count, wiced_utc_time_ms_t t0 );
+static void           telemetry_write_request  ( parse_client_t* client, simple_json_writer_t* writer, const parse_telemetry_metric_t* metric, uint16_t count, wiced_utc_time_ms_t t0 );
+static uint32_t       telemetry_time_series    ( const parse_telemetry_metric_t* metric, uint16_t count );
+static uint16_t       telemetry_sample_bytes   ( parse_client_t* client, const parse_telemetry_metric_t* metric, uint16_t index, wiced_time_t time, float value );
+static int            telemetry_digits         ( uint16_t value );
+static void           telemetry_update_bytes   ( parse_client_t* client, parse_telemetry_metric_t* metric );
+static void           telemetry_remove         ( parse_client_t* client, parse_telemetry_metric_t* metric, uint16_t count );
+static wiced_bool_t   telemetry_is_due         ( parse_telemetry_t* telemetry, wiced_time_t now, uint32_t age_ms );
+static int            telemetry_metrics_pending( const parse_telemetry_t* telemetry );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const parse_telemetry_config_t telemetry_default_config =
+{
+    .max_samples      = PARSE_TELEMETRY_MAX_SAMPLES,
+    .max_bytes        = 640,
+    .max_age_ms       = 60000,
+    .piggyback_age_ms = 10000,
+    .encoding         = PARSE_TELEMETRY_ENCODING_JSON,
+};
+
+PARSE_BUFFER_STORAGE uint8_t telemetry_time_series_buffer[ TELEMETRY_TIME_SERIES_SIZE ];
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t parse_telemetry_init( parse_client_t* client, const char* class_name, const parse_telemetry_config_t* config, parse_request_callback_t callback )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+
+    if ( config == NULL )
+    {
+        config = &telemetry_default_config;
+    }
+    if ( class_name == NULL || class_name[ 0 ] == '\0' || strlen( class_name ) > PARSE_TELEMETRY_CLASS_MAX_LEN ||
+         config->max_samples == 0 || config->max_samples > PARSE_TELEMETRY_MAX_SAMPLES ||
+         (unsigned) config->encoding > PARSE_TELEMETRY_ENCODING_TIME_SERIES )
+    {
+        return WICED_BADARG;
+    }
+
+    memset( telemetry, 0, sizeof( *telemetry ) );
+    strcpy( telemetry->class_name, class_name );
+    telemetry->config   = *config;
+    telemetry->callback = callback;
+
+    return WICED_SUCCESS;
+}
+
+int parse_telemetry_add_metric( parse_client_t* client, const char* name )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+    int                metric;
+
+    for ( metric = 0; metric < telemetry->metric_count; metric++ )
+    {
+        if ( strcmp( telemetry->metrics[ metric ].name, name ) == 0 )
+        {
+            return metric;
+        }
+    }
+
+    if ( telemetry->class_name[ 0 ] == '\0' || telemetry->metric_count >= PARSE_TELEMETRY_MAX_METRICS || strlen( name ) > PARSE_TELEMETRY_NAME_MAX_LEN )
+    {
+        return -1;
+    }
+
+    strcpy( telemetry->metrics[ telemetry->metric_count ].name, name );
+    time_series_encoder_init( &telemetry->metrics[ telemetry->metric_count ].encoder, NULL, 0 );
+
+    return telemetry->metric_count++;
+}
+
+wiced_result_t parse_telemetry_record( parse_client_t* client, int metric, float value )
+{
+    parse_telemetry_t*        telemetry = &client->telemetry;
+    parse_telemetry_metric_t* samples;
+    wiced_time_t              now;
+    uint16_t                  bytes;
+
+    if ( metric < 0 || metric >= telemetry->metric_count )
+    {
+        return WICED_BADARG;
+    }
+    samples = &telemetry->metrics[ metric ];
+
+    wiced_time_get_time( &now );
+    bytes = telemetry_sample_bytes( client, samples, samples->count, now, value );
+
+    /* Upload first rather than go over the size of the body */
+    if ( telemetry->pending > 0 && telemetry->bytes + bytes > telemetry->config.max_bytes && telemetry_is_due( telemetry, now, 0 ) )
+    {
+        telemetry_upload( client );
+        bytes = telemetry_sample_bytes( client, samples, samples->count, now, value );
+    }
+
+    /* The upload failed or is waiting to be retried, make room */
+    while ( samples->count > 0 && ( samples->count >= telemetry->config.max_samples || telemetry->bytes + bytes > telemetry->config.max_bytes ) )
+    {
+        telemetry_remove( client, samples, 1 );
+        samples->dropped++;
+        bytes = telemetry_sample_bytes( client, samples, samples->count, now, value );
+    }
+    if ( ( telemetry->pending == 0 ? TELEMETRY_BATCH_BYTES : telemetry->bytes ) + bytes > telemetry->config.max_bytes )
+    {
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+
+    samples->times [ samples->count ] = now;
+    samples->values[ samples->count ] = value;
+    samples->count++;
+    time_series_encode( &samples->encoder, (uint32_t) now, value );
+    samples->bytes = (uint16_t) ( samples->bytes + bytes );
+    telemetry->bytes = (uint16_t) ( ( telemetry->pending == 0 ? TELEMETRY_BATCH_BYTES : telemetry->bytes ) + bytes );
+    telemetry->pending++;
+
+    if ( samples->count >= telemetry->config.max_samples ? telemetry_is_due( telemetry, now, 0 ) : telemetry_is_due( telemetry, now, telemetry->config.max_age_ms ) )
+    {
+        telemetry_upload( client );
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t parse_telemetry_poll( parse_client_t* client )
+{
+    wiced_time_t now;
+
+    wiced_time_get_time( &now );
+    if ( telemetry_is_due( &client->telemetry, now, client->telemetry.config.max_age_ms ) )
+    {
+        return telemetry_upload( client );
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t parse_telemetry_flush( parse_client_t* client )
+{
+    if ( client->telemetry.pending == 0 || client->telemetry.uploading )
+    {
+        return WICED_SUCCESS;
+    }
+
+    return telemetry_upload( client );
+}
+
+void parse_telemetry_piggyback( parse_client_t* client )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+    wiced_time_t       now;
+
+    if ( telemetry->config.piggyback_age_ms == 0 )
+    {
+        return;
+    }
+
+    wiced_time_get_time( &now );
+    if ( telemetry_is_due( telemetry, now, telemetry->config.piggyback_age_ms ) )
+    {
+        telemetry_upload( client );
+    }
+}
+
+static wiced_result_t telemetry_upload( parse_client_t* client )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+    uint16_t           sent[ PARSE_TELEMETRY_MAX_METRICS ];
+    char               path[ TELEMETRY_PATH_MAX_LEN + 1 ];
+    int                metric;
+
+    telemetry->uploading = WICED_TRUE;
+    telemetry->result    = WICED_ERROR;
+    wiced_time_get_time( &telemetry->upload_time );
+    wiced_time_get_utc_time_ms( &telemetry->upload_utc );
+
+    /* Samples recorded from the callback are not part of this upload */
+    for ( metric = 0; metric < telemetry->metric_count; metric++ )
+    {
+        sent[ metric ] = telemetry->metrics[ metric ].count;
+    }
+
+    if ( telemetry_metrics_pending( telemetry ) == 1 )
+    {
+        strcpy( path, TELEMETRY_CLASSES_PATH );
+        strcat( path, telemetry->class_name );
+    }
+    else
+    {
+        strcpy( path, TELEMETRY_BATCH_PATH );
+    }
+
+    parse_send_json_request( client, "POST", path, telemetry_write_body, telemetry_uploaded );
+
+    if ( telemetry->result == WICED_SUCCESS )
+    {
+        for ( metric = 0; metric < telemetry->metric_count; metric++ )
+        {
+            telemetry_remove( client, &telemetry->metrics[ metric ], sent[ metric ] );
+        }
+        telemetry->retry_pending = WICED_FALSE;
+    }
+    else
+    {
+        telemetry->retry_time    = telemetry->upload_time + TELEMETRY_RETRY_INTERVAL_MS;
+        telemetry->retry_pending = WICED_TRUE;
+    }
+    telemetry->uploading = WICED_FALSE;
+
+    return telemetry->result;
+}
+
+static void telemetry_uploaded( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+
+    /* A batch is answered with 200 and a result per object, the objects were received either way */
+    if ( error != 0 )
+    {
+        telemetry->result = (wiced_result_t) error;
+    }
+    else
+    {
+        telemetry->result = ( httpStatus >= 200 && httpStatus < 300 ) ? WICED_SUCCESS : WICED_ERROR;
+    }
+
+    if ( telemetry->callback != NULL )
+    {
+        telemetry->callback( client, error, httpStatus, httpResponseBody );
+    }
+}
+
+static void telemetry_write_body( parse_client_t* client, simple_json_writer_t* writer )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+    wiced_bool_t       batch     = telemetry_metrics_pending( telemetry ) > 1;
+    int                metric;
+
+    if ( batch )
+    {
+        simpleJsonWriteStartObject( writer );
+        simpleJsonWriteKey( writer, "requests" );
+        simpleJsonWriteStartArray( writer );
+    }
+
+    for ( metric = 0; metric < telemetry->metric_count; metric++ )
+    {
+        const parse_telemetry_metric_t* samples = &telemetry->metrics[ metric ];
+        wiced_utc_time_ms_t             t0;
+
+        if ( samples->count == 0 )
+        {
+            continue;
+        }
+
+        t0 = telemetry->upload_utc - ( telemetry->upload_time - samples->times[ 0 ] );
+        if ( batch )
+        {
+            telemetry_write_request( client, writer, samples, samples->count, t0 );
+        }
+        else
+        {
+            telemetry_write_object( client, writer, samples, samples->count, t0 );
+        }
+    }
+
+    if ( batch )
+    {
+        simpleJsonWriteEndArray( writer );
+        simpleJsonWriteEndObject( writer );
+    }
+}
+
+/* The object of the first count samples of a metric */
+static void telemetry_write_object( parse_client_t* client, simple_json_writer_t* writer, const parse_telemetry_metric_t* metric, uint16_t count, wiced_utc_time_ms_t t0 )
+{
+    uint16_t sample;
+
+    simpleJsonWriteStartObject( writer );
+    simpleJsonWriteKey( writer, "metric" );
+    simpleJsonWriteString( writer, metric->name );
+    simpleJsonWriteKey( writer, "installationId" );
+    simpleJsonWriteString( writer, client->installation_id );
+    simpleJsonWriteKey( writer, "t0" );
+    simpleJsonWriteInt( writer, (int64_t) t0 );
+
+    if ( client->telemetry.config.encoding == PARSE_TELEMETRY_ENCODING_TIME_SERIES )
+    {
+        simpleJsonWriteKey( writer, "n" );
+        simpleJsonWriteInt( writer, count );
+        simpleJsonWriteKey( writer, "enc" );
+        simpleJsonWriteString( writer, TELEMETRY_TIME_SERIES_ENCODING );
+        simpleJsonWriteKey( writer, "data" );
+        simpleJsonWriteStringN( writer, (const char*) telemetry_time_series_buffer, telemetry_time_series( metric, count ) );
+        simpleJsonWriteEndObject( writer );
+        return;
+    }
+
+    simpleJsonWriteKey( writer, "dt" );
+    simpleJsonWriteStartArray( writer );
+    for ( sample = 0; sample < count; sample++ )
+    {
+        simpleJsonWriteInt( writer, (int64_t) ( metric->times[ sample ] - metric->times[ 0 ] ) );
+    }
+    simpleJsonWriteEndArray( writer );
+
+    simpleJsonWriteKey( writer, "v" );
+    simpleJsonWriteStartArray( writer );
+    for ( sample = 0; sample < count; sample++ )
+    {
+        simpleJsonWriteDouble( writer, metric->values[ sample ] );
+    }
+    simpleJsonWriteEndArray( writer );
+    simpleJsonWriteEndObject( writer );
+}
+
+static void telemetry_write_request( parse_client_t* client, simple_json_writer_t* writer, const parse_telemetry_metric_t* metric, uint16_t count, wiced_utc_time_ms_t t0 )
+{
+    char path[ TELEMETRY_PATH_MAX_LEN + 1 ];
+
+    strcpy( path, TELEMETRY_CLASSES_PATH );
+    strcat( path, client->telemetry.class_name );
+
+    simpleJsonWriteStartObject( writer );
+    simpleJsonWriteKey( writer, "method" );
+    simpleJsonWriteString( writer, "POST" );
+    simpleJsonWriteKey( writer, "path" );
+    simpleJsonWriteString( writer, path );
+    simpleJsonWriteKey( writer, "body" );
+    telemetry_write_object( client, writer, metric, count, t0 );
+    simpleJsonWriteEndObject( writer );
+}
+
+/* Base64 of the first count samples of a metric, in telemetry_time_series_buffer */
+static uint32_t telemetry_time_series( const parse_telemetry_metric_t* metric, uint16_t count )
+{
+    time_series_encoder_t encoder;
+    uint32_t              length;
+    uint16_t              sample;
+
+    if ( count == 0 )
+    {
+        return 0;
+    }
+
+    time_series_encoder_init( &encoder, telemetry_time_series_buffer, sizeof( telemetry_time_series_buffer ) );
+    for ( sample = 0; sample < count; sample++ )
+    {
+        time_series_encode( &encoder, (uint32_t) metric->times[ sample ], metric->values[ sample ] );
+    }
+    length = time_series_base64( telemetry_time_series_buffer, time_series_encoder_length( &encoder ), sizeof( telemetry_time_series_buffer ) );
+    PARSE_MEMORY_USE( PARSE_MEMORY_TELEMETRY_DATA, sizeof( telemetry_time_series_buffer ), length );
+
+    return length;
+}
+
+/* Growth of the upload when a sample is stored at index of the metric. With the compact
+ * encoding, metric->encoder must hold the samples before index */
+static uint16_t telemetry_sample_bytes( parse_client_t* client, const parse_telemetry_metric_t* metric, uint16_t index, wiced_time_t time, float value )
+{
+    simple_json_writer_t  writer;
+    time_series_encoder_t encoder;
+    wiced_utc_time_ms_t   now;
+    int                   bytes;
+
+    if ( client->telemetry.config.encoding == PARSE_TELEMETRY_ENCODING_TIME_SERIES )
+    {
+        /* The longer base64 text, and n when it gains a digit */
+        encoder = metric->encoder;
+        bytes   = -(int) TIME_SERIES_BASE64_LENGTH( time_series_encoder_length( &encoder ) );
+        time_series_encode( &encoder, (uint32_t) time, value );
+        bytes  += (int) TIME_SERIES_BASE64_LENGTH( time_series_encoder_length( &encoder ) );
+        bytes  += telemetry_digits( (uint16_t) ( index + 1 ) ) - telemetry_digits( index );
+    }
+    else
+    {
+        /* [dt,v] is the two numbers and a comma, one more for the comma before each */
+        simpleJsonWriterInit( &writer, NULL, 0 );
+        simpleJsonWriteStartArray( &writer );
+        simpleJsonWriteInt( &writer, ( index == 0 ) ? 0 : (int64_t) ( time - metric->times[ 0 ] ) );
+        simpleJsonWriteDouble( &writer, value );
+        simpleJsonWriteEndArray( &writer );
+        bytes = simpleJsonWriterFinish( &writer ) - 1;
+    }
+
+    if ( index == 0 )
+    {
+        /* The batch request of the metric without samples, and the comma before it */
+        wiced_time_get_utc_time_ms( &now );
+        simpleJsonWriterInit( &writer, NULL, 0 );
+        telemetry_write_request( client, &writer, metric, 0, now );
+        bytes += simpleJsonWriterFinish( &writer ) + 1;
+    }
+
+    return (uint16_t) bytes;
+}
+
+/* Sizes after samples were removed, the offsets of the others changed */
+static void telemetry_update_bytes( parse_client_t* client, parse_telemetry_metric_t* metric )
+{
+    parse_telemetry_t* telemetry = &client->telemetry;
+    uint16_t           sample;
+    int                m;
+
+    metric->bytes = 0;
+    time_series_encoder_init( &metric->encoder, NULL, 0 );
+    for ( sample = 0; sample < metric->count; sample++ )
+    {
+        metric->bytes = (uint16_t) ( metric->bytes + telemetry_sample_bytes( client, metric, sample, metric->times[ sample ], metric->values[ sample ] ) );
+        time_series_encode( &metric->encoder, (uint32_t) metric->times[ sample ], metric->values[ sample ] );
+    }
+
+    telemetry->pending = 0;
+    telemetry->bytes   = TELEMETRY_BATCH_BYTES;
+    for ( m = 0; m < telemetry->metric_count; m++ )
+    {
+        telemetry->pending = (uint16_t) ( telemetry->pending + telemetry->metrics[ m ].count );
+        telemetry->bytes   = (uint16_t) ( telemetry->bytes   + telemetry->metrics[ m ].bytes );
+    }
+    if ( telemetry->pending == 0 )
+    {
+        telemetry->bytes = 0;
+    }
+}
+
+/* Removes the oldest samples of a metric */
+static void telemetry_remove( parse_client_t* client, parse_telemetry_metric_t* metric, uint16_t count )
+{
+    if ( count == 0 )
+    {
+        return;
+    }
+
+    metric->count = (uint16_t) ( metric->count - count );
+    memmove( metric->times,  metric->times  + count, metric->count * sizeof( metric->times[ 0 ] ) );
+    memmove( metric->values, metric->values + count, metric->count * sizeof( metric->values[ 0 ] ) );
+    telemetry_update_bytes( client, metric );
+}
+
+/* Whether the oldest sample is age_ms old and an upload may start */
+static wiced_bool_t telemetry_is_due( parse_telemetry_t* telemetry, wiced_time_t now, uint32_t age_ms )
+{
+    int metric;
+
+    /* Only compared while it is set, the clock wraps around in 49 days */
+    if ( telemetry->retry_pending && (int32_t) ( now - telemetry->retry_time ) >= 0 )
+    {
+        telemetry->retry_pending = WICED_FALSE;
+    }
+
+    if ( telemetry->pending == 0 || telemetry->uploading || telemetry->retry_pending )
+    {
+        return WICED_FALSE;
+    }
+
+    for ( metric = 0; metric < telemetry->metric_count; metric++ )
+    {
+        const parse_telemetry_metric_t* samples = &telemetry->metrics[ metric ];
+
+        if ( samples->count > 0 && now - samples->times[ 0 ] >= age_ms )
+        {
+            return WICED_TRUE;
+        }
+    }
+
+    return WICED_FALSE;
+}
+
+static int telemetry_digits( uint16_t value )
+{
+    int digits = 1;
+
+    while ( value >= 10 )
+    {
+        value = (uint16_t) ( value / 10 );
+        digits++;
+    }
+
+    return digits;
+}
+
+static int telemetry_metrics_pending( const parse_telemetry_t* telemetry )
+{
+    int pending = 0;
+    int metric;
+
+    for ( metric = 0; metric < telemetry->metric_count; metric++ )
+    {
+        pending += ( telemetry->metrics[ metric ].count > 0 );
+    }
+
+    return pending;
+}
+
+#endif /* PARSE_ENABLE_TELEMETRY */
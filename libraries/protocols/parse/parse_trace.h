@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include "parse_trace_events.h"
+#ifdef PARSE_ENABLE_TRACE
+#include "binary_trace.h"
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* PARSE_TRACE( event, up to three arguments ) records an event from parse_trace_events.h.
+ * Nothing is compiled unless PARSE_ENABLE_TRACE is defined, and events above
+ * PARSE_TRACE_LEVEL are removed at compile time, arguments included. */
+#ifdef PARSE_ENABLE_TRACE
+#define PARSE_TRACE( ... )  PARSE_TRACE_ARGS( __VA_ARGS__, 0, 0, 0, 0 )
+#define PARSE_TRACE_ARGS( event, arg0, arg1, arg2, ... ) \
+    do \
+    { \
+        if ( event##_LEVEL <= PARSE_TRACE_LEVEL ) \
+        { \
+            binary_trace_write( &parse_trace, event, (uint32_t) ( arg0 ), (uint32_t) ( arg1 ), (uint32_t) ( arg2 ) ); \
+        } \
+    } while ( 0 )
+#else
+#define PARSE_TRACE( ... )
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define PARSE_TRACE_LEVEL_ERROR     ( 1 )
+#define PARSE_TRACE_LEVEL_WARNING   ( 2 )
+#define PARSE_TRACE_LEVEL_INFO      ( 3 )
+#define PARSE_TRACE_LEVEL_DEBUG     ( 4 )
+
+#ifndef PARSE_TRACE_LEVEL
+#define PARSE_TRACE_LEVEL           PARSE_TRACE_LEVEL_INFO
+#endif
+
+/* Records kept, a power of two */
+#ifndef PARSE_TRACE_RECORDS
+#define PARSE_TRACE_RECORDS         ( 64 )
+#endif
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+#define PARSE_TRACE_EVENT_ID( id, level, format )     id,
+#define PARSE_TRACE_EVENT_LEVEL( id, level, format )  id##_LEVEL = level,
+
+typedef enum
+{
+    PARSE_TRACE_EVENTS( PARSE_TRACE_EVENT_ID )
+    PARSE_TRACE_EVENT_COUNT
+} parse_trace_event_t;
+
+enum
+{
+    PARSE_TRACE_EVENTS( PARSE_TRACE_EVENT_LEVEL )
+};
+
+#undef PARSE_TRACE_EVENT_ID
+#undef PARSE_TRACE_EVENT_LEVEL
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+#ifdef PARSE_ENABLE_TRACE
+extern binary_trace_t parse_trace;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* Trace events of the Parse library
+ *
+ * EVENT( id, level, format ): ids are numbered in the order of this table.
+ * The format is applied to the three arguments by
+ * tools/binary_trace/binary_trace_decode.py, which reads this file, so only
+ * append new events to keep old traces readable. Arguments are 32-bit, the
+ * format may use %u, %d, %x and %%.
+ */
+
+#define PARSE_TRACE_EVENTS( EVENT ) \
+    EVENT( PARSE_TRACE_REQUEST_START,     PARSE_TRACE_LEVEL_INFO,    "request start, %u bytes" ) \
+    EVENT( PARSE_TRACE_DNS_FAILED,        PARSE_TRACE_LEVEL_ERROR,   "DNS lookup failed, result %d, port %u" ) \
+    EVENT( PARSE_TRACE_CONNECT_FAILED,    PARSE_TRACE_LEVEL_ERROR,   "connect failed, result %d, port %u" ) \
+    EVENT( PARSE_TRACE_TLS_FAILED,        PARSE_TRACE_LEVEL_ERROR,   "TLS handshake failed, result %d" ) \
+    EVENT( PARSE_TRACE_REQUEST_SENT,      PARSE_TRACE_LEVEL_DEBUG,   "request sent, %u bytes, result %d" ) \
+    EVENT( PARSE_TRACE_RESPONSE_PACKET,   PARSE_TRACE_LEVEL_DEBUG,   "response packet, %u bytes, HTTP status %d" ) \
+    EVENT( PARSE_TRACE_REQUEST_DONE,      PARSE_TRACE_LEVEL_INFO,    "request done, result %d" ) \
+    EVENT( PARSE_TRACE_PUSH_CONNECTED,    PARSE_TRACE_LEVEL_INFO,    "push connected to %x port %u" ) \
+    EVENT( PARSE_TRACE_PUSH_SEND,         PARSE_TRACE_LEVEL_DEBUG,   "push send, %u bytes, result %d" ) \
+    EVENT( PARSE_TRACE_PUSH_RECEIVED,     PARSE_TRACE_LEVEL_INFO,    "push received, %u bytes" ) \
+    EVENT( PARSE_TRACE_KEEPALIVE,         PARSE_TRACE_LEVEL_DEBUG,   "keep-alive" ) \
+    EVENT( PARSE_TRACE_KEEPALIVE_FAILED,  PARSE_TRACE_LEVEL_WARNING, "keep-alive failed, step %u, result %d" ) \
+    EVENT( PARSE_TRACE_PUSH_DISCONNECTED, PARSE_TRACE_LEVEL_INFO,    "push disconnected, result %d" ) \
+    EVENT( PARSE_TRACE_QUERY_CONNECT,     PARSE_TRACE_LEVEL_INFO,    "query connect, result %d" ) \
+    EVENT( PARSE_TRACE_QUERY_PAGE,        PARSE_TRACE_LEVEL_DEBUG,   "query page, %u objects, %u bytes, HTTP status %d" )
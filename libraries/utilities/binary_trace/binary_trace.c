@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Binary trace ring buffer
+ *
+ * A writer claims a slot by incrementing head, clears the slot's sequence,
+ * fills in the record and sets the sequence last. A reader trusts a record
+ * only if its sequence matches the slot's expected index before and after
+ * copying it, like a sequence lock per slot.
+ */
+
+#include "binary_trace.h"
+#include "wiced.h"
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* The timestamp source and its tick length can be replaced, e.g. with a cycle counter */
+#ifndef BINARY_TRACE_TIMESTAMP
+#define BINARY_TRACE_TIMESTAMP( )    binary_trace_time_ms( )
+#define BINARY_TRACE_TIMESTAMP_NS    ( 1000000 )
+#define BINARY_TRACE_USE_WICED_TIME
+#endif
+
+#define SEQUENCE( index )            ( (uint16_t) ( ( ( index ) & 0x7FFF ) | 0x8000 ) )
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+#ifdef BINARY_TRACE_USE_WICED_TIME
+static uint32_t binary_trace_time_ms( void );
+#endif
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+void binary_trace_write( binary_trace_t* trace, uint16_t id, uint32_t arg0, uint32_t arg1, uint32_t arg2 )
+{
+    uint32_t               index  = __atomic_fetch_add( &trace->head, 1, __ATOMIC_RELAXED );
+    binary_trace_record_t* record = &trace->records[ index & trace->mask ];
+
+    __atomic_store_n( &record->sequence, 0, __ATOMIC_RELAXED );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+
+    record->timestamp = BINARY_TRACE_TIMESTAMP( );
+    record->id        = id;
+    record->args[ 0 ] = arg0;
+    record->args[ 1 ] = arg1;
+    record->args[ 2 ] = arg2;
+
+    __atomic_store_n( &record->sequence, SEQUENCE( index ), __ATOMIC_RELEASE );
+}
+
+uint32_t binary_trace_dump( binary_trace_t* trace, binary_trace_output_t output, void* context )
+{
+    binary_trace_header_t header;
+    uint32_t              head = __atomic_load_n( &trace->head, __ATOMIC_ACQUIRE );
+    uint32_t              index;
+
+    header.magic        = BINARY_TRACE_MAGIC;
+    header.version      = BINARY_TRACE_VERSION;
+    header.record_size  = sizeof( binary_trace_record_t );
+    header.written      = head;
+    header.count        = ( head > trace->mask ) ? trace->mask + 1 : head;
+    header.timestamp_ns = BINARY_TRACE_TIMESTAMP_NS;
+    output( context, &header, sizeof( header ) );
+
+    for ( index = head - header.count; index != head; ++index )
+    {
+        const binary_trace_record_t* slot = &trace->records[ index & trace->mask ];
+        binary_trace_record_t        record;
+        uint16_t                     sequence = __atomic_load_n( &slot->sequence, __ATOMIC_ACQUIRE );
+
+        record = *slot;
+        __atomic_thread_fence( __ATOMIC_ACQUIRE );
+
+        if ( sequence != SEQUENCE( index ) || __atomic_load_n( &slot->sequence, __ATOMIC_RELAXED ) != sequence )
+        {
+            record.id = BINARY_TRACE_INVALID_ID;
+        }
+        record.sequence = sequence;
+
+        output( context, &record, sizeof( record ) );
+    }
+
+    return header.count;
+}
+
+void binary_trace_reset( binary_trace_t* trace )
+{
+    uint32_t index;
+
+    for ( index = 0; index <= trace->mask; ++index )
+    {
+        trace->records[ index ].sequence = 0;
+    }
+    __atomic_store_n( &trace->head, 0, __ATOMIC_RELEASE );
+}
+
+void binary_trace_print_hex( void* context, const void* data, uint32_t length )
+{
+    static const char hex[ ] = "0123456789abcdef";
+    const uint8_t*    bytes  = (const uint8_t*) data;
+    char              line[ 2 * sizeof( binary_trace_record_t ) + 1 ];
+    uint32_t          a;
+
+    UNUSED_PARAMETER( context );
+
+    /* Every piece is a header or a record, both fit on one line */
+    for ( a = 0; a < length && a < sizeof( binary_trace_record_t ); ++a )
+    {
+        line[ 2 * a ]     = hex[ bytes[ a ] >> 4 ];
+        line[ 2 * a + 1 ] = hex[ bytes[ a ] & 0x0F ];
+    }
+    line[ 2 * a ] = 0;
+
+    WPRINT_APP_INFO( ("trace %s\r\n", line) );
+}
+
+#ifdef BINARY_TRACE_USE_WICED_TIME
+static uint32_t binary_trace_time_ms( void )
+{
+    wiced_time_t now;
+
+    wiced_time_get_time( &now );
+
+    return (uint32_t) now;
+}
+#endif
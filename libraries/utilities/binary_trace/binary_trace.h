@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "wiced_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file
+ *
+ * Binary trace ring buffer
+ *
+ * Events are fixed size records of an id, a timestamp and three 32-bit
+ * arguments, written into a ring without locks or formatting. Writing is a
+ * handful of stores, so it can be left in hot paths and in interrupts. The
+ * ring is dumped as binary, or as hex lines on a console, and formatted off
+ * the target by tools/binary_trace/binary_trace_decode.py.
+ */
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* Defines a trace ring called name with count records, count must be a power of two */
+#define BINARY_TRACE_DEFINE( name, count ) \
+    typedef char name##_count_must_be_a_power_of_two[ ( ( (count) & ( (count) - 1 ) ) == 0 && (count) > 0 ) ? 1 : -1 ]; \
+    static binary_trace_record_t name##_records[ (count) ]; \
+    binary_trace_t name = { name##_records, (count) - 1, 0 }
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define BINARY_TRACE_MAGIC         ( 0x43525442 )  /* "BTRC" in memory */
+#define BINARY_TRACE_VERSION       ( 1 )
+
+/* Id given to records that were overwritten while being dumped */
+#define BINARY_TRACE_INVALID_ID    ( 0xFFFF )
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/* Receives the dump in pieces: the header, then one record at a time */
+typedef void (*binary_trace_output_t)( void* context, const void* data, uint32_t length );
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    uint32_t timestamp;
+    uint16_t id;
+    uint16_t sequence;      /* Low bits of the record's index with the top bit set, 0 while it is written */
+    uint32_t args[ 3 ];
+} binary_trace_record_t;
+
+typedef struct
+{
+    binary_trace_record_t* records;
+    uint32_t               mask;    /* Number of records - 1 */
+    uint32_t               head;    /* Records written since the start */
+} binary_trace_t;
+
+/* Start of a dump, followed by count records from the oldest to the newest, all little endian */
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t written;       /* Records written since the start, more than count if the ring wrapped */
+    uint32_t count;
+    uint32_t timestamp_ns;  /* Length of one timestamp tick */
+} binary_trace_header_t;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Adds an event to the ring, overwriting the oldest one when it is full.
+ * Safe to call from several threads and from interrupts.
+ *
+ * @param[in] trace : The ring
+ * @param[in] id    : Event id
+ * @param[in] arg0  : First argument
+ * @param[in] arg1  : Second argument
+ * @param[in] arg2  : Third argument
+ */
+void binary_trace_write( binary_trace_t* trace, uint16_t id, uint32_t arg0, uint32_t arg1, uint32_t arg2 );
+
+/**
+ * Writes the header and the records in the ring to an output. Events may be
+ * written meanwhile; records overwritten during the dump get the id
+ * BINARY_TRACE_INVALID_ID.
+ *
+ * @param[in] trace   : The ring
+ * @param[in] output  : Receives the dump
+ * @param[in] context : Passed to output
+ *
+ * @return The number of records dumped
+ */
+uint32_t binary_trace_dump( binary_trace_t* trace, binary_trace_output_t output, void* context );
+
+/**
+ * Empties the ring. Must not run at the same time as binary_trace_write().
+ *
+ * @param[in] trace : The ring
+ */
+void binary_trace_reset( binary_trace_t* trace );
+
+/**
+ * Output for binary_trace_dump() that prints one line of hex per piece,
+ * prefixed with "trace ", for capture from a console.
+ */
+void binary_trace_print_hex( void* context, const void* data, uint32_t length );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -1,314 +1,919 @@
-/*
- *  Copyright (c) 2015, Parse, LLC. All rights reserved.
- *
- *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
- *  copy, modify, and distribute this software in source code or binary form for use
- *  in connection with the web services and APIs provided by Parse.
- *
- *  As with any software that integrates with the Parse platform, your use of
- *  this software is subject to the Parse Terms of Service
- *  [https://www.parse.com/about/terms]. This copyright notice shall be
- *  included in all copies or substantial portions of the software.
- *
- *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
- *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
- *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
- *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
- *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- *
- */
-
-#include "simplejson.h"
-#include <stddef.h>
-#include <stdlib.h>
-#include <string.h>
-
-// Helper functions
-static const char *findJsonBeginning( const char* data );
-static const char *findJsonBeginningParams( const char* data, size_t size, int *inString, int *pos );
-static const char *findJsonEnd( const char* data );
-static const char *findJsonEndParams( const char* data, size_t size, int *inString, int *level, int *pos );
-
-int simpleJsonProcessor( const char *data, const char *key, char* value, int size )
-{
-    const char* found = NULL;
-    int inString = 0;
-    int json = 0;
-    int backslash = 0;
-    int endWithQuote = 1;
-    int keyLen = strlen( key );
-    int jsonLevel = 0;
-    if ( !data || !key || ! *key )
-        return 0;
-    for ( found = data; *found; ++found )
-    {
-        if ( strncmp( found, key, keyLen ) )
-        {
-            switch ( *found )
-            {
-                case '\"':
-                    inString = 1 - inString;
-                    break;
-                case '\\':
-                    if ( inString )
-                    {
-                        if ( *( found + 1 ) )
-                            ++found;
-                    }
-                    break;
-                case '{':
-                case '[': // treat array as JSON
-                    if ( !inString )
-                    {
-                        ++jsonLevel;
-                    }
-                    break;
-                case '}':
-                case ']':
-                    if ( !inString )
-                    {
-                        --jsonLevel;
-                        if ( jsonLevel < 0 )
-                        {
-                            // Quit on malformed json
-                            return 0;
-                        }
-                    }
-                    break;
-            }
-            continue;
-        }
-        else if ( jsonLevel > 1 )
-        {
-            continue;
-        }
-        found += keyLen;
-        if ( *found != '\"' )
-        {
-            data = found;
-            continue;
-        }
-        else
-        {
-            ++found;
-            for ( ; *found == ' ' || *found == '\t'; ++found )
-                ;
-            if ( *found != ':' )
-            {
-                data = found;
-                continue;
-            }
-            ++found;
-            for ( ; *found == ' ' || *found == '\t'; ++found )
-                ;
-            if ( *found == '{' || *found == '[' )
-            {
-                json = 1;
-                endWithQuote = 0;
-            }
-            else
-            {
-                if ( *found != '\"' )
-                    endWithQuote = 0;
-            }
-            break;
-        }
-    }
-
-    if ( ! *found )
-        return 0;
-
-    if ( !value )
-        return 1;
-
-    if ( endWithQuote )
-        ++found;
-    inString = !json;
-    jsonLevel = 0;
-
-    for ( ; size > 1 && *found; --size, ++found, ++value )
-    {
-        if ( backslash )
-        {
-            backslash = 0;
-            *value = *found;
-            continue;
-        }
-        switch ( *found )
-        {
-            case '{':
-            case '[':
-                if ( !inString )
-                    ++jsonLevel;
-                break;
-            case '}':
-            case ']':
-                if ( !endWithQuote )
-                {
-                    if ( !inString )
-                    {
-                        if ( jsonLevel )
-                        {
-                            --jsonLevel;
-                            if ( jsonLevel < 0 )
-                            {
-                                // Quit on malformed json
-                                return 0;
-                            }
-                        }
-                        if ( !jsonLevel )
-                        {
-                            if ( json )
-                            {
-                                *value = *found;
-                                ++value;
-                            }
-                            goto RETURN_VALUE;
-                        }
-                        break;
-                    }
-                    // Fall through
-                }
-                else
-                {
-                    // Fall through
-                }
-            case '\"':
-            case ',':
-                if ( endWithQuote && *found != '\"' )
-                    break;
-
-                if ( *found == '\"' )
-                    inString = 1 - inString;
-                if ( !json )
-                    goto RETURN_VALUE;
-                break;
-            case '\\':
-                backslash = 1;
-                break;
-        }
-        *value = *found;
-    }
-    RETURN_VALUE: *value = 0;
-    if ( ! *found ) // malformed JSON
-        return 0;
-    return 1;
-}
-
-static const char *findJsonBeginning( const char* data )
-{
-    int inString = 0;
-    int pos = 0;
-    return findJsonBeginningParams( data, strlen( data ), &inString, &pos );
-}
-
-static const char *findJsonBeginningParams( const char* data, size_t size, int *inString, int *pos )
-{
-    for ( ; *data && *pos < size; ++data, ++( *pos ) )
-    {
-        switch ( *data )
-        {
-            case '{':
-                if ( ! *inString )
-                    return data;
-                break;
-            case '\"':
-                *inString = 1 - *inString;
-                break;
-            case '\\':
-                if ( *inString && *( data + 1 ) )
-                {
-                    ++( *pos );
-                    ++data;
-                }
-                break;
-        }
-    }
-    return NULL;
-}
-
-static const char *findJsonEnd( const char* data )
-{
-    int inString = 0;
-    int level = 0;
-    int pos = 0;
-    return findJsonEndParams( data, strlen( data ), &inString, &level, &pos );
-}
-
-static const char *findJsonEndParams( const char* data, size_t size, int *inString, int *level, int *pos )
-{
-    for ( ; *data && *pos < size; ++data, ++( *pos ) )
-    {
-        switch ( *data )
-        {
-            case '{':
-                if ( ! *inString )
-                    ++( *level );
-                break;
-            case '}':
-                if ( ! *inString )
-                    --( *level );
-                if ( ! *level )
-                    return data + 1;
-                break;
-            case '\"':
-                *inString = 1 - *inString;
-                break;
-            case '\\':
-                if ( *inString && *( data + 1 ) )
-                {
-                    ++( *pos );
-                    ++data;
-                }
-                break;
-        }
-    }
-    return NULL;
-}
-
-const char* findSecondJson( const char *data )
-{
-    data = findJsonBeginning( data );
-    if ( !data )
-        return NULL;
-    data = findJsonEnd( data );
-    if ( !data )
-        return NULL;
-    return findJsonBeginning( data );
-}
-
-int isCompleteJson( const char *data )
-{
-    data = findJsonBeginning( data );
-    if ( !data )
-        return 0;
-    return ( findJsonEnd( data ) != NULL );
-}
-
-const char *getPushJson( const char *data, size_t dataSize, int *start, int *length )
-{
-    int inString = 0;
-    int pos = 0;
-    const char *beginning = findJsonBeginningParams( data, dataSize, &inString, &pos );
-    if ( !beginning )
-    {
-        *start = -1;
-        *length = -1;
-        return NULL;
-    }
-
-    inString = 0;
-    int endPos = 0;
-    int level = 0;
-    const char *end;
-
-    end = findJsonEndParams( data + pos, dataSize - pos, &inString, &level, &endPos );
-
-    *start = pos;
-    if ( end )
-        *length = endPos + 1;
-    else
-        *length = -1;
-    return data + pos;
-}
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "simplejson.h"
+#include "simplejson_scan.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Helper functions
+static const char *findJsonBeginning( const char* data );
+static const char *findJsonBeginningParams( const char* data, size_t size, int *inString, int *pos );
+static const char *findJsonEnd( const char* data );
+static const char *findJsonEndParams( const char* data, size_t size, int *inString, int *level, int *pos );
+static size_t skipWhitespace( const char* data, size_t size, size_t pos );
+static size_t scanString( const char* data, size_t size, size_t pos );
+static size_t scanContainer( const char* data, size_t size, size_t pos );
+static size_t scanPrimitive( const char* data, size_t size, size_t pos );
+static size_t scanValue( const char* data, size_t size, size_t pos, simple_json_value_t *value );
+static int nextMember( const char* data, size_t size, size_t *offset, simple_json_value_t *key, simple_json_value_t *value );
+static void copyValue( const simple_json_value_t *value, char *buffer, int size );
+static int newToken( simple_json_token_t *tokens, unsigned int maxTokens, int *count, simple_json_type_t type, size_t start, size_t end );
+static size_t findMember( const char* data, size_t size, size_t pos, const char *name, size_t nameLength );
+static size_t findElement( const char* data, size_t size, size_t pos, unsigned long index );
+static size_t scanDigits( const char *data, size_t size, size_t pos, uint64_t *digits, int *count );
+static uint32_t keyHash( const simple_json_key_table_t *table, const char *key, size_t length );
+
+int simpleJsonProcessor( const char *data, const char *key, char* value, int size )
+{
+    simple_json_value_t name;
+    simple_json_value_t found;
+    size_t dataSize;
+    size_t pos;
+    size_t offset = 0;
+
+    if ( !data || !key || ! *key )
+        return 0;
+
+    // The object does not need to be complete, the members are read one at a
+    // time until the key is found
+    dataSize = strlen( data );
+    pos = skipWhitespace( data, dataSize, 0 );
+    if ( pos >= dataSize || data[ pos ] != '{' )
+        return 0;
+    data += pos;
+    dataSize -= pos;
+
+    while ( nextMember( data, dataSize, &offset, &name, &found ) )
+    {
+        if ( simpleJsonValueEquals( &name, key ) )
+        {
+            if ( value )
+                copyValue( &found, value, size );
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static const char *findJsonBeginning( const char* data )
+{
+    int inString = 0;
+    int pos = 0;
+    return findJsonBeginningParams( data, strlen( data ), &inString, &pos );
+}
+
+static const char *findJsonBeginningParams( const char* data, size_t size, int *inString, int *pos )
+{
+    for ( ; *pos < size && *data; ++data, ++( *pos ) )
+    {
+        // Jump over everything that cannot change the state
+        size_t skip = ( *inString ? simpleJsonFindStringSpecial( data, size - *pos, 0 ) : simpleJsonFindStructural( data, size - *pos, 0 ) );
+        data += skip;
+        *pos += skip;
+        if ( *pos >= size || ! *data )
+            break;
+
+        switch ( *data )
+        {
+            case '{':
+                if ( ! *inString )
+                    return data;
+                break;
+            case '\"':
+                *inString = 1 - *inString;
+                break;
+            case '\\':
+                if ( *inString && *( data + 1 ) )
+                {
+                    ++( *pos );
+                    ++data;
+                }
+                break;
+        }
+    }
+    return NULL;
+}
+
+static const char *findJsonEnd( const char* data )
+{
+    int inString = 0;
+    int level = 0;
+    int pos = 0;
+    return findJsonEndParams( data, strlen( data ), &inString, &level, &pos );
+}
+
+static const char *findJsonEndParams( const char* data, size_t size, int *inString, int *level, int *pos )
+{
+    for ( ; *pos < size && *data; ++data, ++( *pos ) )
+    {
+        // Jump over everything that cannot change the state
+        size_t skip = ( *inString ? simpleJsonFindStringSpecial( data, size - *pos, 0 ) : simpleJsonFindStructural( data, size - *pos, 0 ) );
+        data += skip;
+        *pos += skip;
+        if ( *pos >= size || ! *data )
+            break;
+
+        switch ( *data )
+        {
+            case '{':
+                if ( ! *inString )
+                    ++( *level );
+                break;
+            case '}':
+                if ( ! *inString )
+                    --( *level );
+                if ( ! *level )
+                    return data + 1;
+                break;
+            case '\"':
+                *inString = 1 - *inString;
+                break;
+            case '\\':
+                if ( *inString && *( data + 1 ) )
+                {
+                    ++( *pos );
+                    ++data;
+                }
+                break;
+        }
+    }
+    return NULL;
+}
+
+const char* findSecondJson( const char *data )
+{
+    data = findJsonBeginning( data );
+    if ( !data )
+        return NULL;
+    data = findJsonEnd( data );
+    if ( !data )
+        return NULL;
+    return findJsonBeginning( data );
+}
+
+int isCompleteJson( const char *data )
+{
+    data = findJsonBeginning( data );
+    if ( !data )
+        return 0;
+    return ( findJsonEnd( data ) != NULL );
+}
+
+const char *getPushJson( const char *data, size_t dataSize, int *start, int *length )
+{
+    int inString = 0;
+    int pos = 0;
+    const char *beginning = findJsonBeginningParams( data, dataSize, &inString, &pos );
+    if ( !beginning )
+    {
+        *start = -1;
+        *length = -1;
+        return NULL;
+    }
+
+    inString = 0;
+    int endPos = 0;
+    int level = 0;
+    const char *end;
+
+    end = findJsonEndParams( data + pos, dataSize - pos, &inString, &level, &endPos );
+
+    *start = pos;
+    if ( end )
+        *length = endPos + 1;
+    else
+        *length = -1;
+    return data + pos;
+}
+
+static size_t skipWhitespace( const char* data, size_t size, size_t pos )
+{
+    for ( ; pos < size; ++pos )
+    {
+        switch ( data[ pos ] )
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+            default:
+                return pos;
+        }
+    }
+    return pos;
+}
+
+// pos is on the opening quote, returns the position after the closing quote or 0
+static size_t scanString( const char* data, size_t size, size_t pos )
+{
+    for ( ++pos; pos < size; ++pos )
+    {
+        pos = simpleJsonFindStringSpecial( data, size, pos );
+        if ( pos >= size || !data[ pos ] )
+            return 0;
+        if ( data[ pos ] == '\"' )
+            return pos + 1;
+        // Skip the escaped character
+        ++pos;
+    }
+    return 0;
+}
+
+// pos is on the opening brace/bracket, returns the position after the matching one or 0
+static size_t scanContainer( const char* data, size_t size, size_t pos )
+{
+    int level = 0;
+    for ( ; pos < size; ++pos )
+    {
+        pos = simpleJsonFindStructural( data, size, pos );
+        if ( pos >= size || !data[ pos ] )
+            return 0;
+        switch ( data[ pos ] )
+        {
+            case '{':
+            case '[':
+                ++level;
+                break;
+            case '}':
+            case ']':
+                if ( --level == 0 )
+                    return pos + 1;
+                break;
+            case '\"':
+                pos = scanString( data, size, pos );
+                if ( !pos )
+                    return 0;
+                --pos;
+                break;
+        }
+    }
+    return 0;
+}
+
+static size_t scanPrimitive( const char* data, size_t size, size_t pos )
+{
+    size_t start = pos;
+    for ( ; pos < size && data[ pos ]; ++pos )
+    {
+        switch ( data[ pos ] )
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+            case ',':
+            case ':':
+            case '}':
+            case ']':
+                return pos;
+            case '{':
+            case '[':
+            case '\"':
+                return 0;
+        }
+    }
+    return ( pos > start ) ? pos : 0;
+}
+
+// returns the position after the value or 0 if it is malformed or incomplete
+static size_t scanValue( const char* data, size_t size, size_t pos, simple_json_value_t *value )
+{
+    size_t end;
+
+    pos = skipWhitespace( data, size, pos );
+    if ( pos >= size )
+        return 0;
+
+    switch ( data[ pos ] )
+    {
+        case '{':
+        case '[':
+            end = scanContainer( data, size, pos );
+            if ( !end )
+                return 0;
+            value->type = ( data[ pos ] == '{' ) ? SIMPLE_JSON_OBJECT : SIMPLE_JSON_ARRAY;
+            value->data = data + pos;
+            value->length = end - pos;
+            return end;
+        case '\"':
+            end = scanString( data, size, pos );
+            if ( !end )
+                return 0;
+            value->type = SIMPLE_JSON_STRING;
+            value->data = data + pos + 1;
+            value->length = end - pos - 2;
+            return end;
+        case '}':
+        case ']':
+        case ',':
+        case ':':
+            return 0;
+        default:
+            end = scanPrimitive( data, size, pos );
+            if ( !end )
+                return 0;
+            value->type = SIMPLE_JSON_PRIMITIVE;
+            value->data = data + pos;
+            value->length = end - pos;
+            return end;
+    }
+}
+
+size_t simpleJsonGetValue( const char *data, size_t dataSize, simple_json_value_t *value )
+{
+    if ( !data || !value )
+        return 0;
+    value->type = SIMPLE_JSON_UNDEFINED;
+    return scanValue( data, dataSize, 0, value );
+}
+
+int simpleJsonNextMember( const simple_json_value_t *object, size_t *offset, simple_json_value_t *key, simple_json_value_t *value )
+{
+    if ( !object || object->type != SIMPLE_JSON_OBJECT || !offset )
+        return 0;
+
+    // The closing brace is never part of a member
+    return nextMember( object->data, object->length - 1, offset, key, value );
+}
+
+int simpleJsonBeginObject( const char *data, size_t dataSize, simple_json_value_t *object )
+{
+    size_t pos;
+
+    if ( !data || !object )
+        return 0;
+
+    object->type = SIMPLE_JSON_UNDEFINED;
+    pos = skipWhitespace( data, dataSize, 0 );
+    if ( pos >= dataSize || data[ pos ] != '{' )
+        return 0;
+
+    // nextMember stops at the closing brace, which is the last byte of a document of one object
+    object->type = SIMPLE_JSON_OBJECT;
+    object->data = data + pos;
+    object->length = dataSize - pos;
+    return 1;
+}
+
+// data starts with the opening brace, the object does not need to be complete
+static int nextMember( const char* data, size_t size, size_t *offset, simple_json_value_t *key, simple_json_value_t *value )
+{
+    size_t pos = skipWhitespace( data, size, *offset ? *offset : 1 );
+
+    if ( *offset && pos < size && data[ pos ] == ',' )
+        pos = skipWhitespace( data, size, pos + 1 );
+    if ( pos >= size || data[ pos ] != '\"' )
+        return 0;
+
+    pos = scanValue( data, size, pos, key );
+    if ( !pos )
+        return 0;
+    pos = skipWhitespace( data, size, pos );
+    if ( pos >= size || data[ pos ] != ':' )
+        return 0;
+    pos = scanValue( data, size, pos + 1, value );
+    if ( !pos )
+        return 0;
+
+    *offset = pos;
+    return 1;
+}
+
+int simpleJsonNextElement( const simple_json_value_t *array, size_t *offset, simple_json_value_t *value )
+{
+    const char *data;
+    size_t size;
+    size_t pos;
+
+    if ( !array || array->type != SIMPLE_JSON_ARRAY || !offset )
+        return 0;
+
+    data = array->data;
+    size = array->length - 1;
+    pos = skipWhitespace( data, size, *offset ? *offset : 1 );
+    if ( *offset )
+    {
+        if ( pos >= size || data[ pos ] != ',' )
+            return 0;
+        ++pos;
+    }
+
+    pos = scanValue( data, size, pos, value );
+    if ( !pos )
+        return 0;
+
+    *offset = pos;
+    return 1;
+}
+
+int simpleJsonValueEquals( const simple_json_value_t *value, const char *string )
+{
+    size_t length;
+
+    if ( !value || !value->data || !string )
+        return 0;
+    length = strlen( string );
+    return ( value->length == length ) && !memcmp( value->data, string, length );
+}
+
+int simpleJsonKeyLookup( const simple_json_key_table_t *table, const char *key, size_t length )
+{
+    const simple_json_key_t *slot = &table->slots[ keyHash( table, key, length ) & table->mask ];
+
+    if ( slot->name && slot->length == length && !memcmp( slot->name, key, length ) )
+        return slot->id;
+    return -1;
+}
+
+int simpleJsonDispatch( const simple_json_value_t *object, const simple_json_key_table_t *table, simple_json_member_handler_t handler, void *context )
+{
+    simple_json_value_t key;
+    simple_json_value_t value;
+    size_t offset = 0;
+    int known = 0;
+
+    while ( simpleJsonNextMember( object, &offset, &key, &value ) )
+    {
+        int id = simpleJsonKeyLookup( table, key.data, key.length );
+        if ( id >= 0 )
+            ++known;
+        if ( handler( context, id, &key, &value ) )
+            break;
+    }
+    return known;
+}
+
+int simpleJsonGetInt64( const simple_json_value_t *value, int64_t *result )
+{
+    const char *data;
+    size_t      length;
+    size_t      pos;
+    uint64_t    magnitude = 0;
+    int         count     = 0;
+    int         negative;
+
+    if ( !value || value->type != SIMPLE_JSON_PRIMITIVE || !value->length )
+        return 0;
+    data = value->data;
+    length = value->length;
+    negative = ( data[ 0 ] == '-' );
+
+    pos = scanDigits( data, length, negative, &magnitude, &count );
+    if ( pos != length || !count || count > 19 )
+        return 0;
+    if ( magnitude > (uint64_t) INT64_MAX + negative )
+        return 0;
+
+    *result = negative ? (int64_t) ( 0 - magnitude ) : (int64_t) magnitude;
+    return 1;
+}
+
+int simpleJsonGetDouble( const simple_json_value_t *value, double *result )
+{
+    // Powers of ten that are exact in a double
+    static const double powers[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const char *data;
+    size_t      length;
+    size_t      pos;
+    uint64_t    mantissa = 0;
+    int         count    = 0;
+    int         exponent = 0;
+    int         negative;
+    double      number;
+
+    if ( !value || value->type != SIMPLE_JSON_PRIMITIVE || !value->length )
+        return 0;
+    data = value->data;
+    length = value->length;
+    negative = ( data[ 0 ] == '-' );
+
+    pos = scanDigits( data, length, negative, &mantissa, &count );
+    if ( !count )
+        return 0;
+    // Digits that do not fit in the mantissa only scale it
+    if ( count > 19 )
+        exponent += count - 19;
+
+    if ( pos < length && data[ pos ] == '.' )
+    {
+        int total = count;
+
+        pos = scanDigits( data, length, pos + 1, &mantissa, &total );
+        if ( total == count )
+            return 0;
+        // Only the fraction digits that made it into the mantissa scale it
+        exponent -= ( ( total < 19 ) ? total : 19 ) - ( ( count < 19 ) ? count : 19 );
+    }
+
+    if ( pos < length && ( data[ pos ] == 'e' || data[ pos ] == 'E' ) )
+    {
+        uint64_t explicitExponent = 0;
+        int      digits           = 0;
+        int      negativeExponent = 0;
+
+        ++pos;
+        if ( pos < length && ( data[ pos ] == '-' || data[ pos ] == '+' ) )
+            negativeExponent = ( data[ pos++ ] == '-' );
+        pos = scanDigits( data, length, pos, &explicitExponent, &digits );
+        if ( !digits )
+            return 0;
+        if ( explicitExponent > 10000 )
+            explicitExponent = 10000;
+        exponent += negativeExponent ? -(int) explicitExponent : (int) explicitExponent;
+    }
+
+    if ( pos != length )
+        return 0;
+
+    number = (double) mantissa;
+    for ( ; exponent > 22; exponent -= 22 )
+        number *= powers[ 22 ];
+    for ( ; exponent < -22; exponent += 22 )
+        number /= powers[ 22 ];
+    if ( exponent >= 0 )
+        number *= powers[ exponent ];
+    else
+        number /= powers[ -exponent ];
+
+    *result = negative ? -number : number;
+    return 1;
+}
+
+int simpleJsonGetBool( const simple_json_value_t *value, int *result )
+{
+    if ( !value || value->type != SIMPLE_JSON_PRIMITIVE )
+        return 0;
+    if ( value->length == 4 && !memcmp( value->data, "true", 4 ) )
+        *result = 1;
+    else if ( value->length == 5 && !memcmp( value->data, "false", 5 ) )
+        *result = 0;
+    else
+        return 0;
+    return 1;
+}
+
+int simpleJsonIsNull( const simple_json_value_t *value )
+{
+    return value && value->type == SIMPLE_JSON_PRIMITIVE && value->length == 4 && !memcmp( value->data, "null", 4 );
+}
+
+static void copyValue( const simple_json_value_t *value, char *buffer, int size )
+{
+    size_t length = value->length;
+
+    if ( size <= 0 )
+        return;
+    // Strings are decoded (and truncated on a character boundary), the ones
+    // that are not valid are copied as they are
+    if ( value->type == SIMPLE_JSON_STRING && simpleJsonDecodeString( value->data, length, buffer, size ) != SIMPLE_JSON_ERROR_INVALID )
+        return;
+    if ( length > (size_t) size - 1 )
+        length = size - 1;
+    memcpy( buffer, value->data, length );
+    buffer[ length ] = 0;
+}
+
+static int newToken( simple_json_token_t *tokens, unsigned int maxTokens, int *count, simple_json_type_t type, size_t start, size_t end )
+{
+    simple_json_token_t *token;
+
+    if ( (unsigned int) *count >= maxTokens || *count >= UINT16_MAX )
+        return -1;
+    token = &tokens[ *count ];
+    token->type = type;
+    token->size = 0;
+    token->next = (uint16_t) ( *count + 1 );
+    token->start = (uint32_t) start;
+    token->end = (uint32_t) end;
+    return ( *count )++;
+}
+
+int simpleJsonTokenize( const char *data, size_t dataSize, simple_json_token_t *tokens, unsigned int maxTokens )
+{
+    enum
+    {
+        EXPECT_VALUE,
+        EXPECT_VALUE_OR_CLOSE,
+        EXPECT_KEY,
+        EXPECT_KEY_OR_CLOSE,
+        EXPECT_COLON,
+        EXPECT_COMMA_OR_CLOSE
+    } expect = EXPECT_VALUE;
+    int count = 0;
+    int parent = -1;
+    int token;
+    size_t pos;
+    size_t end;
+
+    if ( !data || !tokens )
+        return SIMPLE_JSON_ERROR_INVALID;
+
+    for ( pos = 0; pos < dataSize && data[ pos ]; ++pos )
+    {
+        switch ( data[ pos ] )
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+
+            case '{':
+            case '[':
+                if ( expect != EXPECT_VALUE && expect != EXPECT_VALUE_OR_CLOSE )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                token = newToken( tokens, maxTokens, &count, data[ pos ] == '{' ? SIMPLE_JSON_OBJECT : SIMPLE_JSON_ARRAY, pos, pos );
+                if ( token < 0 )
+                    return SIMPLE_JSON_ERROR_NOMEM;
+                if ( parent >= 0 && tokens[ parent ].type == SIMPLE_JSON_ARRAY )
+                    ++tokens[ parent ].size;
+                // While a container is open, next holds its parent (+1)
+                tokens[ token ].next = (uint16_t) ( parent + 1 );
+                parent = token;
+                expect = ( data[ pos ] == '{' ) ? EXPECT_KEY_OR_CLOSE : EXPECT_VALUE_OR_CLOSE;
+                break;
+
+            case '}':
+            case ']':
+                if ( parent < 0 || tokens[ parent ].type != ( data[ pos ] == '}' ? SIMPLE_JSON_OBJECT : SIMPLE_JSON_ARRAY ) )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                if ( expect != EXPECT_COMMA_OR_CLOSE && expect != EXPECT_KEY_OR_CLOSE && expect != EXPECT_VALUE_OR_CLOSE )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                tokens[ parent ].end = (uint32_t) ( pos + 1 );
+                token = parent;
+                parent = (int) tokens[ token ].next - 1;
+                tokens[ token ].next = (uint16_t) count;
+                if ( parent < 0 )
+                    return count;
+                expect = EXPECT_COMMA_OR_CLOSE;
+                break;
+
+            case '\"':
+                end = scanString( data, dataSize, pos );
+                if ( !end )
+                    return SIMPLE_JSON_ERROR_PARTIAL;
+                if ( expect == EXPECT_KEY || expect == EXPECT_KEY_OR_CLOSE )
+                {
+                    if ( newToken( tokens, maxTokens, &count, SIMPLE_JSON_STRING, pos + 1, end - 1 ) < 0 )
+                        return SIMPLE_JSON_ERROR_NOMEM;
+                    ++tokens[ parent ].size;
+                    expect = EXPECT_COLON;
+                }
+                else if ( expect == EXPECT_VALUE || expect == EXPECT_VALUE_OR_CLOSE )
+                {
+                    if ( newToken( tokens, maxTokens, &count, SIMPLE_JSON_STRING, pos + 1, end - 1 ) < 0 )
+                        return SIMPLE_JSON_ERROR_NOMEM;
+                    if ( parent < 0 )
+                        return count;
+                    if ( tokens[ parent ].type == SIMPLE_JSON_ARRAY )
+                        ++tokens[ parent ].size;
+                    expect = EXPECT_COMMA_OR_CLOSE;
+                }
+                else
+                {
+                    return SIMPLE_JSON_ERROR_INVALID;
+                }
+                pos = end - 1;
+                break;
+
+            case ':':
+                if ( expect != EXPECT_COLON )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                expect = EXPECT_VALUE;
+                break;
+
+            case ',':
+                if ( expect != EXPECT_COMMA_OR_CLOSE )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                expect = ( tokens[ parent ].type == SIMPLE_JSON_OBJECT ) ? EXPECT_KEY : EXPECT_VALUE;
+                break;
+
+            default:
+                if ( expect != EXPECT_VALUE && expect != EXPECT_VALUE_OR_CLOSE )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                end = scanPrimitive( data, dataSize, pos );
+                if ( !end )
+                    return SIMPLE_JSON_ERROR_INVALID;
+                // A primitive at the end of the buffer may be cut short
+                if ( ( end >= dataSize || !data[ end ] ) && parent >= 0 )
+                    return SIMPLE_JSON_ERROR_PARTIAL;
+                if ( newToken( tokens, maxTokens, &count, SIMPLE_JSON_PRIMITIVE, pos, end ) < 0 )
+                    return SIMPLE_JSON_ERROR_NOMEM;
+                if ( parent < 0 )
+                    return count;
+                if ( tokens[ parent ].type == SIMPLE_JSON_ARRAY )
+                    ++tokens[ parent ].size;
+                expect = EXPECT_COMMA_OR_CLOSE;
+                pos = end - 1;
+                break;
+        }
+    }
+
+    return SIMPLE_JSON_ERROR_PARTIAL;
+}
+
+int simpleJsonTokenFind( const char *data, const simple_json_token_t *tokens, int object, const char *key )
+{
+    size_t keyLength;
+    unsigned int member;
+    int token;
+
+    if ( object < 0 || tokens[ object ].type != SIMPLE_JSON_OBJECT || !key )
+        return -1;
+
+    keyLength = strlen( key );
+    token = object + 1;
+    for ( member = 0; member < tokens[ object ].size; ++member )
+    {
+        const simple_json_token_t *name = &tokens[ token ];
+        if ( name->end - name->start == keyLength && !memcmp( data + name->start, key, keyLength ) )
+            return token + 1;
+        // Skip the whole value subtree
+        token = tokens[ token + 1 ].next;
+    }
+    return -1;
+}
+
+int simpleJsonTokenElement( const simple_json_token_t *tokens, int array, unsigned int index )
+{
+    int token;
+
+    if ( array < 0 || tokens[ array ].type != SIMPLE_JSON_ARRAY || index >= tokens[ array ].size )
+        return -1;
+
+    token = array + 1;
+    while ( index-- )
+        token = tokens[ token ].next;
+    return token;
+}
+
+int simpleJsonTokenValue( const char *data, const simple_json_token_t *tokens, int token, simple_json_value_t *value )
+{
+    if ( token < 0 || !value )
+        return 0;
+
+    value->type = (simple_json_type_t) tokens[ token ].type;
+    value->data = data + tokens[ token ].start;
+    value->length = tokens[ token ].end - tokens[ token ].start;
+    return 1;
+}
+
+int simpleJsonTokenCopy( const char *data, const simple_json_token_t *tokens, int token, char *value, int size )
+{
+    simple_json_value_t view;
+
+    if ( !simpleJsonTokenValue( data, tokens, token, &view ) )
+        return 0;
+    copyValue( &view, value, size );
+    return 1;
+}
+
+// pos is on the opening brace, returns the position of the member value or 0
+static size_t findMember( const char* data, size_t size, size_t pos, const char *name, size_t nameLength )
+{
+    simple_json_value_t skipped;
+    size_t end;
+
+    pos = skipWhitespace( data, size, pos + 1 );
+    while ( pos < size && data[ pos ] == '\"' )
+    {
+        end = scanString( data, size, pos );
+        if ( !end )
+            return 0;
+        if ( end - pos - 2 == nameLength && !memcmp( data + pos + 1, name, nameLength ) )
+        {
+            pos = skipWhitespace( data, size, end );
+            if ( pos >= size || data[ pos ] != ':' )
+                return 0;
+            return skipWhitespace( data, size, pos + 1 );
+        }
+        pos = skipWhitespace( data, size, end );
+        if ( pos >= size || data[ pos ] != ':' )
+            return 0;
+        pos = scanValue( data, size, pos + 1, &skipped );
+        if ( !pos )
+            return 0;
+        pos = skipWhitespace( data, size, pos );
+        if ( pos >= size || data[ pos ] != ',' )
+            return 0;
+        pos = skipWhitespace( data, size, pos + 1 );
+    }
+    return 0;
+}
+
+// pos is on the opening bracket, returns the position of the element or 0
+static size_t findElement( const char* data, size_t size, size_t pos, unsigned long index )
+{
+    simple_json_value_t skipped;
+
+    pos = skipWhitespace( data, size, pos + 1 );
+    for ( ; index; --index )
+    {
+        pos = scanValue( data, size, pos, &skipped );
+        if ( !pos )
+            return 0;
+        pos = skipWhitespace( data, size, pos );
+        if ( pos >= size || data[ pos ] != ',' )
+            return 0;
+        pos = skipWhitespace( data, size, pos + 1 );
+    }
+    if ( pos >= size || data[ pos ] == ']' )
+        return 0;
+    return pos;
+}
+
+int simpleJsonQuery( const char *data, size_t dataSize, const char *path, simple_json_value_t *value )
+{
+    size_t pos;
+
+    if ( !data || !path || !value )
+        return 0;
+
+    pos = skipWhitespace( data, dataSize, 0 );
+    while ( *path && pos < dataSize )
+    {
+        if ( *path == '[' )
+        {
+            char *end;
+            unsigned long index = strtoul( path + 1, &end, 10 );
+            if ( end == path + 1 || *end != ']' || data[ pos ] != '[' )
+                return 0;
+            pos = findElement( data, dataSize, pos, index );
+            path = end + 1;
+        }
+        else
+        {
+            size_t nameLength;
+            if ( *path == '.' )
+                ++path;
+            nameLength = strcspn( path, ".[" );
+            if ( !nameLength || data[ pos ] != '{' )
+                return 0;
+            pos = findMember( data, dataSize, pos, path, nameLength );
+            path += nameLength;
+        }
+        if ( !pos )
+            return 0;
+    }
+    if ( *path )
+        return 0;
+
+    return scanValue( data, dataSize, pos, value ) != 0;
+}
+
+// Accumulate decimal digits, the ones beyond 19 are counted but not added
+static size_t scanDigits( const char *data, size_t size, size_t pos, uint64_t *digits, int *count )
+{
+    for ( ; pos < size && data[ pos ] >= '0' && data[ pos ] <= '9'; ++pos, ++( *count ) )
+    {
+        if ( *count < 19 )
+            *digits = *digits * 10 + (uint64_t) ( data[ pos ] - '0' );
+    }
+    return pos;
+}
+
+// Must match key_hash() in tools/json_keyhash/json_keyhash.py
+static uint32_t keyHash( const simple_json_key_table_t *table, const char *key, size_t length )
+{
+    const unsigned char *data = (const unsigned char *) key;
+    uint32_t hash = table->seed ^ (uint32_t) length;
+
+    if ( table->flags == SIMPLE_JSON_KEY_HASH_FULL )
+    {
+        size_t i;
+        for ( i = 0; i < length; ++i )
+            hash = ( hash ^ data[ i ] ) * 0x01000193UL;
+    }
+    else if ( length )
+    {
+        hash = ( hash ^ data[ 0 ] ) * 0x01000193UL;
+        hash = ( hash ^ data[ length >> 1 ] ) * 0x01000193UL;
+        hash = ( hash ^ data[ length - 1 ] ) * 0x01000193UL;
+    }
+    return hash ^ ( hash >> 16 );
+}
@@ -1,75 +1,562 @@
-/*
- *  Copyright (c) 2015, Parse, LLC. All rights reserved.
- *
- *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
- *  copy, modify, and distribute this software in source code or binary form for use
- *  in connection with the web services and APIs provided by Parse.
- *
- *  As with any software that integrates with the Parse platform, your use of
- *  this software is subject to the Parse Terms of Service
- *  [https://www.parse.com/about/terms]. This copyright notice shall be
- *  included in all copies or substantial portions of the software.
- *
- *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
- *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
- *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
- *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
- *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
- *
- */
-
-#pragma once
-
-#ifndef __SIMPLEJSON_H__
-#define __SIMPLEJSON_H__
-
-#ifdef __cplusplus
-extern "C"
-{
-#endif
-
-#include <stdlib.h>
-
-/**
- * A very lightweight JSon parser
- * @params
- *   data - JSON string to parse
- *   key - key to find
- *   value - returned value (always as string) or NULL if just to check values'
- *     presence
- *   size - size of the return buffer
- * @return 1 if found 0 otherwise
- */
-int simpleJsonProcessor(const char *data, const char *key, char* value, int size);
-
-/**
- * @params
- *   data - JSON object(s)
- * @return pointer to the second json object, NULL otherwise.
- */
-const char* findSecondJson(const char *data);
-
-/**
- * @params
- *   data - JSON object(s)
- * @return 1 if it is complete, 0 if you need to read more.
- */
-int isCompleteJson( const char *data );
-
-/**
- * @params
- *   data - [in] data to parse. Do not need to be NULL terminated.
- *   dataSize - [in] size of the data in bytes
- *   start - [out] offset of the first byte of the JSON or -1 if there nothing.
- *   length - [out] the length of the JSON  or -1 if the message is partial.
- * @return
- *   start of the JSON or NULL.
- */
-const char *getPushJson( const char *data, size_t dataSize, int *start, int *length );
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#ifndef __SIMPLEJSON_H__
+#define __SIMPLEJSON_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Errors returned by simpleJsonTokenize
+ */
+#define SIMPLE_JSON_ERROR_NOMEM    ( -1 )  // not enough tokens
+#define SIMPLE_JSON_ERROR_INVALID  ( -2 )  // malformed JSON
+#define SIMPLE_JSON_ERROR_PARTIAL  ( -3 )  // the document is incomplete
+
+/**
+ * Type of a JSON value
+ */
+typedef enum
+{
+    SIMPLE_JSON_UNDEFINED = 0,
+    SIMPLE_JSON_OBJECT,
+    SIMPLE_JSON_ARRAY,
+    SIMPLE_JSON_STRING,
+    SIMPLE_JSON_PRIMITIVE  // number, true, false or null
+} simple_json_type_t;
+
+/**
+ * A view into a JSON document. Nothing is copied, data points into the
+ * original buffer and is NOT NULL terminated.
+ *   - objects and arrays include the enclosing braces/brackets
+ *   - strings exclude the quotes, escape sequences are left as is
+ *   - primitives are the literal text (e.g. 12, true, null)
+ */
+typedef struct
+{
+    simple_json_type_t type;
+    const char*        data;
+    size_t             length;
+} simple_json_value_t;
+
+/**
+ * A token of a tokenized JSON document (see simpleJsonTokenize).
+ *
+ * Tokens are stored in document order. An object token is followed by its
+ * members as key/value token pairs, an array token by its elements. Every
+ * token records where its subtree ends, so siblings are one step apart no
+ * matter how deeply nested the values are.
+ */
+typedef struct
+{
+    uint8_t  type;   // simple_json_type_t
+    uint16_t size;   // number of members of an object or elements of an array
+    uint16_t next;   // index of the first token after this token's subtree
+    uint32_t start;  // offset of the value, strings exclude the quotes
+    uint32_t end;    // offset just past the value
+} simple_json_token_t;
+
+/**
+ * Events emitted by the streaming parser (see simpleJsonStreamParse)
+ */
+typedef enum
+{
+    SIMPLE_JSON_EVENT_START_OBJECT,
+    SIMPLE_JSON_EVENT_END_OBJECT,
+    SIMPLE_JSON_EVENT_START_ARRAY,
+    SIMPLE_JSON_EVENT_END_ARRAY,
+    SIMPLE_JSON_EVENT_KEY,
+    SIMPLE_JSON_EVENT_STRING,
+    SIMPLE_JSON_EVENT_PRIMITIVE
+} simple_json_event_type_t;
+
+/**
+ * A streaming parser event.
+ *   - data/length hold the text of keys, strings (without quotes, escape
+ *     sequences are left as is) and primitives, and are empty otherwise.
+ *   - text that fits in SIMPLE_JSON_STREAM_BUFFER_SIZE is always delivered in
+ *     one event. Longer text that spans several buffers is delivered in
+ *     several events, all but the last one with partial set.
+ *   - depth is the number of containers around the value, so the events of a
+ *     top level object are START_OBJECT at depth 0, its keys and values at
+ *     depth 1 and END_OBJECT at depth 0.
+ * The data is only valid during the callback.
+ */
+typedef struct
+{
+    simple_json_event_type_t type;
+    const char*              data;
+    size_t                   length;
+    int                      partial;
+    unsigned int             depth;
+} simple_json_event_t;
+
+/**
+ * Streaming parser callback. Return 0 to continue, or non-zero to suspend the
+ * parser right after this event.
+ */
+typedef int (*simple_json_event_callback_t)( void *context, const simple_json_event_t *event );
+
+#define SIMPLE_JSON_STREAM_MAX_DEPTH    ( 32 )
+#define SIMPLE_JSON_STREAM_BUFFER_SIZE  ( 64 )
+
+/**
+ * Streaming parser state. Treat as opaque, the size is fixed and does not
+ * depend on the document.
+ */
+typedef struct
+{
+    simple_json_event_callback_t callback;
+    void*                        context;
+    uint32_t                     containers;  // bit n set if the container at depth n is an object
+    uint8_t                      state;
+    uint8_t                      depth;
+    uint8_t                      escape;
+    uint8_t                      primitive;
+    uint8_t                      suspend;
+    uint16_t                     length;
+    char                         buffer[ SIMPLE_JSON_STREAM_BUFFER_SIZE ];
+} simple_json_stream_t;
+
+/**
+ * Output callback of the JSON writer. Return 0 on success.
+ */
+typedef int (*simple_json_sink_t)( void *context, const char *data, size_t length );
+
+#define SIMPLE_JSON_WRITER_MAX_DEPTH  ( 32 )
+#define SIMPLE_JSON_WRITER_DECIMALS   ( 6 )
+
+/**
+ * JSON writer state. Treat as opaque.
+ */
+typedef struct
+{
+    char*              buffer;
+    size_t             size;
+    size_t             used;        // bytes in buffer
+    size_t             length;      // total bytes written, including the ones that did not fit
+    simple_json_sink_t sink;
+    void*              context;
+    uint32_t           first;       // bit n set until the container at depth n has a member
+    uint8_t            depth;
+    uint8_t            key;         // a key was written, the next value follows it
+    int8_t             error;
+} simple_json_writer_t;
+
+/**
+ * Perfect hash tables of known keys, generated by
+ * tools/json_keyhash/json_keyhash.py. Every key has its own slot, so a
+ * lookup is one hash and one compare.
+ */
+#define SIMPLE_JSON_KEY_HASH_SPARSE  ( 0 )  // hash the length, first, middle and last characters
+#define SIMPLE_JSON_KEY_HASH_FULL    ( 1 )  // hash every character
+
+#define SIMPLE_JSON_KEY( name, id )  { name, sizeof( name ) - 1, id }
+#define SIMPLE_JSON_KEY_EMPTY        { NULL, 0, -1 }
+
+typedef struct
+{
+    const char* name;
+    uint8_t     length;
+    int16_t     id;
+} simple_json_key_t;
+
+typedef struct
+{
+    uint32_t                 seed;
+    uint16_t                 mask;
+    uint8_t                  flags;
+    const simple_json_key_t* slots;
+} simple_json_key_table_t;
+
+/**
+ * Member handler for simpleJsonDispatch. id is the id of the key in the
+ * table, or -1 for an unknown key. Return non-zero to stop.
+ */
+typedef int (*simple_json_member_handler_t)( void *context, int id, const simple_json_value_t *key, const simple_json_value_t *value );
+
+/**
+ * A very lightweight JSon parser. Only the members of the top level object are
+ * searched. Use simpleJsonTokenize to look up several keys in the same document.
+ * @params
+ *   data - JSON string to parse
+ *   key - key to find
+ *   value - returned value (always as string) or NULL if just to check values'
+ *     presence. Strings are unescaped (see simpleJsonDecodeString) unless they
+ *     are not valid, in which case they are copied as they are.
+ *   size - size of the return buffer
+ * @return 1 if found 0 otherwise
+ */
+int simpleJsonProcessor(const char *data, const char *key, char* value, int size);
+
+/**
+ * @params
+ *   data - JSON object(s)
+ * @return pointer to the second json object, NULL otherwise.
+ */
+const char* findSecondJson(const char *data);
+
+/**
+ * @params
+ *   data - JSON object(s)
+ * @return 1 if it is complete, 0 if you need to read more.
+ */
+int isCompleteJson( const char *data );
+
+/**
+ * @params
+ *   data - [in] data to parse. Do not need to be NULL terminated.
+ *   dataSize - [in] size of the data in bytes
+ *   start - [out] offset of the first byte of the JSON or -1 if there nothing.
+ *   length - [out] the length of the JSON  or -1 if the message is partial.
+ * @return
+ *   start of the JSON or NULL.
+ */
+const char *getPushJson( const char *data, size_t dataSize, int *start, int *length );
+
+/**
+ * Get a view of the first JSON value in the buffer, without copying.
+ * @params
+ *   data - [in] data to parse. Do not need to be NULL terminated.
+ *   dataSize - [in] size of the data in bytes
+ *   value - [out] view of the value
+ * @return
+ *   number of bytes consumed (including leading whitespace) or 0 if the value
+ *   is malformed or incomplete.
+ */
+size_t simpleJsonGetValue( const char *data, size_t dataSize, simple_json_value_t *value );
+
+/**
+ * Iterate over the members of an object in a single pass.
+ * @params
+ *   object - [in] view of the object (as returned by simpleJsonGetValue)
+ *   offset - [in/out] iteration state, must be 0 before the first call
+ *   key - [out] view of the member name
+ *   value - [out] view of the member value
+ * @return 1 if a member was returned, 0 at the end of the object or on
+ *   malformed JSON.
+ */
+int simpleJsonNextMember( const simple_json_value_t *object, size_t *offset, simple_json_value_t *key, simple_json_value_t *value );
+
+/**
+ * Start iterating over the members of the object at the start of a document
+ * without scanning it first, so that the members are only scanned once, by
+ * simpleJsonNextMember. Anything after the closing brace is ignored.
+ * @params
+ *   data - [in] the document, leading whitespace is skipped
+ *   dataSize - [in] size of data
+ *   object - [out] view of the object for simpleJsonNextMember alone, it
+ *     runs to the end of the data
+ * @return 1 if the document starts with an object, 0 otherwise
+ */
+int simpleJsonBeginObject( const char *data, size_t dataSize, simple_json_value_t *object );
+
+/**
+ * Iterate over the elements of an array in a single pass.
+ * @params
+ *   array - [in] view of the array (as returned by simpleJsonGetValue)
+ *   offset - [in/out] iteration state, must be 0 before the first call
+ *   value - [out] view of the element
+ * @return 1 if an element was returned, 0 at the end of the array or on
+ *   malformed JSON.
+ */
+int simpleJsonNextElement( const simple_json_value_t *array, size_t *offset, simple_json_value_t *value );
+
+/**
+ * Compare a value (typically a member name) with a NULL terminated string.
+ * Escape sequences are not decoded.
+ * @return 1 if equal, 0 otherwise
+ */
+int simpleJsonValueEquals( const simple_json_value_t *value, const char *string );
+
+/**
+ * Look up a key in a generated key table. Escape sequences are not decoded.
+ * @params
+ *   table - [in] table generated by json_keyhash.py
+ *   key - [in] key, does not need to be NULL terminated
+ *   length - [in] length of the key in bytes
+ * @return id of the key, or -1 if it is not in the table
+ */
+int simpleJsonKeyLookup( const simple_json_key_table_t *table, const char *key, size_t length );
+
+/**
+ * Walk the members of an object once, handing each one to the handler with
+ * the id of its key.
+ * @params
+ *   object - [in] view of an object
+ *   table - [in] table of the keys of interest
+ *   handler - [in] called for every member, known or not
+ *   context - [in] passed to the handler
+ * @return number of members with a known key
+ */
+int simpleJsonDispatch( const simple_json_value_t *object, const simple_json_key_table_t *table, simple_json_member_handler_t handler, void *context );
+
+/**
+ * Read an integer primitive in place. Fractions, exponents and values that
+ * do not fit are rejected.
+ * @params
+ *   value - [in] value view
+ *   result - [out] the integer
+ * @return 1 on success, 0 otherwise
+ */
+int simpleJsonGetInt64( const simple_json_value_t *value, int64_t *result );
+
+/**
+ * Read a number primitive in place. The result is exact for up to 15
+ * significant digits and exponents within +/-22, otherwise it may be off
+ * by a few units in the last place.
+ * @return 1 on success, 0 if the value is not a number
+ */
+int simpleJsonGetDouble( const simple_json_value_t *value, double *result );
+
+/**
+ * Read a true or false primitive.
+ * @return 1 on success, 0 otherwise
+ */
+int simpleJsonGetBool( const simple_json_value_t *value, int *result );
+
+/**
+ * @return 1 if the value is the null primitive, 0 otherwise
+ */
+int simpleJsonIsNull( const simple_json_value_t *value );
+
+/**
+ * Look up a nested value without copying anything. Every byte of the document
+ * is scanned at most once and no token array is needed.
+ * @params
+ *   data - [in] JSON document. Do not need to be NULL terminated.
+ *   dataSize - [in] size of the data in bytes
+ *   path - [in] member names separated by '.', array indices in brackets,
+ *     e.g. "results[0].objectId". An empty path returns the whole document.
+ *     Member names containing '.', '[' or escape sequences cannot be queried.
+ *   value - [out] view of the value
+ * @return 1 if found 0 otherwise
+ */
+int simpleJsonQuery( const char *data, size_t dataSize, const char *path, simple_json_value_t *value );
+
+/**
+ * Decode the escape sequences of a JSON string and validate it in one pass:
+ *   - \uXXXX escapes are converted to UTF-8, including surrogate pairs. Lone
+ *     surrogates and \u0000 are rejected.
+ *   - raw bytes must be valid UTF-8 (no overlong forms, surrogates or code
+ *     points above U+10FFFF) and control characters must be escaped.
+ * Runs of plain ASCII are checked and copied a word at a time.
+ * @params
+ *   data - [in] string contents, without the quotes
+ *   length - [in] length of the contents in bytes
+ *   buffer - [out] NULL terminated result
+ *   size - [in] size of the buffer
+ * @return
+ *   length of the result,
+ *   SIMPLE_JSON_ERROR_NOMEM if the buffer is too small: the result is
+ *     truncated on a character boundary,
+ *   SIMPLE_JSON_ERROR_INVALID if the string is not valid: the buffer is left
+ *     empty.
+ */
+int simpleJsonDecodeString( const char *data, size_t length, char *buffer, size_t size );
+
+/**
+ * Check that text is valid UTF-8, with the same rules as
+ * simpleJsonDecodeString. Runs of ASCII are checked a word at a time.
+ * @return 1 if valid, 0 otherwise
+ */
+int simpleJsonValidateUtf8( const char *data, size_t length );
+
+/**
+ * Copy a value as a NULL terminated string, decoding and validating strings
+ * with simpleJsonDecodeString. Other values are copied as they are.
+ * @params
+ *   value - [in] view of the value
+ *   buffer - [out] returned string
+ *   size - [in] size of the return buffer
+ * @return length of the string, or -1 if the buffer is too small or the string
+ *   is not valid. On error the buffer is left empty.
+ */
+int simpleJsonUnescape( const simple_json_value_t *value, char *buffer, size_t size );
+
+/**
+ * Initialize a streaming (SAX-style) parser.
+ * @params
+ *   stream - [out] parser state
+ *   callback - [in] called for every event
+ *   context - [in] passed to the callback
+ */
+void simpleJsonStreamInit( simple_json_stream_t *stream, simple_json_event_callback_t callback, void *context );
+
+/**
+ * Feed the next piece of a JSON stream to the parser. The pieces can be cut
+ * anywhere, including in the middle of a string or a number. Several
+ * documents can follow each other, separated by whitespace or newlines, as on
+ * the push connection.
+ * @params
+ *   stream - [in/out] parser state
+ *   data - [in] next piece of the stream. Do not need to be NULL terminated.
+ *   dataSize - [in] size of the data in bytes
+ * @return
+ *   number of bytes consumed, or SIMPLE_JSON_ERROR_INVALID. Less than
+ *   dataSize only if the callback suspended the parser; call again with the
+ *   rest of the data to resume.
+ * The parser validates the grammar, the literals true, false and null, the
+ * number syntax, the escape sequences and the absence of control characters
+ * in strings. It does not check that strings are valid UTF-8. Events that
+ * precede an error have already been delivered.
+ */
+int simpleJsonStreamParse( simple_json_stream_t *stream, const char *data, size_t dataSize );
+
+/**
+ * Signal the end of the stream. Needed to complete a top level number.
+ * @return 0 if the stream ended between documents, SIMPLE_JSON_ERROR_PARTIAL
+ *   if it ended in the middle of one, or SIMPLE_JSON_ERROR_INVALID.
+ */
+int simpleJsonStreamFinish( simple_json_stream_t *stream );
+
+/**
+ * Tokenize a JSON document in a single pass into a caller supplied token array.
+ * Only the first value in the buffer is tokenized, anything after it is ignored.
+ * @params
+ *   data - [in] data to parse. Do not need to be NULL terminated.
+ *   dataSize - [in] size of the data in bytes
+ *   tokens - [out] token array
+ *   maxTokens - [in] number of tokens in the array
+ * @return
+ *   number of tokens used, or one of the SIMPLE_JSON_ERROR_ codes
+ */
+int simpleJsonTokenize( const char *data, size_t dataSize, simple_json_token_t *tokens, unsigned int maxTokens );
+
+/**
+ * Find a member of a tokenized object. Escape sequences in the member names are
+ * not decoded.
+ * @params
+ *   data - [in] the tokenized document
+ *   tokens - [in] the tokens returned by simpleJsonTokenize
+ *   object - [in] index of the object token
+ *   key - [in] member name
+ * @return index of the value token or -1 if not found
+ */
+int simpleJsonTokenFind( const char *data, const simple_json_token_t *tokens, int object, const char *key );
+
+/**
+ * Find an element of a tokenized array.
+ * @params
+ *   tokens - [in] the tokens returned by simpleJsonTokenize
+ *   array - [in] index of the array token
+ *   index - [in] index of the element
+ * @return index of the element token or -1 if out of range
+ */
+int simpleJsonTokenElement( const simple_json_token_t *tokens, int array, unsigned int index );
+
+/**
+ * Get a view of a token.
+ * @return 1 on success, 0 if token is -1
+ */
+int simpleJsonTokenValue( const char *data, const simple_json_token_t *tokens, int token, simple_json_value_t *value );
+
+/**
+ * Copy a token as a NULL terminated string, in the same format as
+ * simpleJsonProcessor returns values.
+ * @params
+ *   data - [in] the tokenized document
+ *   tokens - [in] the tokens returned by simpleJsonTokenize
+ *   token - [in] index of the token
+ *   value - [out] returned value
+ *   size - [in] size of the return buffer
+ * @return 1 if copied, 0 if token is -1
+ */
+int simpleJsonTokenCopy( const char *data, const simple_json_token_t *tokens, int token, char *value, int size );
+
+/**
+ * Initialize a JSON writer that writes to a buffer. The output is NULL
+ * terminated by simpleJsonWriterFinish, one byte of the buffer is reserved
+ * for it. With a NULL buffer nothing is written and the writer only measures
+ * the document, e.g. for a Content-Length header.
+ * @params
+ *   writer - [out] writer state
+ *   buffer - [in] output buffer, or NULL to measure
+ *   size - [in] size of the buffer in bytes
+ */
+void simpleJsonWriterInit( simple_json_writer_t *writer, char *buffer, size_t size );
+
+/**
+ * Initialize a JSON writer that hands its output to a sink, e.g. the
+ * outbound stream. The buffer collects small writes, it is passed to the sink
+ * whenever it is full and by simpleJsonWriterFinish. With a NULL buffer every
+ * write goes to the sink directly.
+ */
+void simpleJsonWriterInitSink( simple_json_writer_t *writer, simple_json_sink_t sink, void *context, char *buffer, size_t size );
+
+/**
+ * Open and close objects and arrays. Commas are added as needed.
+ */
+void simpleJsonWriteStartObject( simple_json_writer_t *writer );
+void simpleJsonWriteEndObject( simple_json_writer_t *writer );
+void simpleJsonWriteStartArray( simple_json_writer_t *writer );
+void simpleJsonWriteEndArray( simple_json_writer_t *writer );
+
+/**
+ * Write an object member name. The next value written belongs to it.
+ */
+void simpleJsonWriteKey( simple_json_writer_t *writer, const char *key );
+
+/**
+ * Write a string value, escaped as needed. UTF-8 is passed through.
+ */
+void simpleJsonWriteString( simple_json_writer_t *writer, const char *value );
+void simpleJsonWriteStringN( simple_json_writer_t *writer, const char *value, size_t length );
+
+/**
+ * Write numbers. Doubles are written with up to SIMPLE_JSON_WRITER_DECIMALS
+ * decimals, very large or small ones with an exponent. NaN and infinities are
+ * written as null.
+ */
+void simpleJsonWriteInt( simple_json_writer_t *writer, int64_t value );
+void simpleJsonWriteDouble( simple_json_writer_t *writer, double value );
+
+void simpleJsonWriteBool( simple_json_writer_t *writer, int value );
+void simpleJsonWriteNull( simple_json_writer_t *writer );
+
+/**
+ * Write a value that is already JSON, e.g. a value view from the parser.
+ */
+void simpleJsonWriteRaw( simple_json_writer_t *writer, const char *json, size_t length );
+
+/**
+ * Complete the output: NULL terminate the buffer or flush it to the sink.
+ * @return
+ *   length of the document in bytes (whether or not it fit),
+ *   SIMPLE_JSON_ERROR_NOMEM if the buffer was too small or the sink failed,
+ *   SIMPLE_JSON_ERROR_INVALID if the containers are not balanced.
+ */
+int simpleJsonWriterFinish( simple_json_writer_t *writer );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
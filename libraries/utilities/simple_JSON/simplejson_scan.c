@@ -0,0 +1,402 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "simplejson_scan.h"
+#include <stdint.h>
+#include <string.h>
+
+#if !defined( SIMPLE_JSON_SCALAR ) && !defined( SIMPLE_JSON_SWAR )
+#if defined( __AVX2__ )
+#define SIMPLE_JSON_AVX2
+#include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 )
+#define SIMPLE_JSON_SSE2
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#define SIMPLE_JSON_NEON
+#include <arm_neon.h>
+#else
+#define SIMPLE_JSON_SWAR
+#endif
+#endif
+
+static size_t findStructuralScalar( const char *data, size_t size, size_t pos );
+static size_t findStringSpecialScalar( const char *data, size_t size, size_t pos );
+static size_t findStringControlScalar( const char *data, size_t size, size_t pos );
+
+static size_t findStructuralScalar( const char *data, size_t size, size_t pos )
+{
+    for ( ; pos < size; ++pos )
+    {
+        switch ( data[ pos ] )
+        {
+            case '\"':
+            case '\\':
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+            case 0:
+                return pos;
+        }
+    }
+    return size;
+}
+
+static size_t findStringSpecialScalar( const char *data, size_t size, size_t pos )
+{
+    for ( ; pos < size; ++pos )
+    {
+        switch ( data[ pos ] )
+        {
+            case '\"':
+            case '\\':
+            case 0:
+                return pos;
+        }
+    }
+    return size;
+}
+
+static size_t findStringControlScalar( const char *data, size_t size, size_t pos )
+{
+    for ( ; pos < size; ++pos )
+    {
+        unsigned char c = (unsigned char) data[ pos ];
+        if ( c < 0x20 || c == '\"' || c == '\\' )
+            return pos;
+    }
+    return size;
+}
+
+#if defined( SIMPLE_JSON_AVX2 )
+
+const char *simpleJsonScanner( void )
+{
+    return "avx2";
+}
+
+size_t simpleJsonFindStructural( const char *data, size_t size, size_t pos )
+{
+    const __m256i zero = _mm256_setzero_si256( );
+    const __m256i quote = _mm256_set1_epi8( '\"' );
+    const __m256i backslash = _mm256_set1_epi8( '\\' );
+    const __m256i colon = _mm256_set1_epi8( ':' );
+    const __m256i comma = _mm256_set1_epi8( ',' );
+    const __m256i caseBit = _mm256_set1_epi8( 0x20 );
+    const __m256i openBrace = _mm256_set1_epi8( '{' );
+    const __m256i closeBrace = _mm256_set1_epi8( '}' );
+
+    for ( ; pos + 32 <= size; pos += 32 )
+    {
+        __m256i chunk = _mm256_loadu_si256( (const __m256i*) ( data + pos ) );
+        // '[' and ']' only differ from '{' and '}' by 0x20
+        __m256i folded = _mm256_or_si256( chunk, caseBit );
+        __m256i match = _mm256_or_si256(
+            _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi8( chunk, zero ), _mm256_cmpeq_epi8( chunk, quote ) ),
+                             _mm256_or_si256( _mm256_cmpeq_epi8( chunk, backslash ), _mm256_cmpeq_epi8( chunk, colon ) ) ),
+            _mm256_or_si256( _mm256_cmpeq_epi8( chunk, comma ),
+                             _mm256_or_si256( _mm256_cmpeq_epi8( folded, openBrace ), _mm256_cmpeq_epi8( folded, closeBrace ) ) ) );
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8( match );
+        if ( mask )
+            return pos + __builtin_ctz( mask );
+    }
+    return findStructuralScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringSpecial( const char *data, size_t size, size_t pos )
+{
+    const __m256i zero = _mm256_setzero_si256( );
+    const __m256i quote = _mm256_set1_epi8( '\"' );
+    const __m256i backslash = _mm256_set1_epi8( '\\' );
+
+    for ( ; pos + 32 <= size; pos += 32 )
+    {
+        __m256i chunk = _mm256_loadu_si256( (const __m256i*) ( data + pos ) );
+        __m256i match = _mm256_or_si256( _mm256_cmpeq_epi8( chunk, zero ),
+                                         _mm256_or_si256( _mm256_cmpeq_epi8( chunk, quote ), _mm256_cmpeq_epi8( chunk, backslash ) ) );
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8( match );
+        if ( mask )
+            return pos + __builtin_ctz( mask );
+    }
+    return findStringSpecialScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringControl( const char *data, size_t size, size_t pos )
+{
+    const __m256i control = _mm256_set1_epi8( 0x1F );
+    const __m256i quote = _mm256_set1_epi8( '\"' );
+    const __m256i backslash = _mm256_set1_epi8( '\\' );
+
+    for ( ; pos + 32 <= size; pos += 32 )
+    {
+        __m256i chunk = _mm256_loadu_si256( (const __m256i*) ( data + pos ) );
+        // Unsigned chunk <= 0x1F, there is no unsigned byte compare
+        __m256i match = _mm256_or_si256( _mm256_cmpeq_epi8( _mm256_min_epu8( chunk, control ), chunk ),
+                                         _mm256_or_si256( _mm256_cmpeq_epi8( chunk, quote ), _mm256_cmpeq_epi8( chunk, backslash ) ) );
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8( match );
+        if ( mask )
+            return pos + __builtin_ctz( mask );
+    }
+    return findStringControlScalar( data, size, pos );
+}
+
+#elif defined( SIMPLE_JSON_SSE2 )
+
+const char *simpleJsonScanner( void )
+{
+    return "sse2";
+}
+
+size_t simpleJsonFindStructural( const char *data, size_t size, size_t pos )
+{
+    const __m128i zero = _mm_setzero_si128( );
+    const __m128i quote = _mm_set1_epi8( '\"' );
+    const __m128i backslash = _mm_set1_epi8( '\\' );
+    const __m128i colon = _mm_set1_epi8( ':' );
+    const __m128i comma = _mm_set1_epi8( ',' );
+    const __m128i caseBit = _mm_set1_epi8( 0x20 );
+    const __m128i openBrace = _mm_set1_epi8( '{' );
+    const __m128i closeBrace = _mm_set1_epi8( '}' );
+
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        __m128i chunk = _mm_loadu_si128( (const __m128i*) ( data + pos ) );
+        // '[' and ']' only differ from '{' and '}' by 0x20
+        __m128i folded = _mm_or_si128( chunk, caseBit );
+        __m128i match = _mm_or_si128(
+            _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( chunk, zero ), _mm_cmpeq_epi8( chunk, quote ) ),
+                          _mm_or_si128( _mm_cmpeq_epi8( chunk, backslash ), _mm_cmpeq_epi8( chunk, colon ) ) ),
+            _mm_or_si128( _mm_cmpeq_epi8( chunk, comma ),
+                          _mm_or_si128( _mm_cmpeq_epi8( folded, openBrace ), _mm_cmpeq_epi8( folded, closeBrace ) ) ) );
+        unsigned int mask = (unsigned int) _mm_movemask_epi8( match );
+        if ( mask )
+            return pos + __builtin_ctz( mask );
+    }
+    return findStructuralScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringSpecial( const char *data, size_t size, size_t pos )
+{
+    const __m128i zero = _mm_setzero_si128( );
+    const __m128i quote = _mm_set1_epi8( '\"' );
+    const __m128i backslash = _mm_set1_epi8( '\\' );
+
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        __m128i chunk = _mm_loadu_si128( (const __m128i*) ( data + pos ) );
+        __m128i match = _mm_or_si128( _mm_cmpeq_epi8( chunk, zero ),
+                                      _mm_or_si128( _mm_cmpeq_epi8( chunk, quote ), _mm_cmpeq_epi8( chunk, backslash ) ) );
+        unsigned int mask = (unsigned int) _mm_movemask_epi8( match );
+        if ( mask )
+            return pos + __builtin_ctz( mask );
+    }
+    return findStringSpecialScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringControl( const char *data, size_t size, size_t pos )
+{
+    const __m128i control = _mm_set1_epi8( 0x1F );
+    const __m128i quote = _mm_set1_epi8( '\"' );
+    const __m128i backslash = _mm_set1_epi8( '\\' );
+
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        __m128i chunk = _mm_loadu_si128( (const __m128i*) ( data + pos ) );
+        // Unsigned chunk <= 0x1F, there is no unsigned byte compare
+        __m128i match = _mm_or_si128( _mm_cmpeq_epi8( _mm_min_epu8( chunk, control ), chunk ),
+                                      _mm_or_si128( _mm_cmpeq_epi8( chunk, quote ), _mm_cmpeq_epi8( chunk, backslash ) ) );
+        unsigned int mask = (unsigned int) _mm_movemask_epi8( match );
+        if ( mask )
+            return pos + __builtin_ctz( mask );
+    }
+    return findStringControlScalar( data, size, pos );
+}
+
+#elif defined( SIMPLE_JSON_NEON )
+
+const char *simpleJsonScanner( void )
+{
+    return "neon";
+}
+
+// Narrow a 0x00/0xFF byte mask to 4 bits per byte and return the first match
+static size_t firstMatch( uint8x16_t match, size_t pos, int *found )
+{
+    uint64_t mask = vget_lane_u64( vreinterpret_u64_u8( vshrn_n_u16( vreinterpretq_u16_u8( match ), 4 ) ), 0 );
+    *found = ( mask != 0 );
+    return mask ? pos + ( __builtin_ctzll( mask ) >> 2 ) : pos;
+}
+
+size_t simpleJsonFindStructural( const char *data, size_t size, size_t pos )
+{
+    const uint8x16_t zero = vdupq_n_u8( 0 );
+    const uint8x16_t quote = vdupq_n_u8( '\"' );
+    const uint8x16_t backslash = vdupq_n_u8( '\\' );
+    const uint8x16_t colon = vdupq_n_u8( ':' );
+    const uint8x16_t comma = vdupq_n_u8( ',' );
+    const uint8x16_t caseBit = vdupq_n_u8( 0x20 );
+    const uint8x16_t openBrace = vdupq_n_u8( '{' );
+    const uint8x16_t closeBrace = vdupq_n_u8( '}' );
+    int found;
+
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        uint8x16_t chunk = vld1q_u8( (const uint8_t*) ( data + pos ) );
+        // '[' and ']' only differ from '{' and '}' by 0x20
+        uint8x16_t folded = vorrq_u8( chunk, caseBit );
+        uint8x16_t match = vorrq_u8(
+            vorrq_u8( vorrq_u8( vceqq_u8( chunk, zero ), vceqq_u8( chunk, quote ) ),
+                      vorrq_u8( vceqq_u8( chunk, backslash ), vceqq_u8( chunk, colon ) ) ),
+            vorrq_u8( vceqq_u8( chunk, comma ),
+                      vorrq_u8( vceqq_u8( folded, openBrace ), vceqq_u8( folded, closeBrace ) ) ) );
+        size_t first = firstMatch( match, pos, &found );
+        if ( found )
+            return first;
+    }
+    return findStructuralScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringSpecial( const char *data, size_t size, size_t pos )
+{
+    const uint8x16_t zero = vdupq_n_u8( 0 );
+    const uint8x16_t quote = vdupq_n_u8( '\"' );
+    const uint8x16_t backslash = vdupq_n_u8( '\\' );
+    int found;
+
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        uint8x16_t chunk = vld1q_u8( (const uint8_t*) ( data + pos ) );
+        uint8x16_t match = vorrq_u8( vceqq_u8( chunk, zero ), vorrq_u8( vceqq_u8( chunk, quote ), vceqq_u8( chunk, backslash ) ) );
+        size_t first = firstMatch( match, pos, &found );
+        if ( found )
+            return first;
+    }
+    return findStringSpecialScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringControl( const char *data, size_t size, size_t pos )
+{
+    const uint8x16_t space = vdupq_n_u8( ' ' );
+    const uint8x16_t quote = vdupq_n_u8( '\"' );
+    const uint8x16_t backslash = vdupq_n_u8( '\\' );
+    int found;
+
+    for ( ; pos + 16 <= size; pos += 16 )
+    {
+        uint8x16_t chunk = vld1q_u8( (const uint8_t*) ( data + pos ) );
+        uint8x16_t match = vorrq_u8( vcltq_u8( chunk, space ), vorrq_u8( vceqq_u8( chunk, quote ), vceqq_u8( chunk, backslash ) ) );
+        size_t first = firstMatch( match, pos, &found );
+        if ( found )
+            return first;
+    }
+    return findStringControlScalar( data, size, pos );
+}
+
+#elif defined( SIMPLE_JSON_SWAR ) && !defined( SIMPLE_JSON_SCALAR )
+
+#if UINTPTR_MAX > 0xFFFFFFFFu && !defined( SIMPLE_JSON_SWAR32 )
+typedef uint64_t swar_word_t;
+#define SWAR_NAME "swar64"
+#else
+typedef uint32_t swar_word_t;
+#define SWAR_NAME "swar32"
+#endif
+
+#define SWAR_ONES          ( (swar_word_t) -1 / 0xFF )
+#define SWAR_HIGHS         ( SWAR_ONES * 0x80 )
+#define SWAR_BYTE( c )     ( SWAR_ONES * (uint8_t) ( c ) )
+// Non-zero if any byte of x is zero. Exact, the result is only used as a flag.
+#define SWAR_HAS_ZERO( x ) ( ( ( x ) - SWAR_ONES ) & ~( x ) & SWAR_HIGHS )
+#define SWAR_HAS( x, c )   SWAR_HAS_ZERO( ( x ) ^ SWAR_BYTE( c ) )
+// Non-zero if any byte of x is below n (n <= 0x80), also only used as a flag
+#define SWAR_HAS_LESS( x, n ) ( ( ( x ) - SWAR_BYTE( n ) ) & ~( x ) & SWAR_HIGHS )
+
+const char *simpleJsonScanner( void )
+{
+    return SWAR_NAME;
+}
+
+size_t simpleJsonFindStructural( const char *data, size_t size, size_t pos )
+{
+    for ( ; pos + sizeof( swar_word_t ) <= size; pos += sizeof( swar_word_t ) )
+    {
+        swar_word_t word;
+        swar_word_t folded;
+        memcpy( &word, data + pos, sizeof( word ) );
+        // '[' and ']' only differ from '{' and '}' by 0x20
+        folded = word | SWAR_BYTE( 0x20 );
+        if ( SWAR_HAS_ZERO( word ) | SWAR_HAS( word, '\"' ) | SWAR_HAS( word, '\\' ) | SWAR_HAS( word, ':' ) |
+             SWAR_HAS( word, ',' ) | SWAR_HAS( folded, '{' ) | SWAR_HAS( folded, '}' ) )
+            return findStructuralScalar( data, pos + sizeof( swar_word_t ), pos );
+    }
+    return findStructuralScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringSpecial( const char *data, size_t size, size_t pos )
+{
+    for ( ; pos + sizeof( swar_word_t ) <= size; pos += sizeof( swar_word_t ) )
+    {
+        swar_word_t word;
+        memcpy( &word, data + pos, sizeof( word ) );
+        if ( SWAR_HAS_ZERO( word ) | SWAR_HAS( word, '\"' ) | SWAR_HAS( word, '\\' ) )
+            return findStringSpecialScalar( data, pos + sizeof( swar_word_t ), pos );
+    }
+    return findStringSpecialScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringControl( const char *data, size_t size, size_t pos )
+{
+    for ( ; pos + sizeof( swar_word_t ) <= size; pos += sizeof( swar_word_t ) )
+    {
+        swar_word_t word;
+        memcpy( &word, data + pos, sizeof( word ) );
+        if ( SWAR_HAS_LESS( word, ' ' ) | SWAR_HAS( word, '\"' ) | SWAR_HAS( word, '\\' ) )
+            return findStringControlScalar( data, pos + sizeof( swar_word_t ), pos );
+    }
+    return findStringControlScalar( data, size, pos );
+}
+
+#else
+
+const char *simpleJsonScanner( void )
+{
+    return "scalar";
+}
+
+size_t simpleJsonFindStructural( const char *data, size_t size, size_t pos )
+{
+    return findStructuralScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringSpecial( const char *data, size_t size, size_t pos )
+{
+    return findStringSpecialScalar( data, size, pos );
+}
+
+size_t simpleJsonFindStringControl( const char *data, size_t size, size_t pos )
+{
+    return findStringControlScalar( data, size, pos );
+}
+
+#endif
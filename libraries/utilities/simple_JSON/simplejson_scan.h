@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#ifndef __SIMPLEJSON_SCAN_H__
+#define __SIMPLEJSON_SCAN_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+/**
+ * Structural character scanning used by the simplejson scanners.
+ *
+ * The implementation is selected at build time:
+ *   - AVX2 or SSE2 on x86 hosts (__AVX2__ / __SSE2__)
+ *   - NEON on ARM parts that have it (__ARM_NEON)
+ *   - a portable SWAR (SIMD within a register) fallback otherwise, using
+ *     64-bit words on 64-bit hosts and 32-bit words on Cortex-M
+ * Define SIMPLE_JSON_SCALAR to force the byte-at-a-time implementation, or
+ * SIMPLE_JSON_SWAR (and SIMPLE_JSON_SWAR32 for 32-bit words) to force SWAR.
+ * All implementations return exactly the same results.
+ */
+
+/**
+ * @params
+ *   data - [in] data to scan
+ *   size - [in] size of the data in bytes
+ *   pos - [in] offset to start from
+ * @return offset of the first '"', '\\', '{', '}', '[', ']', ':', ',' or NUL
+ *   at or after pos, or size if there is none.
+ */
+size_t simpleJsonFindStructural( const char *data, size_t size, size_t pos );
+
+/**
+ * Same as simpleJsonFindStructural, for the characters that matter inside a
+ * string: '"', '\\' and NUL.
+ */
+size_t simpleJsonFindStringSpecial( const char *data, size_t size, size_t pos );
+
+/**
+ * Same as simpleJsonFindStringSpecial, also stopping at the control
+ * characters (below 0x20) that JSON does not allow unescaped in a string.
+ */
+size_t simpleJsonFindStringControl( const char *data, size_t size, size_t pos );
+
+/**
+ * @return the name of the implementation selected at build time
+ *   ("avx2", "sse2", "neon", "swar64", "swar32" or "scalar")
+ */
+const char *simpleJsonScanner( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,443 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "simplejson.h"
+#include "simplejson_scan.h"
+#include <string.h>
+
+enum
+{
+    STREAM_VALUE,
+    STREAM_VALUE_OR_END,
+    STREAM_KEY,
+    STREAM_KEY_OR_END,
+    STREAM_COLON,
+    STREAM_COMMA_OR_END,
+    STREAM_STRING,
+    STREAM_KEY_STRING,
+    STREAM_PRIMITIVE,
+    STREAM_ERROR
+};
+
+// Escape sequence progress: the character after the backslash, then the hex digits of \uXXXX
+enum
+{
+    ESCAPE_NONE,
+    ESCAPE_CHARACTER,
+    ESCAPE_LAST_HEX,
+    ESCAPE_FIRST_HEX = ESCAPE_LAST_HEX + 3
+};
+
+// Number and literal progress. Literal n is PRIMITIVE_LITERAL * ( n + 1 ) plus the characters matched so far
+enum
+{
+    PRIMITIVE_INVALID,
+    PRIMITIVE_MINUS,
+    PRIMITIVE_ZERO,
+    PRIMITIVE_INTEGER,
+    PRIMITIVE_DOT,
+    PRIMITIVE_FRACTION,
+    PRIMITIVE_EXPONENT,
+    PRIMITIVE_EXPONENT_SIGN,
+    PRIMITIVE_EXPONENT_DIGITS,
+    PRIMITIVE_LITERAL = 16
+};
+
+static const char * const literals[ ] = { "true", "false", "null" };
+
+// Helper functions
+static void emit( simple_json_stream_t *stream, simple_json_event_type_t type, const char *data, size_t length, int partial );
+static void appendText( simple_json_stream_t *stream, simple_json_event_type_t type, const char *data, size_t length );
+static void finishText( simple_json_stream_t *stream, simple_json_event_type_t type, const char *data, size_t length );
+static void afterValue( simple_json_stream_t *stream );
+static int isObject( const simple_json_stream_t *stream );
+static int isPrimitiveEnd( char c );
+static int nextEscape( uint8_t escape, char c );
+static uint8_t nextPrimitive( uint8_t primitive, char c );
+static int isPrimitiveComplete( uint8_t primitive );
+static int isDigit( char c );
+
+void simpleJsonStreamInit( simple_json_stream_t *stream, simple_json_event_callback_t callback, void *context )
+{
+    memset( stream, 0, sizeof( *stream ) );
+    stream->callback = callback;
+    stream->context = context;
+    stream->state = STREAM_VALUE;
+}
+
+int simpleJsonStreamParse( simple_json_stream_t *stream, const char *data, size_t dataSize )
+{
+    size_t pos = 0;
+    // A key, string or primitive cut by the previous piece continues here
+    size_t start = 0;
+
+    if ( stream->state == STREAM_ERROR )
+        return SIMPLE_JSON_ERROR_INVALID;
+
+    stream->suspend = 0;
+    while ( pos < dataSize && !stream->suspend )
+    {
+        char c = data[ pos ];
+
+        switch ( stream->state )
+        {
+            case STREAM_STRING:
+            case STREAM_KEY_STRING:
+                if ( stream->escape )
+                {
+                    int escape = nextEscape( stream->escape, c );
+                    if ( escape < 0 )
+                        goto FAIL;
+                    stream->escape = (uint8_t) escape;
+                    ++pos;
+                    continue;
+                }
+                pos = simpleJsonFindStringControl( data, dataSize, pos );
+                if ( pos >= dataSize )
+                    continue;
+                c = data[ pos ];
+                if ( c == '\\' )
+                {
+                    stream->escape = ESCAPE_CHARACTER;
+                    ++pos;
+                    continue;
+                }
+                // NUL or another control character
+                if ( c != '\"' )
+                    goto FAIL;
+                if ( stream->state == STREAM_KEY_STRING )
+                {
+                    finishText( stream, SIMPLE_JSON_EVENT_KEY, data + start, pos - start );
+                    stream->state = STREAM_COLON;
+                }
+                else
+                {
+                    finishText( stream, SIMPLE_JSON_EVENT_STRING, data + start, pos - start );
+                    afterValue( stream );
+                }
+                ++pos;
+                continue;
+
+            case STREAM_PRIMITIVE:
+            {
+                uint8_t primitive = stream->primitive;
+                for ( ; pos < dataSize; ++pos )
+                {
+                    c = data[ pos ];
+                    // Digits do not change the state once a run of them has started
+                    if ( isDigit( c ) && ( primitive == PRIMITIVE_INTEGER || primitive == PRIMITIVE_FRACTION || primitive == PRIMITIVE_EXPONENT_DIGITS ) )
+                        continue;
+                    if ( isPrimitiveEnd( c ) )
+                        break;
+                    primitive = nextPrimitive( primitive, c );
+                    if ( primitive == PRIMITIVE_INVALID )
+                        goto FAIL;
+                }
+                stream->primitive = primitive;
+                if ( pos >= dataSize )
+                    continue;
+                if ( !isPrimitiveComplete( primitive ) )
+                    goto FAIL;
+                // The character that ends the primitive is processed in the next state
+                finishText( stream, SIMPLE_JSON_EVENT_PRIMITIVE, data + start, pos - start );
+                afterValue( stream );
+                continue;
+            }
+
+            default:
+                break;
+        }
+
+        switch ( c )
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+            case '\n':
+                break;
+
+            case '{':
+            case '[':
+                if ( stream->state != STREAM_VALUE && stream->state != STREAM_VALUE_OR_END )
+                    goto FAIL;
+                if ( stream->depth >= SIMPLE_JSON_STREAM_MAX_DEPTH )
+                    goto FAIL;
+                if ( c == '{' )
+                {
+                    emit( stream, SIMPLE_JSON_EVENT_START_OBJECT, NULL, 0, 0 );
+                    stream->containers |= ( 1UL << stream->depth );
+                    stream->state = STREAM_KEY_OR_END;
+                }
+                else
+                {
+                    emit( stream, SIMPLE_JSON_EVENT_START_ARRAY, NULL, 0, 0 );
+                    stream->containers &= ~( 1UL << stream->depth );
+                    stream->state = STREAM_VALUE_OR_END;
+                }
+                ++stream->depth;
+                break;
+
+            case '}':
+                if ( ( stream->state != STREAM_KEY_OR_END && stream->state != STREAM_COMMA_OR_END ) || !stream->depth || !isObject( stream ) )
+                    goto FAIL;
+                --stream->depth;
+                emit( stream, SIMPLE_JSON_EVENT_END_OBJECT, NULL, 0, 0 );
+                afterValue( stream );
+                break;
+
+            case ']':
+                if ( ( stream->state != STREAM_VALUE_OR_END && stream->state != STREAM_COMMA_OR_END ) || !stream->depth || isObject( stream ) )
+                    goto FAIL;
+                --stream->depth;
+                emit( stream, SIMPLE_JSON_EVENT_END_ARRAY, NULL, 0, 0 );
+                afterValue( stream );
+                break;
+
+            case '\"':
+                if ( stream->state == STREAM_KEY || stream->state == STREAM_KEY_OR_END )
+                    stream->state = STREAM_KEY_STRING;
+                else if ( stream->state == STREAM_VALUE || stream->state == STREAM_VALUE_OR_END )
+                    stream->state = STREAM_STRING;
+                else
+                    goto FAIL;
+                start = pos + 1;
+                break;
+
+            case ':':
+                if ( stream->state != STREAM_COLON )
+                    goto FAIL;
+                stream->state = STREAM_VALUE;
+                break;
+
+            case ',':
+                if ( stream->state != STREAM_COMMA_OR_END )
+                    goto FAIL;
+                stream->state = isObject( stream ) ? STREAM_KEY : STREAM_VALUE;
+                break;
+
+            default:
+                if ( stream->state != STREAM_VALUE && stream->state != STREAM_VALUE_OR_END )
+                    goto FAIL;
+                stream->primitive = nextPrimitive( PRIMITIVE_INVALID, c );
+                if ( stream->primitive == PRIMITIVE_INVALID )
+                    goto FAIL;
+                stream->state = STREAM_PRIMITIVE;
+                start = pos;
+                break;
+        }
+        ++pos;
+    }
+
+    // Keep the beginning of a key, string or primitive that continues in the next piece
+    if ( stream->state == STREAM_STRING || stream->state == STREAM_KEY_STRING || stream->state == STREAM_PRIMITIVE )
+    {
+        simple_json_event_type_t type = ( stream->state == STREAM_STRING ) ? SIMPLE_JSON_EVENT_STRING :
+                                        ( stream->state == STREAM_KEY_STRING ) ? SIMPLE_JSON_EVENT_KEY : SIMPLE_JSON_EVENT_PRIMITIVE;
+        appendText( stream, type, data + start, pos - start );
+    }
+    return (int) pos;
+
+    FAIL: stream->state = STREAM_ERROR;
+    return SIMPLE_JSON_ERROR_INVALID;
+}
+
+int simpleJsonStreamFinish( simple_json_stream_t *stream )
+{
+    if ( stream->state == STREAM_ERROR )
+        return SIMPLE_JSON_ERROR_INVALID;
+
+    if ( stream->state == STREAM_PRIMITIVE && !stream->depth && isPrimitiveComplete( stream->primitive ) )
+    {
+        finishText( stream, SIMPLE_JSON_EVENT_PRIMITIVE, NULL, 0 );
+        afterValue( stream );
+    }
+
+    if ( stream->state != STREAM_VALUE || stream->depth )
+        return SIMPLE_JSON_ERROR_PARTIAL;
+    return 0;
+}
+
+static void emit( simple_json_stream_t *stream, simple_json_event_type_t type, const char *data, size_t length, int partial )
+{
+    simple_json_event_t event;
+
+    event.type = type;
+    event.data = data;
+    event.length = length;
+    event.partial = partial;
+    event.depth = stream->depth;
+    if ( stream->callback && stream->callback( stream->context, &event ) )
+        stream->suspend = 1;
+}
+
+// Buffer text that continues later, handing over full buffers as partial events
+static void appendText( simple_json_stream_t *stream, simple_json_event_type_t type, const char *data, size_t length )
+{
+    while ( length )
+    {
+        size_t space = SIMPLE_JSON_STREAM_BUFFER_SIZE - stream->length;
+        if ( !space )
+        {
+            emit( stream, type, stream->buffer, stream->length, 1 );
+            stream->length = 0;
+            continue;
+        }
+        if ( space > length )
+            space = length;
+        memcpy( stream->buffer + stream->length, data, space );
+        stream->length += (uint16_t) space;
+        data += space;
+        length -= space;
+    }
+}
+
+static void finishText( simple_json_stream_t *stream, simple_json_event_type_t type, const char *data, size_t length )
+{
+    // Nothing buffered, hand over the text in place
+    if ( !stream->length )
+    {
+        emit( stream, type, data, length, 0 );
+        return;
+    }
+    appendText( stream, type, data, length );
+    emit( stream, type, stream->buffer, stream->length, 0 );
+    stream->length = 0;
+}
+
+static void afterValue( simple_json_stream_t *stream )
+{
+    // Back to the start of the next document at the top level
+    stream->state = stream->depth ? STREAM_COMMA_OR_END : STREAM_VALUE;
+}
+
+static int isObject( const simple_json_stream_t *stream )
+{
+    return stream->depth && ( ( stream->containers >> ( stream->depth - 1 ) ) & 1 );
+}
+
+static int isPrimitiveEnd( char c )
+{
+    switch ( c )
+    {
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+        case ',':
+        case ':':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case '\"':
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// Returns the escape state after c, or -1 if c cannot follow
+static int nextEscape( uint8_t escape, char c )
+{
+    if ( escape == ESCAPE_CHARACTER )
+    {
+        if ( c == 'u' )
+            return ESCAPE_FIRST_HEX;
+        return ( c && strchr( "\"\\/bfnrt", c ) ) ? ESCAPE_NONE : -1;
+    }
+    if ( !isDigit( c ) && ( c < 'a' || c > 'f' ) && ( c < 'A' || c > 'F' ) )
+        return -1;
+    return ( escape == ESCAPE_LAST_HEX ) ? ESCAPE_NONE : escape - 1;
+}
+
+// Returns the primitive state after c (PRIMITIVE_INVALID to start), or PRIMITIVE_INVALID if c cannot follow
+static uint8_t nextPrimitive( uint8_t primitive, char c )
+{
+    unsigned int literal;
+
+    switch ( primitive )
+    {
+        case PRIMITIVE_INVALID:
+            if ( c == '-' )
+                return PRIMITIVE_MINUS;
+            if ( isDigit( c ) )
+                return ( c == '0' ) ? PRIMITIVE_ZERO : PRIMITIVE_INTEGER;
+            for ( literal = 0; literal < sizeof( literals ) / sizeof( literals[ 0 ] ); ++literal )
+            {
+                if ( c == literals[ literal ][ 0 ] )
+                    return (uint8_t) ( PRIMITIVE_LITERAL * ( literal + 1 ) + 1 );
+            }
+            return PRIMITIVE_INVALID;
+
+        case PRIMITIVE_MINUS:
+            if ( !isDigit( c ) )
+                return PRIMITIVE_INVALID;
+            return ( c == '0' ) ? PRIMITIVE_ZERO : PRIMITIVE_INTEGER;
+
+        case PRIMITIVE_ZERO:
+        case PRIMITIVE_INTEGER:
+            // No leading zeros, a fraction or an exponent can follow
+            if ( isDigit( c ) )
+                return ( primitive == PRIMITIVE_INTEGER ) ? PRIMITIVE_INTEGER : PRIMITIVE_INVALID;
+            if ( c == '.' )
+                return PRIMITIVE_DOT;
+            return ( c == 'e' || c == 'E' ) ? PRIMITIVE_EXPONENT : PRIMITIVE_INVALID;
+
+        case PRIMITIVE_DOT:
+        case PRIMITIVE_FRACTION:
+            if ( isDigit( c ) )
+                return PRIMITIVE_FRACTION;
+            return ( primitive == PRIMITIVE_FRACTION && ( c == 'e' || c == 'E' ) ) ? PRIMITIVE_EXPONENT : PRIMITIVE_INVALID;
+
+        case PRIMITIVE_EXPONENT:
+        case PRIMITIVE_EXPONENT_SIGN:
+        case PRIMITIVE_EXPONENT_DIGITS:
+            if ( primitive == PRIMITIVE_EXPONENT && ( c == '+' || c == '-' ) )
+                return PRIMITIVE_EXPONENT_SIGN;
+            return isDigit( c ) ? PRIMITIVE_EXPONENT_DIGITS : PRIMITIVE_INVALID;
+
+        default:
+            literal = primitive / PRIMITIVE_LITERAL - 1;
+            if ( !c || c != literals[ literal ][ primitive % PRIMITIVE_LITERAL ] )
+                return PRIMITIVE_INVALID;
+            return (uint8_t) ( primitive + 1 );
+    }
+}
+
+static int isPrimitiveComplete( uint8_t primitive )
+{
+    switch ( primitive )
+    {
+        case PRIMITIVE_ZERO:
+        case PRIMITIVE_INTEGER:
+        case PRIMITIVE_FRACTION:
+        case PRIMITIVE_EXPONENT_DIGITS:
+            return 1;
+        default:
+            return primitive >= PRIMITIVE_LITERAL &&
+                   !literals[ primitive / PRIMITIVE_LITERAL - 1 ][ primitive % PRIMITIVE_LITERAL ];
+    }
+}
+
+static int isDigit( char c )
+{
+    return c >= '0' && c <= '9';
+}
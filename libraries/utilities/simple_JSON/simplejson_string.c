@@ -0,0 +1,302 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "simplejson.h"
+#include <string.h>
+
+// Same selection as simplejson_scan.c: word-at-a-time unless forced to scalar
+#if !defined( SIMPLE_JSON_SCALAR )
+#if UINTPTR_MAX > 0xFFFFFFFFu && !defined( SIMPLE_JSON_SWAR32 )
+typedef uint64_t word_t;
+#else
+typedef uint32_t word_t;
+#endif
+
+#define WORD_ONES            ( (word_t) -1 / 0xFF )
+#define WORD_HIGHS           ( WORD_ONES * 0x80 )
+#define WORD_BYTE( c )       ( WORD_ONES * (uint8_t) ( c ) )
+#define WORD_HAS_LESS( x, n ) ( ( ( x ) - WORD_BYTE( n ) ) & ~( x ) & WORD_HIGHS )
+#define WORD_HAS( x, c )     WORD_HAS_LESS( ( x ) ^ WORD_BYTE( c ), 1 )
+#endif
+
+// Helper functions
+static size_t utf8Sequence( const unsigned char *data, size_t available );
+static int readHex4( const unsigned char *data, size_t available, unsigned long *value );
+static size_t encodeUtf8( unsigned long codePoint, char *buffer );
+
+int simpleJsonDecodeString( const char *data, size_t length, char *buffer, size_t size )
+{
+    const unsigned char *in = (const unsigned char *) data;
+    size_t pos = 0;
+    size_t out = 0;
+    size_t capacity;
+
+    if ( !buffer || !size )
+        return SIMPLE_JSON_ERROR_NOMEM;
+    if ( !data && length )
+        goto FAIL;
+    capacity = size - 1;
+
+    while ( pos < length )
+    {
+        unsigned long codePoint;
+        size_t sequence;
+        char encoded[ 4 ];
+        size_t encodedLength;
+
+#if !defined( SIMPLE_JSON_SCALAR )
+        // Plain ASCII: no escape, no control character, no multi-byte sequence
+        while ( length - pos >= sizeof( word_t ) && capacity - out >= sizeof( word_t ) )
+        {
+            word_t word;
+            memcpy( &word, in + pos, sizeof( word ) );
+            if ( ( word & WORD_HIGHS ) | WORD_HAS_LESS( word, 0x20 ) | WORD_HAS( word, '\\' ) )
+                break;
+            memcpy( buffer + out, in + pos, sizeof( word ) );
+            pos += sizeof( word );
+            out += sizeof( word );
+        }
+        if ( pos >= length )
+            break;
+#endif
+
+        if ( in[ pos ] >= 0x80 )
+        {
+            // Multi-byte sequences are validated and copied as they are
+            sequence = utf8Sequence( in + pos, length - pos );
+            if ( !sequence )
+                goto FAIL;
+            if ( capacity - out < sequence )
+                goto NOMEM;
+            memcpy( buffer + out, in + pos, sequence );
+            pos += sequence;
+            out += sequence;
+            continue;
+        }
+
+        if ( in[ pos ] < 0x20 )
+            goto FAIL;
+
+        if ( in[ pos ] != '\\' )
+        {
+            if ( out >= capacity )
+                goto NOMEM;
+            buffer[ out++ ] = (char) in[ pos++ ];
+            continue;
+        }
+
+        if ( length - pos < 2 )
+            goto FAIL;
+        switch ( in[ pos + 1 ] )
+        {
+            case '\"': codePoint = '\"'; break;
+            case '\\': codePoint = '\\'; break;
+            case '/':  codePoint = '/';  break;
+            case 'b':  codePoint = '\b'; break;
+            case 'f':  codePoint = '\f'; break;
+            case 'n':  codePoint = '\n'; break;
+            case 'r':  codePoint = '\r'; break;
+            case 't':  codePoint = '\t'; break;
+            case 'u':
+                if ( !readHex4( in + pos + 2, length - pos - 2, &codePoint ) || !codePoint )
+                    goto FAIL;
+                if ( codePoint >= 0xDC00 && codePoint <= 0xDFFF )
+                    goto FAIL;
+                if ( codePoint >= 0xD800 && codePoint <= 0xDBFF )
+                {
+                    // A high surrogate must be followed by an escaped low surrogate
+                    unsigned long low;
+                    if ( length - pos < 12 || in[ pos + 6 ] != '\\' || in[ pos + 7 ] != 'u' ||
+                         !readHex4( in + pos + 8, length - pos - 8, &low ) || low < 0xDC00 || low > 0xDFFF )
+                        goto FAIL;
+                    codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( low - 0xDC00 );
+                    pos += 6;
+                }
+                pos += 4;
+                break;
+            default:
+                goto FAIL;
+        }
+        pos += 2;
+
+        encodedLength = encodeUtf8( codePoint, encoded );
+        if ( capacity - out < encodedLength )
+            goto NOMEM;
+        memcpy( buffer + out, encoded, encodedLength );
+        out += encodedLength;
+    }
+
+    buffer[ out ] = 0;
+    return (int) out;
+
+    NOMEM: buffer[ out ] = 0;
+    return SIMPLE_JSON_ERROR_NOMEM;
+
+    FAIL: buffer[ 0 ] = 0;
+    return SIMPLE_JSON_ERROR_INVALID;
+}
+
+int simpleJsonValidateUtf8( const char *data, size_t length )
+{
+    const unsigned char *in = (const unsigned char *) data;
+    size_t pos = 0;
+
+    while ( pos < length )
+    {
+        size_t sequence;
+
+#if !defined( SIMPLE_JSON_SCALAR )
+        while ( length - pos >= sizeof( word_t ) )
+        {
+            word_t word;
+            memcpy( &word, in + pos, sizeof( word ) );
+            if ( word & WORD_HIGHS )
+                break;
+            pos += sizeof( word );
+        }
+        if ( pos >= length )
+            break;
+#endif
+        if ( in[ pos ] < 0x80 )
+        {
+            ++pos;
+            continue;
+        }
+        sequence = utf8Sequence( in + pos, length - pos );
+        if ( !sequence )
+            return 0;
+        pos += sequence;
+    }
+    return 1;
+}
+
+int simpleJsonUnescape( const simple_json_value_t *value, char *buffer, size_t size )
+{
+    int length;
+
+    if ( !value || !value->data || !buffer || !size )
+        return -1;
+
+    if ( value->type != SIMPLE_JSON_STRING )
+    {
+        if ( value->length >= size )
+        {
+            buffer[ 0 ] = 0;
+            return -1;
+        }
+        memcpy( buffer, value->data, value->length );
+        buffer[ value->length ] = 0;
+        return (int) value->length;
+    }
+
+    length = simpleJsonDecodeString( value->data, value->length, buffer, size );
+    if ( length < 0 )
+    {
+        buffer[ 0 ] = 0;
+        return -1;
+    }
+    return length;
+}
+
+// Length of the UTF-8 sequence at data, or 0 if it is not valid
+static size_t utf8Sequence( const unsigned char *data, size_t available )
+{
+    unsigned char c = data[ 0 ];
+    size_t length;
+    size_t i;
+
+    if ( c < 0x80 )
+        return 1;
+    if ( c < 0xC2 )
+        return 0;   // continuation byte or overlong 2-byte form
+    else if ( c < 0xE0 )
+        length = 2;
+    else if ( c < 0xF0 )
+        length = 3;
+    else if ( c < 0xF5 )
+        length = 4;
+    else
+        return 0;
+
+    if ( available < length )
+        return 0;
+    for ( i = 1; i < length; ++i )
+    {
+        if ( ( data[ i ] & 0xC0 ) != 0x80 )
+            return 0;
+    }
+
+    // Overlong forms, surrogates and code points above U+10FFFF
+    if ( ( c == 0xE0 && data[ 1 ] < 0xA0 ) || ( c == 0xED && data[ 1 ] >= 0xA0 ) ||
+         ( c == 0xF0 && data[ 1 ] < 0x90 ) || ( c == 0xF4 && data[ 1 ] >= 0x90 ) )
+        return 0;
+    return length;
+}
+
+static int readHex4( const unsigned char *data, size_t available, unsigned long *value )
+{
+    size_t i;
+
+    if ( available < 4 )
+        return 0;
+    *value = 0;
+    for ( i = 0; i < 4; ++i )
+    {
+        unsigned char c = data[ i ];
+        unsigned long digit;
+
+        if ( c >= '0' && c <= '9' )
+            digit = c - '0';
+        else if ( ( c | 0x20 ) >= 'a' && ( c | 0x20 ) <= 'f' )
+            digit = ( c | 0x20 ) - 'a' + 10;
+        else
+            return 0;
+        *value = ( *value << 4 ) | digit;
+    }
+    return 1;
+}
+
+static size_t encodeUtf8( unsigned long codePoint, char *buffer )
+{
+    if ( codePoint < 0x80 )
+    {
+        buffer[ 0 ] = (char) codePoint;
+        return 1;
+    }
+    if ( codePoint < 0x800 )
+    {
+        buffer[ 0 ] = (char) ( 0xC0 | ( codePoint >> 6 ) );
+        buffer[ 1 ] = (char) ( 0x80 | ( codePoint & 0x3F ) );
+        return 2;
+    }
+    if ( codePoint < 0x10000 )
+    {
+        buffer[ 0 ] = (char) ( 0xE0 | ( codePoint >> 12 ) );
+        buffer[ 1 ] = (char) ( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+        buffer[ 2 ] = (char) ( 0x80 | ( codePoint & 0x3F ) );
+        return 3;
+    }
+    buffer[ 0 ] = (char) ( 0xF0 | ( codePoint >> 18 ) );
+    buffer[ 1 ] = (char) ( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+    buffer[ 2 ] = (char) ( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+    buffer[ 3 ] = (char) ( 0x80 | ( codePoint & 0x3F ) );
+    return 4;
+}
@@ -0,0 +1,365 @@
+/*
+ *  Copyright (c) 2015, Parse, LLC. All rights reserved.
+ *
+ *  You are hereby granted a non-exclusive, worldwide, royalty-free license to use,
+ *  copy, modify, and distribute this software in source code or binary form for use
+ *  in connection with the web services and APIs provided by Parse.
+ *
+ *  As with any software that integrates with the Parse platform, your use of
+ *  this software is subject to the Parse Terms of Service
+ *  [https://www.parse.com/about/terms]. This copyright notice shall be
+ *  included in all copies or substantial portions of the software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ *  FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ *  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ *  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ *  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "simplejson.h"
+#include <string.h>
+
+// Helper functions
+static void put( simple_json_writer_t *writer, const char *data, size_t length );
+static void putChar( simple_json_writer_t *writer, char c );
+static void putEscaped( simple_json_writer_t *writer, const char *value, size_t length );
+static void putUnsigned( simple_json_writer_t *writer, uint64_t value, int minDigits );
+static void beginValue( simple_json_writer_t *writer );
+static void startContainer( simple_json_writer_t *writer, char c );
+static void endContainer( simple_json_writer_t *writer, char c );
+static int flush( simple_json_writer_t *writer );
+
+void simpleJsonWriterInit( simple_json_writer_t *writer, char *buffer, size_t size )
+{
+    memset( writer, 0, sizeof( *writer ) );
+    writer->buffer = buffer;
+    writer->size = buffer ? size : 0;
+    writer->first = 1;
+    if ( buffer && size )
+        buffer[ 0 ] = 0;
+}
+
+void simpleJsonWriterInitSink( simple_json_writer_t *writer, simple_json_sink_t sink, void *context, char *buffer, size_t size )
+{
+    simpleJsonWriterInit( writer, buffer, size );
+    writer->sink = sink;
+    writer->context = context;
+}
+
+void simpleJsonWriteStartObject( simple_json_writer_t *writer )
+{
+    startContainer( writer, '{' );
+}
+
+void simpleJsonWriteEndObject( simple_json_writer_t *writer )
+{
+    endContainer( writer, '}' );
+}
+
+void simpleJsonWriteStartArray( simple_json_writer_t *writer )
+{
+    startContainer( writer, '[' );
+}
+
+void simpleJsonWriteEndArray( simple_json_writer_t *writer )
+{
+    endContainer( writer, ']' );
+}
+
+void simpleJsonWriteKey( simple_json_writer_t *writer, const char *key )
+{
+    beginValue( writer );
+    putChar( writer, '\"' );
+    putEscaped( writer, key, strlen( key ) );
+    put( writer, "\":", 2 );
+    writer->key = 1;
+}
+
+void simpleJsonWriteString( simple_json_writer_t *writer, const char *value )
+{
+    simpleJsonWriteStringN( writer, value, strlen( value ) );
+}
+
+void simpleJsonWriteStringN( simple_json_writer_t *writer, const char *value, size_t length )
+{
+    beginValue( writer );
+    putChar( writer, '\"' );
+    putEscaped( writer, value, length );
+    putChar( writer, '\"' );
+}
+
+void simpleJsonWriteInt( simple_json_writer_t *writer, int64_t value )
+{
+    beginValue( writer );
+    if ( value < 0 )
+    {
+        putChar( writer, '-' );
+        putUnsigned( writer, 0 - (uint64_t) value, 1 );
+    }
+    else
+    {
+        putUnsigned( writer, (uint64_t) value, 1 );
+    }
+}
+
+void simpleJsonWriteDouble( simple_json_writer_t *writer, double value )
+{
+    static const double scale = 1e6;  // 10 ^ SIMPLE_JSON_WRITER_DECIMALS
+    uint64_t integer;
+    uint64_t fraction;
+    int      exponent = 0;
+    int      digits   = SIMPLE_JSON_WRITER_DECIMALS;
+
+    // NaN and infinities have no JSON representation
+    if ( value != value || value > 1.7976931348623157e308 || value < -1.7976931348623157e308 )
+    {
+        simpleJsonWriteNull( writer );
+        return;
+    }
+
+    beginValue( writer );
+    if ( value < 0 )
+    {
+        putChar( writer, '-' );
+        value = -value;
+    }
+
+    // Scientific notation outside of the range where fixed point is exact enough
+    if ( value >= 1e15 )
+    {
+        for ( ; value >= 10.0; ++exponent )
+            value /= 10.0;
+    }
+    else if ( value != 0.0 && value < 1e-4 )
+    {
+        for ( ; value < 1.0; --exponent )
+            value *= 10.0;
+    }
+
+    integer = (uint64_t) value;
+    fraction = (uint64_t) ( ( value - (double) integer ) * scale + 0.5 );
+    if ( fraction >= (uint64_t) scale )
+    {
+        ++integer;
+        fraction -= (uint64_t) scale;
+    }
+    if ( exponent && integer >= 10 )
+    {
+        integer /= 10;
+        ++exponent;
+    }
+
+    putUnsigned( writer, integer, 1 );
+    if ( fraction )
+    {
+        for ( ; fraction % 10 == 0; --digits )
+            fraction /= 10;
+        putChar( writer, '.' );
+        putUnsigned( writer, fraction, digits );
+    }
+    if ( exponent )
+    {
+        putChar( writer, 'e' );
+        if ( exponent < 0 )
+        {
+            putChar( writer, '-' );
+            exponent = -exponent;
+        }
+        putUnsigned( writer, (uint64_t) exponent, 1 );
+    }
+}
+
+void simpleJsonWriteBool( simple_json_writer_t *writer, int value )
+{
+    beginValue( writer );
+    if ( value )
+        put( writer, "true", 4 );
+    else
+        put( writer, "false", 5 );
+}
+
+void simpleJsonWriteNull( simple_json_writer_t *writer )
+{
+    beginValue( writer );
+    put( writer, "null", 4 );
+}
+
+void simpleJsonWriteRaw( simple_json_writer_t *writer, const char *json, size_t length )
+{
+    beginValue( writer );
+    put( writer, json, length );
+}
+
+int simpleJsonWriterFinish( simple_json_writer_t *writer )
+{
+    if ( writer->depth || writer->key )
+        writer->error = SIMPLE_JSON_ERROR_INVALID;
+
+    if ( writer->sink )
+    {
+        if ( flush( writer ) )
+            writer->error = SIMPLE_JSON_ERROR_NOMEM;
+    }
+    else if ( writer->buffer && writer->size )
+    {
+        writer->buffer[ writer->used ] = 0;
+    }
+
+    if ( writer->error )
+        return writer->error;
+    return (int) writer->length;
+}
+
+static void put( simple_json_writer_t *writer, const char *data, size_t length )
+{
+    writer->length += length;
+    if ( writer->error )
+        return;
+
+    // Measuring, or unbuffered sink
+    if ( !writer->buffer )
+    {
+        if ( writer->sink && length && writer->sink( writer->context, data, length ) )
+            writer->error = SIMPLE_JSON_ERROR_NOMEM;
+        return;
+    }
+
+    while ( length )
+    {
+        // Keep room for the NULL terminator when writing to a plain buffer
+        size_t capacity = ( writer->sink || !writer->size ) ? writer->size : writer->size - 1;
+        size_t space    = capacity - writer->used;
+
+        if ( !space )
+        {
+            if ( !writer->sink || flush( writer ) )
+            {
+                writer->error = SIMPLE_JSON_ERROR_NOMEM;
+                return;
+            }
+            continue;
+        }
+        if ( space > length )
+            space = length;
+        memcpy( writer->buffer + writer->used, data, space );
+        writer->used += space;
+        data += space;
+        length -= space;
+    }
+}
+
+static void putChar( simple_json_writer_t *writer, char c )
+{
+    put( writer, &c, 1 );
+}
+
+static void putEscaped( simple_json_writer_t *writer, const char *value, size_t length )
+{
+    static const char hex[] = "0123456789abcdef";
+    size_t start = 0;
+    size_t pos;
+
+    for ( pos = 0; pos < length; ++pos )
+    {
+        unsigned char c = (unsigned char) value[ pos ];
+        char escape[ 6 ];
+        size_t escapeLength = 2;
+
+        if ( c >= 0x20 && c != '\"' && c != '\\' )
+            continue;
+
+        // Copy the run of plain characters in one go
+        put( writer, value + start, pos - start );
+        start = pos + 1;
+
+        escape[ 0 ] = '\\';
+        switch ( c )
+        {
+            case '\"': escape[ 1 ] = '\"'; break;
+            case '\\': escape[ 1 ] = '\\'; break;
+            case '\b': escape[ 1 ] = 'b';  break;
+            case '\f': escape[ 1 ] = 'f';  break;
+            case '\n': escape[ 1 ] = 'n';  break;
+            case '\r': escape[ 1 ] = 'r';  break;
+            case '\t': escape[ 1 ] = 't';  break;
+            default:
+                escape[ 1 ] = 'u';
+                escape[ 2 ] = '0';
+                escape[ 3 ] = '0';
+                escape[ 4 ] = hex[ c >> 4 ];
+                escape[ 5 ] = hex[ c & 0xf ];
+                escapeLength = 6;
+                break;
+        }
+        put( writer, escape, escapeLength );
+    }
+    put( writer, value + start, length - start );
+}
+
+static void putUnsigned( simple_json_writer_t *writer, uint64_t value, int minDigits )
+{
+    char digits[ 20 ];
+    int  count = 0;
+
+    do
+    {
+        digits[ sizeof( digits ) - 1 - count++ ] = (char) ( '0' + value % 10 );
+        value /= 10;
+    } while ( value || count < minDigits );
+
+    put( writer, digits + sizeof( digits ) - count, (size_t) count );
+}
+
+static void beginValue( simple_json_writer_t *writer )
+{
+    uint32_t bit = 1UL << writer->depth;
+
+    if ( writer->key )
+    {
+        writer->key = 0;
+        return;
+    }
+    if ( !writer->depth )
+        return;
+    if ( writer->first & bit )
+        writer->first &= ~bit;
+    else
+        putChar( writer, ',' );
+}
+
+static void startContainer( simple_json_writer_t *writer, char c )
+{
+    beginValue( writer );
+    putChar( writer, c );
+    if ( writer->depth + 1 >= SIMPLE_JSON_WRITER_MAX_DEPTH )
+    {
+        writer->error = SIMPLE_JSON_ERROR_INVALID;
+        return;
+    }
+    ++writer->depth;
+    writer->first |= 1UL << writer->depth;
+}
+
+static void endContainer( simple_json_writer_t *writer, char c )
+{
+    if ( !writer->depth )
+    {
+        writer->error = SIMPLE_JSON_ERROR_INVALID;
+        return;
+    }
+    --writer->depth;
+    putChar( writer, c );
+}
+
+static int flush( simple_json_writer_t *writer )
+{
+    int result = 0;
+
+    if ( writer->used )
+        result = writer->sink( writer->context, writer->buffer, writer->used );
+    writer->used = 0;
+    return result;
+}
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Compact time series encoding
+ *
+ * A sample is turned into codes and measured before it is written, so that
+ * a stream that is out of room is left as it was. Bits are written a byte at
+ * a time and a byte is cleared when it is started, so the buffer needs no
+ * clearing beforehand.
+ */
+
+#include "time_series.h"
+#include <string.h>
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define NO_WINDOW       ( 32 )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/* A sample as codes, up to four fields of at most 32 bits */
+typedef struct
+{
+    uint32_t value[ 4 ];
+    uint8_t  length[ 4 ];
+    uint8_t  count;
+    uint8_t  bits;
+} time_series_codes_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void     add_code   ( time_series_codes_t* codes, uint32_t value, uint8_t length );
+static void     put_bits   ( time_series_encoder_t* encoder, uint32_t value, uint8_t length );
+static uint32_t float_bits ( float value );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const char base64_alphabet[ ] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+void time_series_encoder_init( time_series_encoder_t* encoder, uint8_t* buffer, uint32_t size )
+{
+    memset( encoder, 0, sizeof( *encoder ) );
+    encoder->buffer   = buffer;
+    encoder->size     = buffer ? size : 0;
+    encoder->leading  = NO_WINDOW;
+    encoder->trailing = NO_WINDOW;
+}
+
+wiced_result_t time_series_encode( time_series_encoder_t* encoder, uint32_t time, float value )
+{
+    time_series_codes_t time_codes  = { .count = 0 };
+    time_series_codes_t value_codes = { .count = 0 };
+    uint32_t            bits        = float_bits( value );
+    uint32_t            delta       = time - encoder->time;
+    uint8_t             leading     = encoder->leading;
+    uint8_t             trailing    = encoder->trailing;
+    uint8_t             i;
+
+    if ( encoder->count == 0 )
+    {
+        delta = 0;
+        add_code( &value_codes, bits, 32 );
+    }
+    else
+    {
+        int32_t  delta_of_delta = (int32_t) ( delta - encoder->delta );
+        uint32_t xor            = bits ^ encoder->value;
+
+        if ( delta_of_delta == 0 )
+        {
+            add_code( &time_codes, 0x0, 1 );
+        }
+        else if ( delta_of_delta >= -64 && delta_of_delta <= 63 )
+        {
+            add_code( &time_codes, 0x2, 2 );
+            add_code( &time_codes, (uint32_t) delta_of_delta & 0x7F, 7 );
+        }
+        else if ( delta_of_delta >= -256 && delta_of_delta <= 255 )
+        {
+            add_code( &time_codes, 0x6, 3 );
+            add_code( &time_codes, (uint32_t) delta_of_delta & 0x1FF, 9 );
+        }
+        else if ( delta_of_delta >= -2048 && delta_of_delta <= 2047 )
+        {
+            add_code( &time_codes, 0xE, 4 );
+            add_code( &time_codes, (uint32_t) delta_of_delta & 0xFFF, 12 );
+        }
+        else
+        {
+            add_code( &time_codes, 0xF, 4 );
+            add_code( &time_codes, (uint32_t) delta_of_delta, 32 );
+        }
+
+        if ( xor == 0 )
+        {
+            add_code( &value_codes, 0x0, 1 );
+        }
+        else
+        {
+            uint8_t xor_leading  = (uint8_t) __builtin_clz( xor );
+            uint8_t xor_trailing = (uint8_t) __builtin_ctz( xor );
+
+            if ( leading != NO_WINDOW && xor_leading >= leading && xor_trailing >= trailing )
+            {
+                add_code( &value_codes, 0x2, 2 );
+                add_code( &value_codes, xor >> trailing, (uint8_t) ( 32 - leading - trailing ) );
+            }
+            else
+            {
+                leading  = xor_leading;
+                trailing = xor_trailing;
+                add_code( &value_codes, 0x3, 2 );
+                add_code( &value_codes, ( (uint32_t) leading << 5 ) | (uint32_t) ( 31 - leading - trailing ), 10 );
+                add_code( &value_codes, xor >> trailing, (uint8_t) ( 32 - leading - trailing ) );
+            }
+        }
+    }
+
+    if ( encoder->buffer != NULL && encoder->bits + time_codes.bits + value_codes.bits > encoder->size * 8 )
+    {
+        return WICED_BADARG;
+    }
+
+    for ( i = 0; i < time_codes.count; i++ )
+    {
+        put_bits( encoder, time_codes.value[ i ], time_codes.length[ i ] );
+    }
+    for ( i = 0; i < value_codes.count; i++ )
+    {
+        put_bits( encoder, value_codes.value[ i ], value_codes.length[ i ] );
+    }
+
+    encoder->count++;
+    encoder->time     = time;
+    encoder->delta    = delta;
+    encoder->value    = bits;
+    encoder->leading  = leading;
+    encoder->trailing = trailing;
+
+    return WICED_SUCCESS;
+}
+
+uint32_t time_series_encoder_length( const time_series_encoder_t* encoder )
+{
+    return ( encoder->bits + 7 ) / 8;
+}
+
+uint32_t time_series_base64( uint8_t* buffer, uint32_t length, uint32_t size )
+{
+    uint32_t text_length = TIME_SERIES_BASE64_LENGTH( length );
+    uint32_t group       = ( length + 2 ) / 3;
+
+    if ( text_length > size )
+    {
+        return 0;
+    }
+
+    /* The text of a group starts at or after its bytes and ends before the next
+     * group's text, so going from the last group nothing is overwritten unread */
+    while ( group-- > 0 )
+    {
+        uint32_t input = group * 3;
+        uint32_t left  = length - input;
+        uint32_t word  = (uint32_t) buffer[ input ] << 16;
+        uint8_t* text  = buffer + group * 4;
+
+        if ( left > 1 )
+        {
+            word |= (uint32_t) buffer[ input + 1 ] << 8;
+        }
+        if ( left > 2 )
+        {
+            word |= buffer[ input + 2 ];
+        }
+
+        text[ 0 ] = (uint8_t) base64_alphabet[ ( word >> 18 ) & 0x3F ];
+        text[ 1 ] = (uint8_t) base64_alphabet[ ( word >> 12 ) & 0x3F ];
+        text[ 2 ] = ( left > 1 ) ? (uint8_t) base64_alphabet[ ( word >> 6 ) & 0x3F ] : '=';
+        text[ 3 ] = ( left > 2 ) ? (uint8_t) base64_alphabet[ word & 0x3F ] : '=';
+    }
+
+    return text_length;
+}
+
+static void add_code( time_series_codes_t* codes, uint32_t value, uint8_t length )
+{
+    codes->value [ codes->count ] = value;
+    codes->length[ codes->count ] = length;
+    codes->count++;
+    codes->bits = (uint8_t) ( codes->bits + length );
+}
+
+static void put_bits( time_series_encoder_t* encoder, uint32_t value, uint8_t length )
+{
+    if ( encoder->buffer == NULL )
+    {
+        encoder->bits += length;
+        return;
+    }
+
+    while ( length > 0 )
+    {
+        uint8_t* byte  = &encoder->buffer[ encoder->bits >> 3 ];
+        uint8_t  space = (uint8_t) ( 8 - ( encoder->bits & 7 ) );
+        uint8_t  take  = ( length < space ) ? length : space;
+        uint8_t  chunk = (uint8_t) ( ( value >> ( length - take ) ) & ( ( 1u << take ) - 1 ) );
+
+        if ( space == 8 )
+        {
+            *byte = 0;
+        }
+        *byte |= (uint8_t) ( chunk << ( space - take ) );
+
+        encoder->bits += take;
+        length        = (uint8_t) ( length - take );
+    }
+}
+
+static uint32_t float_bits( float value )
+{
+    uint32_t bits;
+
+    memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
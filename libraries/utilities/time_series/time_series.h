@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+#include <stdint.h>
+#include "wiced_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @file
+ *
+ * Compact time series encoding
+ *
+ * Samples of a time and a float are packed in a bit stream, most significant
+ * bit first, in the way of Facebook's Gorilla: the first value takes 32 bits,
+ * then every sample writes the delta of delta of its time and the XOR of its
+ * value with the previous one. Regular sampling costs one bit for the time,
+ * an unchanged value one bit, a slowly changing one a dozen or so.
+ *
+ * Times are decoded as offsets from the first sample:
+ *
+ *     0                        delta of delta is 0
+ *     10   + 7 bits            -64 to 63, two's complement
+ *     110  + 9 bits            -256 to 255
+ *     1110 + 12 bits           -2048 to 2047
+ *     1111 + 32 bits           anything else
+ *
+ * Values are the bits of IEEE 754 single precision floats:
+ *
+ *     0                        same value as the previous sample
+ *     10   + n bits            XOR inside the window of the last 11 code,
+ *                              n = 32 - leading - trailing
+ *     11   + 5 bits leading zeros, 5 bits length - 1, length bits of the XOR
+ *
+ * The stream is padded with zero bits to a byte, so the number of samples
+ * has to be known to decode it. tools/time_series has the Python and
+ * JavaScript decoders.
+ */
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+/* Largest stream of count samples, in bytes */
+#define TIME_SERIES_MAX_BYTES( count )      ( ( 32 + ( count ) * 80 + 7 ) / 8 )
+
+/* Length of the base64 text of length bytes, without a terminator */
+#define TIME_SERIES_BASE64_LENGTH( length ) ( ( ( ( length ) + 2 ) / 3 ) * 4 )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/* Encoder state. A copy with a NULL buffer measures the next sample without writing it */
+typedef struct
+{
+    uint8_t* buffer;    /* NULL to only count the bits */
+    uint32_t size;
+    uint32_t bits;      /* Bits of the stream */
+    uint32_t count;     /* Samples encoded */
+    uint32_t time;      /* Of the last sample */
+    uint32_t delta;     /* From the sample before it to the last one */
+    uint32_t value;     /* Bits of the last value */
+    uint8_t  leading;   /* Window of the last 11 code, 32 before there is one */
+    uint8_t  trailing;
+} time_series_encoder_t;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Starts a stream.
+ *
+ * @param[out] encoder : Encoder state
+ * @param[in]  buffer  : Output, or NULL to only measure the stream
+ * @param[in]  size    : Bytes of the output, TIME_SERIES_MAX_BYTES() is always enough
+ */
+void time_series_encoder_init( time_series_encoder_t* encoder, uint8_t* buffer, uint32_t size );
+
+/**
+ * Appends a sample.
+ *
+ * @param[in] encoder : Encoder state
+ * @param[in] time    : Time of the sample, in any unit; differences wrap at 32 bits
+ * @param[in] value   : The sample
+ *
+ * @return WICED_SUCCESS, or WICED_BADARG if it does not fit the output. The stream is
+ *         then unchanged
+ */
+wiced_result_t time_series_encode( time_series_encoder_t* encoder, uint32_t time, float value );
+
+/**
+ * @return Bytes of the stream, with the last one padded
+ */
+uint32_t time_series_encoder_length( const time_series_encoder_t* encoder );
+
+/**
+ * Replaces length bytes at the start of a buffer with their base64 text,
+ * padded with '=' and not NULL terminated. It works from the end of the
+ * buffer backwards, so no other memory is used.
+ *
+ * @param[in] buffer : The bytes, and the text on return
+ * @param[in] length : Number of bytes
+ * @param[in] size   : Size of the buffer, at least TIME_SERIES_BASE64_LENGTH( length )
+ *
+ * @return Length of the text, or 0 if the buffer is too small
+ */
+uint32_t time_series_base64( uint8_t* buffer, uint32_t length, uint32_t size );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
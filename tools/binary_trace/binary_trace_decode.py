@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Decode a binary trace dumped by binary_trace_dump() or binary_trace_print_hex().
+
+Usage:
+    binary_trace_decode.py trace.bin
+    binary_trace_decode.py console.log
+    binary_trace_decode.py --events my_trace_events.h --macro MY_TRACE_EVENTS trace.bin
+
+The input is either the raw dump or console text holding the "trace <hex>"
+lines written by binary_trace_print_hex(); other console lines are ignored.
+Event names and formats come from the X-macro table of the traced library,
+by default libraries/protocols/parse/parse_trace_events.h. Layouts must match
+binary_trace_header_t and binary_trace_record_t in binary_trace.h.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x43525442
+VERSION = 1
+INVALID_ID = 0xFFFF
+
+HEADER = struct.Struct("<IHHIII")
+RECORD = struct.Struct("<IHH3I")
+
+REPO = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+DEFAULT_EVENTS = os.path.join(REPO, "libraries", "protocols", "parse", "parse_trace_events.h")
+
+EVENT_RE = re.compile(r'EVENT\(\s*(\w+)\s*,\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+FORMAT_RE = re.compile(r"%([%dux])")
+
+
+def load_events(path, macro):
+    with open(path) as f:
+        text = f.read()
+    match = re.search(r"#define\s+%s\s*\(" % re.escape(macro), text)
+    if not match:
+        raise SystemExit("%s: no %s table" % (path, macro))
+    # The table ends at the first line without a continuation
+    table = []
+    for line in text[match.start():].splitlines():
+        table.append(line)
+        if not line.rstrip().endswith("\\"):
+            break
+    table = "\n".join(table)
+    return [(name, level, fmt.encode().decode("unicode_escape")) for name, level, fmt in EVENT_RE.findall(table)]
+
+
+def read_dump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] == struct.pack("<I", MAGIC):
+        return data
+    # Console capture, keep the hex of the trace lines
+    hexdump = []
+    for line in data.decode("latin-1").splitlines():
+        match = re.search(r"\btrace ([0-9a-fA-F]+)\s*$", line)
+        if match:
+            hexdump.append(match.group(1))
+    return bytes.fromhex("".join(hexdump))
+
+
+def format_args(fmt, args):
+    values = iter(args)
+
+    def replace(match):
+        conversion = match.group(1)
+        if conversion == "%":
+            return "%"
+        value = next(values, 0)
+        if conversion == "d":
+            return str(value - (1 << 32) if value & 0x80000000 else value)
+        if conversion == "x":
+            return "%x" % value
+        return str(value)
+
+    return FORMAT_RE.sub(replace, fmt)
+
+
+def short_name(name):
+    # PARSE_TRACE_REQUEST_START prints as REQUEST_START
+    return name.split("_TRACE_", 1)[-1]
+
+
+def decode(data, events, out):
+    if len(data) < HEADER.size:
+        raise SystemExit("no trace header found")
+    magic, version, record_size, written, count, timestamp_ns = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        raise SystemExit("unsupported trace: magic %08x version %u record size %u" % (magic, version, record_size))
+
+    available = (len(data) - HEADER.size) // RECORD.size
+    if available < count:
+        out.write("warning: %u of %u records present\n" % (available, count))
+        count = available
+
+    out.write("%u events written, %u kept, %u overwritten\n" % (written, count, written - count))
+    out.write("%12s  %10s  %s\n" % ("time ms", "delta ms", "event"))
+
+    records = [RECORD.unpack_from(data, HEADER.size + i * RECORD.size) for i in range(count)]
+    valid = [r for r in records if r[1] != INVALID_ID]
+    base = valid[0][0] if valid else 0
+    previous = base
+    lost = 0
+
+    for index, (timestamp, event_id, sequence, a0, a1, a2) in enumerate(records):
+        if event_id == INVALID_ID:
+            # Overwritten or still being written while dumped
+            lost += 1
+            out.write("%12s  %10s  %-20s\n" % ("", "", "<lost>"))
+            continue
+        # Timestamps are 32-bit and wrap, differences stay correct
+        elapsed = ((timestamp - base) & 0xFFFFFFFF) * timestamp_ns / 1e6
+        delta = ((timestamp - previous) & 0xFFFFFFFF) * timestamp_ns / 1e6
+        previous = timestamp
+        if event_id < len(events):
+            name, _, fmt = events[event_id]
+            text = format_args(fmt, (a0, a1, a2))
+        else:
+            name = "EVENT_%u" % event_id
+            text = "%08x %08x %08x" % (a0, a1, a2)
+        out.write("%12.3f  %+10.3f  %-20s %s\n" % (elapsed, delta, short_name(name), text))
+
+    if lost:
+        out.write("%u records lost to concurrent writes\n" % lost)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a binary trace dump")
+    parser.add_argument("input", help="raw dump or console text with 'trace <hex>' lines")
+    parser.add_argument("--events", default=DEFAULT_EVENTS, help="header with the event table")
+    parser.add_argument("--macro", default="PARSE_TRACE_EVENTS", help="name of the event table X-macro")
+    args = parser.parse_args()
+
+    events = load_events(args.events, args.macro)
+    decode(read_dump(args.input), events, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Generate a perfect hash table of JSON keys for simpleJsonKeyLookup.
+
+Usage:
+    json_keyhash.py --name parse_keys --prefix PARSE_KEY -o parse_keys.h \\
+        objectId createdAt updatedAt ...
+
+The output header defines an enum with one id per key (in the order given,
+<PREFIX>_<KEY> with camelCase turned into UPPER_CASE) and a
+simple_json_key_table_t called <name>. Every key lands in its own slot, so a
+lookup is one hash and one compare. The hash below must match keyHash() in
+libraries/utilities/simple_JSON/simplejson.c.
+"""
+
+import argparse
+import re
+import sys
+
+FNV_PRIME = 0x01000193
+MASK32 = 0xFFFFFFFF
+MAX_SEEDS = 100000
+
+# Flags, same values as SIMPLE_JSON_KEY_HASH_* in simplejson.h
+HASH_SPARSE = 0
+HASH_FULL = 1
+
+
+def key_hash(seed, key, flags):
+    data = key.encode("utf-8")
+    h = (seed ^ len(data)) & MASK32
+    if flags == HASH_FULL:
+        positions = range(len(data))
+    elif data:
+        positions = (0, len(data) >> 1, len(data) - 1)
+    else:
+        positions = ()
+    for pos in positions:
+        h = ((h ^ data[pos]) * FNV_PRIME) & MASK32
+    return h ^ (h >> 16)
+
+
+def find_table(keys):
+    size = 1
+    while size < len(keys):
+        size <<= 1
+    # Sparse hashing first, as it only reads three characters
+    for flags in (HASH_SPARSE, HASH_FULL):
+        for table_size in (size, size * 2, size * 4):
+            mask = table_size - 1
+            for seed in range(MAX_SEEDS):
+                slots = {}
+                for key in keys:
+                    index = key_hash(seed, key, flags) & mask
+                    if index in slots:
+                        break
+                    slots[index] = key
+                else:
+                    return seed, mask, flags, slots
+    return None
+
+
+def identifier(prefix, key):
+    name = re.sub(r"([a-z0-9])([A-Z])", r"\1_\2", key)
+    name = re.sub(r"[^A-Za-z0-9]+", "_", name).strip("_").upper()
+    return "%s_%s" % (prefix, name)
+
+
+def c_string(key):
+    return '"%s"' % key.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def generate(name, prefix, keys, command):
+    found = find_table(keys)
+    if found is None:
+        sys.exit("json_keyhash: no perfect hash found, the key set is too large")
+    seed, mask, flags, slots = found
+
+    guard = "INCLUDED_%s_H_" % name.upper()
+    ids = [identifier(prefix, key) for key in keys]
+    width = max(len(i) for i in ids)
+    lines = [
+        "/*",
+        " * Generated by tools/json_keyhash/json_keyhash.py, do not edit.",
+        " * %s" % command,
+        " */",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        '#include "simplejson.h"',
+        "",
+        "typedef enum",
+        "{",
+    ]
+    for index, key in enumerate(keys):
+        lines.append("    %-*s = %d," % (width, ids[index], index))
+    lines.append("    %-*s = %d" % (width, "%s_COUNT" % prefix, len(keys)))
+    lines += [
+        "} %s_id_t;" % name,
+        "",
+        "static const simple_json_key_t %s_slots[ %d ] =" % (name, mask + 1),
+        "{",
+    ]
+    for index in range(mask + 1):
+        separator = "," if index < mask else ""
+        if index in slots:
+            key = slots[index]
+            lines.append("    SIMPLE_JSON_KEY( %s, %s )%s" % (c_string(key), identifier(prefix, key), separator))
+        else:
+            lines.append("    SIMPLE_JSON_KEY_EMPTY%s" % separator)
+    lines += [
+        "};",
+        "",
+        "static const simple_json_key_table_t %s =" % name,
+        "{",
+        "    0x%08xUL," % seed,
+        "    %d," % mask,
+        "    %s," % ("SIMPLE_JSON_KEY_HASH_FULL" if flags == HASH_FULL else "SIMPLE_JSON_KEY_HASH_SPARSE"),
+        "    %s_slots" % name,
+        "};",
+        "",
+        "#endif /* %s */" % guard,
+        "",
+    ]
+    return "\r\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--name", required=True, help="name of the generated table")
+    parser.add_argument("--prefix", required=True, help="prefix of the generated ids")
+    parser.add_argument("-o", "--output", help="output header, stdout by default")
+    parser.add_argument("keys", nargs="+")
+    args = parser.parse_args()
+
+    if len(set(args.keys)) != len(args.keys):
+        sys.exit("json_keyhash: duplicate keys")
+    if any(len(key.encode("utf-8")) > 255 for key in args.keys):
+        sys.exit("json_keyhash: keys are limited to 255 bytes")
+
+    command = "json_keyhash.py --name %s --prefix %s %s" % (args.name, args.prefix, " ".join(args.keys))
+    text = generate(args.name, args.prefix, args.keys, command)
+    if args.output:
+        with open(args.output, "w", newline="") as output:
+            output.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
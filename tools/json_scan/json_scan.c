@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Differential check and throughput benchmark of the simplejson scanners
+ *
+ * The scanner is chosen when simplejson_scan.c is compiled, so the Makefile
+ * builds this program once per implementation. "check" compares
+ * simpleJsonFindStructural(), simpleJsonFindStringSpecial() and
+ * simpleJsonFindStringControl() with a byte-at-a-time reference at every start
+ * offset of random buffers placed at every alignment, then parses random
+ * documents and prints a hash of the tokens and stream events, which must be
+ * the same for all implementations. "bench" prints the scanning throughput on
+ * the parse_bench corpus and on synthetic buffers.
+ */
+
+#include <dirent.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "simplejson.h"
+#include "simplejson_scan.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define DEFAULT_BUFFERS         ( 50000 )
+#define DEFAULT_DOCUMENTS       ( 60000 )
+#define MAX_BUFFER              ( 512 )
+#define MAX_ALIGNMENT           ( 64 )
+#define MAX_DOCUMENT            ( 4096 )
+#define MAX_TOKENS              ( 1024 )
+#define MAX_DEPTH               ( 6 )
+#define SYNTHETIC_SIZE          ( 64 * 1024 )
+#define BENCH_MIN_NS            ( 200e6 )
+#define FNV_OFFSET              ( 0xcbf29ce484222325ULL )
+#define FNV_PRIME               ( 0x100000001b3ULL )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    char*  data;
+    size_t size;
+    size_t length;
+} document_t;
+
+typedef size_t (*scan_function_t)( const char* data, size_t size, size_t pos );
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static int      check             ( unsigned long buffers, unsigned long documents );
+static int      check_buffer      ( const char* data, size_t size );
+static uint64_t check_documents   ( unsigned long documents );
+static int      stream_event      ( void* context, const simple_json_event_t* event );
+static void     bench             ( const char* corpus );
+static void     bench_buffer      ( const char* name, const char* data, size_t size );
+static double   bench_scan        ( scan_function_t scan, const char* data, size_t size );
+static size_t   reference_scan    ( const char* data, size_t size, size_t pos, const char* special, size_t count );
+static void     fill_random       ( char* data, size_t size );
+static void     write_value       ( document_t* document, int depth );
+static void     write_string      ( document_t* document );
+static void     append            ( document_t* document, const char* text, size_t length );
+static uint64_t hash              ( uint64_t value, const void* data, size_t size );
+static uint32_t next_random       ( void );
+static double   now_ns            ( void );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const char structural[ ] = { '"', '\\', '{', '}', '[', ']', ':', ',', 0 };
+static const char string_special[ ] = { '"', '\\', 0 };
+static const char string_control[ ] = { '"', '\\', 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 };
+
+static uint64_t random_state = 0x2015BC0DE5EEDULL;
+
+static volatile size_t bench_sink;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+int main( int argc, char** argv )
+{
+    unsigned long buffers   = DEFAULT_BUFFERS;
+    unsigned long documents = DEFAULT_DOCUMENTS;
+    const char*   corpus    = "../parse_bench/corpus";
+    int           arg;
+
+    for ( arg = 2; arg < argc; arg++ )
+    {
+        if ( strcmp( argv[ arg ], "-n" ) == 0 && arg + 1 < argc )
+        {
+            buffers = strtoul( argv[ ++arg ], NULL, 10 );
+        }
+        else if ( strcmp( argv[ arg ], "-d" ) == 0 && arg + 1 < argc )
+        {
+            documents = strtoul( argv[ ++arg ], NULL, 10 );
+        }
+        else if ( strcmp( argv[ arg ], "-s" ) == 0 && arg + 1 < argc )
+        {
+            random_state = strtoull( argv[ ++arg ], NULL, 0 ) | 1;
+        }
+        else if ( strcmp( argv[ arg ], "-c" ) == 0 && arg + 1 < argc )
+        {
+            corpus = argv[ ++arg ];
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if ( argc >= 2 && arg == argc && strcmp( argv[ 1 ], "check" ) == 0 )
+    {
+        return check( buffers, documents );
+    }
+    if ( argc >= 2 && arg == argc && strcmp( argv[ 1 ], "bench" ) == 0 )
+    {
+        bench( corpus );
+        return 0;
+    }
+
+    fprintf( stderr, "usage: %s check [-n buffers] [-d documents] [-s seed]\n"
+                     "       %s bench [-c corpus_dir]\n", argv[ 0 ], argv[ 0 ] );
+    return 2;
+}
+
+static int check( unsigned long buffers, unsigned long documents )
+{
+    static char   storage[ MAX_BUFFER + MAX_ALIGNMENT ];
+    unsigned long i;
+    uint64_t      tokens_hash;
+
+    for ( i = 0; i < buffers; i++ )
+    {
+        size_t size      = next_random( ) % ( MAX_BUFFER + 1 );
+        size_t alignment = next_random( ) % MAX_ALIGNMENT;
+
+        fill_random( storage + alignment, size );
+        if ( check_buffer( storage + alignment, size ) != 0 )
+        {
+            fprintf( stderr, "%s: mismatch in buffer %lu, %zu bytes at alignment %zu\n", simpleJsonScanner( ), i, size, alignment );
+            return 1;
+        }
+    }
+
+    tokens_hash = check_documents( documents );
+    printf( "%s: %lu buffers match the reference, parsing %lu documents hashes to %016" PRIx64 "\n",
+            simpleJsonScanner( ), buffers, documents, tokens_hash );
+
+    return 0;
+}
+
+static int check_buffer( const char* data, size_t size )
+{
+    size_t pos;
+
+    /* Every start offset, including the end of the buffer */
+    for ( pos = 0; pos <= size; pos++ )
+    {
+        size_t expected = reference_scan( data, size, pos, structural, sizeof( structural ) );
+        size_t found    = simpleJsonFindStructural( data, size, pos );
+
+        if ( found != expected )
+        {
+            fprintf( stderr, "simpleJsonFindStructural( pos %zu ) returned %zu, expected %zu\n", pos, found, expected );
+            return -1;
+        }
+
+        expected = reference_scan( data, size, pos, string_special, sizeof( string_special ) );
+        found    = simpleJsonFindStringSpecial( data, size, pos );
+        if ( found != expected )
+        {
+            fprintf( stderr, "simpleJsonFindStringSpecial( pos %zu ) returned %zu, expected %zu\n", pos, found, expected );
+            return -1;
+        }
+
+        expected = reference_scan( data, size, pos, string_control, sizeof( string_control ) );
+        found    = simpleJsonFindStringControl( data, size, pos );
+        if ( found != expected )
+        {
+            fprintf( stderr, "simpleJsonFindStringControl( pos %zu ) returned %zu, expected %zu\n", pos, found, expected );
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* The parsers on top of the scanners, their output must not depend on the implementation */
+static uint64_t check_documents( unsigned long documents )
+{
+    static char                storage[ MAX_DOCUMENT ];
+    static simple_json_token_t tokens[ MAX_TOKENS ];
+    simple_json_stream_t       stream;
+    uint64_t                   value = FNV_OFFSET;
+    unsigned long              i;
+
+    for ( i = 0; i < documents; i++ )
+    {
+        document_t document = { storage, sizeof( storage ), 0 };
+        int        count;
+        int        t;
+
+        /* Always a container at the top, a lone primitive says nothing about the scanners */
+        write_value( &document, -1 );
+        /* Truncate some, incomplete documents have to fail the same way everywhere */
+        if ( next_random( ) % 8 == 0 && document.length > 0 )
+        {
+            document.length = next_random( ) % document.length;
+        }
+
+        count = simpleJsonTokenize( document.data, document.length, tokens, MAX_TOKENS );
+        value = hash( value, &count, sizeof( count ) );
+        for ( t = 0; t < count; t++ )
+        {
+            uint32_t fields[ 5 ] = { tokens[ t ].type, tokens[ t ].size, tokens[ t ].next, tokens[ t ].start, tokens[ t ].end };
+
+            value = hash( value, fields, sizeof( fields ) );
+        }
+
+        count = isCompleteJson( document.data );
+        value = hash( value, &count, sizeof( count ) );
+
+        simpleJsonStreamInit( &stream, stream_event, &value );
+        count = simpleJsonStreamParse( &stream, document.data, document.length );
+        if ( count >= 0 )
+        {
+            count = simpleJsonStreamFinish( &stream );
+        }
+        value = hash( value, &count, sizeof( count ) );
+    }
+
+    return value;
+}
+
+static int stream_event( void* context, const simple_json_event_t* event )
+{
+    uint64_t* value       = (uint64_t*) context;
+    uint32_t  fields[ 4 ] = { event->type, (uint32_t) event->length, (uint32_t) event->partial, event->depth };
+
+    *value = hash( hash( *value, fields, sizeof( fields ) ), event->data, event->length );
+
+    return 0;
+}
+
+static void bench( const char* corpus )
+{
+    static char     synthetic[ SYNTHETIC_SIZE + 1 ];
+    struct dirent** entries;
+    int             count = scandir( corpus, &entries, NULL, alphasort );
+    int             e;
+    size_t          i;
+
+    printf( "scanner %s\n", simpleJsonScanner( ) );
+    printf( "%-28s %8s %18s %18s %18s\n", "buffer", "bytes", "structural GB/s", "string GB/s", "control GB/s" );
+
+    for ( e = 0; e < count; e++ )
+    {
+        struct dirent* entry  = entries[ e ];
+        size_t         length = strlen( entry->d_name );
+        char           path[ 512 ];
+        FILE*          input;
+        char*          data;
+        long           size;
+
+        if ( length < 6 || strcmp( entry->d_name + length - 5, ".json" ) != 0 )
+        {
+            continue;
+        }
+
+        snprintf( path, sizeof( path ), "%s/%s", corpus, entry->d_name );
+        input = fopen( path, "rb" );
+        if ( input == NULL )
+        {
+            continue;
+        }
+        if ( fseek( input, 0, SEEK_END ) != 0 || ( size = ftell( input ) ) <= 0 )
+        {
+            fclose( input );
+            continue;
+        }
+        rewind( input );
+        data = malloc( (size_t) size + 1 );
+        if ( data != NULL && fread( data, 1, (size_t) size, input ) == (size_t) size )
+        {
+            data[ size ] = 0;
+            bench_buffer( entry->d_name, data, (size_t) size );
+        }
+        free( data );
+        fclose( input );
+    }
+    for ( e = 0; e < count; e++ )
+    {
+        free( entries[ e ] );
+    }
+    if ( count >= 0 )
+    {
+        free( entries );
+    }
+
+    /* A long string value, the best case of both scans */
+    for ( i = 0; i < SYNTHETIC_SIZE; i++ )
+    {
+        synthetic[ i ] = (char) ( 'a' + i % 26 );
+    }
+    bench_buffer( "synthetic/text", synthetic, SYNTHETIC_SIZE );
+
+    /* A structural character every 16 bytes on average */
+    for ( i = 0; i < SYNTHETIC_SIZE; i++ )
+    {
+        synthetic[ i ] = ( next_random( ) % 16 == 0 ) ? structural[ next_random( ) % ( sizeof( structural ) - 1 ) ] : 'x';
+    }
+    bench_buffer( "synthetic/sparse", synthetic, SYNTHETIC_SIZE );
+}
+
+static void bench_buffer( const char* name, const char* data, size_t size )
+{
+    double structural_ns = bench_scan( simpleJsonFindStructural, data, size );
+    double string_ns     = bench_scan( simpleJsonFindStringSpecial, data, size );
+    double control_ns    = bench_scan( simpleJsonFindStringControl, data, size );
+
+    printf( "%-28s %8zu %18.2f %18.2f %18.2f\n", name, size, size / structural_ns, size / string_ns, size / control_ns );
+}
+
+/* Scans the whole buffer hit by hit, the way the parsers use the scanners; returns ns per pass */
+static double bench_scan( scan_function_t scan, const char* data, size_t size )
+{
+    unsigned long passes = 0;
+    double        start  = now_ns( );
+    double        elapsed;
+
+    do
+    {
+        size_t pos = 0;
+
+        while ( ( pos = scan( data, size, pos ) ) < size )
+        {
+            ++pos;
+        }
+        bench_sink += pos;
+        ++passes;
+        elapsed = now_ns( ) - start;
+    } while ( elapsed < BENCH_MIN_NS );
+
+    return elapsed / passes;
+}
+
+static size_t reference_scan( const char* data, size_t size, size_t pos, const char* special, size_t count )
+{
+    for ( ; pos < size; pos++ )
+    {
+        if ( memchr( special, data[ pos ], count ) != NULL )
+        {
+            return pos;
+        }
+    }
+
+    return size;
+}
+
+static void fill_random( char* data, size_t size )
+{
+    size_t i;
+    int    density = 1 + (int) ( next_random( ) % 64 );
+
+    /* From dense to sparse special characters, with bytes above 0x7F that break naive signed compares */
+    for ( i = 0; i < size; i++ )
+    {
+        uint32_t r = next_random( );
+
+        if ( (int) ( r % 64 ) < density )
+        {
+            data[ i ] = structural[ ( r >> 8 ) % sizeof( structural ) ];
+        }
+        else if ( ( r >> 8 ) % 8 == 0 )
+        {
+            data[ i ] = (char) ( 0x80 | ( r >> 16 ) );
+        }
+        else if ( ( r >> 8 ) % 8 == 1 )
+        {
+            data[ i ] = (char) ( ( r >> 16 ) % 0x21 );
+        }
+        else
+        {
+            data[ i ] = (char) ( ' ' + ( r >> 16 ) % 95 );
+        }
+    }
+}
+
+static void write_value( document_t* document, int depth )
+{
+    static const char* const primitives[ ] = { "0", "-12", "3.25", "1e9", "true", "false", "null" };
+    uint32_t                 kind          = ( depth < 0 ) ? 3 + next_random( ) % 2 : next_random( ) % ( depth < MAX_DEPTH ? 5 : 3 );
+    const char*              primitive;
+    uint32_t                 count;
+    uint32_t                 i;
+
+    switch ( kind )
+    {
+        case 0:
+        case 1:
+            write_string( document );
+            break;
+
+        case 2:
+            primitive = primitives[ next_random( ) % ( sizeof( primitives ) / sizeof( primitives[ 0 ] ) ) ];
+            append( document, primitive, strlen( primitive ) );
+            break;
+
+        case 3:
+            count = next_random( ) % 6;
+            append( document, "{ ", 1 + next_random( ) % 2 );
+            for ( i = 0; i < count; i++ )
+            {
+                if ( i > 0 )
+                {
+                    append( document, ",", 1 );
+                }
+                write_string( document );
+                append( document, " : ", 1 + 2 * ( next_random( ) % 2 ) );
+                write_value( document, depth + 1 );
+            }
+            append( document, "}", 1 );
+            break;
+
+        default:
+            count = next_random( ) % 6;
+            append( document, "[", 1 );
+            for ( i = 0; i < count; i++ )
+            {
+                if ( i > 0 )
+                {
+                    append( document, ", ", 1 + next_random( ) % 2 );
+                }
+                write_value( document, depth + 1 );
+            }
+            append( document, "]", 1 );
+            break;
+    }
+}
+
+static void write_string( document_t* document )
+{
+    static const char* const pieces[ ] = { "objectId", "a", "installation", "\\\"", "\\\\", "\\u00e9", "\\n", "{[:,]}", "caf\xc3\xa9", "0123456789abcdef0123456789abcdef", "\t" };
+    uint32_t                 count     = next_random( ) % 5;
+    uint32_t                 i;
+
+    append( document, "\"", 1 );
+    for ( i = 0; i < count; i++ )
+    {
+        const char* piece = pieces[ next_random( ) % ( sizeof( pieces ) / sizeof( pieces[ 0 ] ) ) ];
+
+        append( document, piece, strlen( piece ) );
+    }
+    append( document, "\"", 1 );
+}
+
+static void append( document_t* document, const char* text, size_t length )
+{
+    if ( document->length + length < document->size )
+    {
+        memcpy( document->data + document->length, text, length );
+        document->length += length;
+        document->data[ document->length ] = 0;
+    }
+}
+
+static uint64_t hash( uint64_t value, const void* data, size_t size )
+{
+    const uint8_t* bytes = (const uint8_t*) data;
+    size_t         i;
+
+    for ( i = 0; i < size; i++ )
+    {
+        value = ( value ^ bytes[ i ] ) * FNV_PRIME;
+    }
+
+    return value;
+}
+
+/* xorshift64*, the same sequence on every host so that hashes can be compared */
+static uint32_t next_random( void )
+{
+    random_state ^= random_state >> 12;
+    random_state ^= random_state << 25;
+    random_state ^= random_state >> 27;
+
+    return (uint32_t) ( ( random_state * 0x2545F4914F6CDD1DULL ) >> 32 );
+}
+
+static double now_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Compare two parse_bench result files.
+
+    compare.py [--threshold PERCENT] base.json new.json
+
+Prints the change in ns/op of every case present in both files and exits
+with status 1 if any case got slower by more than the threshold (5% by
+default). Small cases are noisy, re-run before trusting a single regression.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as source:
+        document = json.load(source)
+    return document, {result["name"]: result for result in document["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two parse_bench result files")
+    parser.add_argument("--threshold", type=float, default=5.0, help="regression threshold in percent")
+    parser.add_argument("base")
+    parser.add_argument("new")
+    args = parser.parse_args()
+
+    base_document, base = load(args.base)
+    new_document, new = load(args.new)
+
+    for field in ("scanner", "compiler"):
+        if base_document.get(field) != new_document.get(field):
+            print("note: %s differs: %s -> %s" % (field, base_document.get(field), new_document.get(field)))
+
+    print("%-56s %12s %12s %9s" % ("case (%s -> %s)" % (base_document["commit"], new_document["commit"]),
+                                   "base ns/op", "new ns/op", "change"))
+    regressions = []
+    for name, result in new.items():
+        if name not in base:
+            print("%-56s %12s %12.1f %9s" % (name, "-", result["ns_per_op"], "new"))
+            continue
+        before = base[name]["ns_per_op"]
+        after = result["ns_per_op"]
+        change = (after - before) * 100.0 / before if before else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = "  <-- slower"
+            regressions.append(name)
+        print("%-56s %12.1f %12.1f %+8.1f%%%s" % (name, before, after, change, marker))
+
+    for name in base:
+        if name not in new:
+            print("%-56s %12.1f %12s %9s" % (name, base[name]["ns_per_op"], "-", "removed"))
+
+    if regressions:
+        print("%d case(s) slower than the %.1f%% threshold" % (len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
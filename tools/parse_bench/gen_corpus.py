@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Regenerate the benchmark corpus in corpus/.
+
+The files mimic what the Parse REST API and push service send: error
+bodies, installation objects, query results and push notifications. The
+output is deterministic so the corpus only changes when this script does.
+"""
+
+import json
+import os
+import random
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+CORPUS = os.path.join(HERE, "corpus")
+
+rng = random.Random(2015)
+ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+
+
+def object_id():
+    return "".join(rng.choice(ALPHABET) for _ in range(10))
+
+
+def uuid():
+    h = "%032x" % rng.getrandbits(128)
+    return "%s-%s-4%s-a%s-%s" % (h[0:8], h[8:12], h[13:16], h[17:20], h[20:32])
+
+
+def timestamp():
+    return "2015-%02d-%02dT%02d:%02d:%02d.%03dZ" % (
+        rng.randint(1, 12), rng.randint(1, 28), rng.randint(0, 23),
+        rng.randint(0, 59), rng.randint(0, 59), rng.randint(0, 999))
+
+
+def installation():
+    return {
+        "GCMSenderId": "1076345567071",
+        "appIdentifier": "com.broadcom.wiced.parse",
+        "appName": "WICED Parse",
+        "appVersion": "1.0.%d" % rng.randint(0, 20),
+        "badge": rng.randint(0, 9),
+        "channels": ["", "sensors", "room-%d" % rng.randint(1, 40)],
+        "createdAt": timestamp(),
+        "deviceType": "embedded",
+        "installationId": uuid(),
+        "localeIdentifier": "en-US",
+        "objectId": object_id(),
+        "parseVersion": "1.0.0",
+        "pushType": "gcm",
+        "timeZone": "America/Los_Angeles",
+        "updatedAt": timestamp(),
+    }
+
+
+def query(size):
+    results = []
+    document = {"results": results, "count": 0}
+    while True:
+        results.append(installation())
+        document["count"] = len(results)
+        if len(dump(document)) >= size:
+            results.pop()
+            document["count"] = len(results)
+            return document
+
+
+def push(size):
+    alert = "Sensor room-%d: temperature above threshold \\u2103 \\ud83d\\udd25" % rng.randint(1, 40)
+    data = {"alert": alert, "sound": "default", "badge": "Increment", "title": "WICED"}
+    document = {"time": timestamp(), "oauth_key": object_id() * 4, "data": data, "push_id": object_id()}
+    index = 0
+    while len(dump(document)) < size:
+        data["reading%d" % index] = round(rng.uniform(-40, 125), 2)
+        index += 1
+    while len(dump(document)) > size and index:
+        index -= 1
+        del data["reading%d" % index]
+    return document
+
+
+def dump(document):
+    # The escapes above are already JSON, keep them as they are
+    return json.dumps(document, separators=(",", ":"), ensure_ascii=False).replace("\\\\u", "\\u")
+
+
+def main():
+    files = {
+        "error.json": {"code": 101, "error": "object not found for get: no installation matches installationId " + uuid()},
+        "installation.json": installation(),
+        "query_4k.json": query(4 * 1024),
+        "query_16k.json": query(16 * 1024),
+        "query_64k.json": query(64 * 1024),
+        "push_small.json": {"time": timestamp(), "data": {"alert": "Door opened", "sound": "default"}, "push_id": object_id()},
+        "push_1k.json": push(1024),
+        "push_4k.json": push(4 * 1024),
+        # Last, so that the documents above stay the same: the installation lookup response
+        "query_single.json": {"results": [installation()]},
+    }
+    os.makedirs(CORPUS, exist_ok=True)
+    for name, document in sorted(files.items()):
+        with open(os.path.join(CORPUS, name), "w", newline="\n") as output:
+            output.write(dump(document))
+            output.write("\n")
+
+
+if __name__ == "__main__":
+    main()
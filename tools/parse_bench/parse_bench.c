@@ -0,0 +1,596 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Host benchmark of the simplejson and parse_http hot paths
+ *
+ * Every case is calibrated to run for a minimum time, then measured over
+ * several rounds; the median round is reported as ns/op, MB/s and cycles/op
+ * (TSC ticks on x86, virtual counter ticks on AArch64, 0 elsewhere).
+ */
+
+/* buildRequestHeaders is static, so the library source is compiled in */
+#include "parse_internal.c"
+#include "simplejson_scan.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#ifndef BENCH_COMMIT
+#define BENCH_COMMIT "unknown"
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define MAX_FILES      ( 32 )
+#define MAX_CASES      ( 256 )
+#define ROUNDS         ( 5 )
+#define DEFAULT_MIN_MS ( 200 )
+#define MAX_TOKENS     ( 8192 )
+
+static const char http_response_headers[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Access-Control-Allow-Methods: *\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Content-Type: application/json; charset=utf-8\r\n"
+    "Date: Mon, 13 Apr 2015 17:11:22 GMT\r\n"
+    "Server: nginx/1.6.0\r\n"
+    "X-Parse-Platform: G1\r\n"
+    "X-Runtime: 0.012416\r\n"
+    "Content-Length: %u\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+typedef struct bench_case bench_case_t;
+typedef void (*bench_function_t)( const bench_case_t* bench );
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    char   name[ 64 ];
+    char*  data;        /* the JSON document, NULL terminated */
+    size_t size;
+    char*  pair;        /* the document twice, as on the push connection */
+    char*  response;    /* the document as an HTTP response */
+    char   last_key[ 64 ];
+    int    tokens;      /* simpleJsonTokenize result, < 0 if it does not fit MAX_TOKENS */
+    int    results;     /* a query result, with objectId and installationId in results[0] */
+} corpus_file_t;
+
+struct bench_case
+{
+    char                 name[ 96 ];
+    size_t               bytes;
+    bench_function_t     function;
+    const corpus_file_t* file;
+    const char*          verb;
+    const char*          path;
+    parse_json_body_t    json_body;
+    double               ns_per_op;
+    double               cycles_per_op;
+    unsigned long        iterations;
+};
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void     bench_processor      ( const bench_case_t* bench );
+static void     bench_second_json    ( const bench_case_t* bench );
+static void     bench_complete_json  ( const bench_case_t* bench );
+static void     bench_push_json      ( const bench_case_t* bench );
+static void     bench_response_status( const bench_case_t* bench );
+static void     bench_response_body  ( const bench_case_t* bench );
+static void     bench_request        ( const bench_case_t* bench );
+static void     bench_tokenize       ( const bench_case_t* bench );
+static void     bench_token_find     ( const bench_case_t* bench );
+static void     bench_token_lookup   ( const bench_case_t* bench );
+static void     bench_query_lookup   ( const bench_case_t* bench );
+static int      load_corpus          ( const char* directory );
+static void     add_case             ( const char* name, size_t bytes, bench_function_t function, const corpus_file_t* file );
+static void     measure              ( bench_case_t* bench, double min_ns );
+static double   now_ns               ( void );
+static uint64_t now_cycles           ( void );
+static int      write_results        ( const char* path );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static corpus_file_t files[ MAX_FILES ];
+static unsigned int  file_count;
+static bench_case_t  cases[ MAX_CASES ];
+static unsigned int  case_count;
+static parse_client_t bench_client;
+static simple_json_token_t bench_tokens[ MAX_TOKENS ];
+
+/* Results go here so the compiler cannot drop the work */
+static volatile uintptr_t bench_sink;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+int main( int argc, char** argv )
+{
+    const char*  directory = "corpus";
+    const char*  output    = NULL;
+    const char*  filter    = NULL;
+    double       min_ms    = DEFAULT_MIN_MS;
+    unsigned int i;
+    int          arg;
+
+    for ( arg = 1; arg < argc; arg++ )
+    {
+        if ( strcmp( argv[ arg ], "-o" ) == 0 && arg + 1 < argc )
+        {
+            output = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-f" ) == 0 && arg + 1 < argc )
+        {
+            filter = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-m" ) == 0 && arg + 1 < argc )
+        {
+            min_ms = atof( argv[ ++arg ] );
+        }
+        else if ( argv[ arg ][ 0 ] != '-' )
+        {
+            directory = argv[ arg ];
+        }
+        else
+        {
+            fprintf( stderr, "usage: %s [-o results.json] [-f filter] [-m min_ms_per_case] [corpus_dir]\n", argv[ 0 ] );
+            return 2;
+        }
+    }
+
+    if ( load_corpus( directory ) != 0 )
+    {
+        return 1;
+    }
+
+    strcpy( bench_client.app_id, "aBcDeFgHiJkLmNoPqRsTuVwXyZ0123456789aBcD" );
+    strcpy( bench_client.client_key, "0123456789aBcDeFgHiJkLmNoPqRsTuVwXyZaBcD" );
+    strcpy( bench_client.installation_id, "1f6c5b7a-3a5c-4b6e-9a1d-2f8b6e0c3d4a" );
+
+    for ( i = 0; i < file_count; i++ )
+    {
+        char name[ 96 ];
+
+        snprintf( name, sizeof( name ), "simpleJsonProcessor/%s", files[ i ].name );
+        add_case( name, files[ i ].size, bench_processor, &files[ i ] );
+        snprintf( name, sizeof( name ), "findSecondJson/%s", files[ i ].name );
+        add_case( name, files[ i ].size * 2, bench_second_json, &files[ i ] );
+        snprintf( name, sizeof( name ), "isCompleteJson/%s", files[ i ].name );
+        add_case( name, files[ i ].size, bench_complete_json, &files[ i ] );
+        snprintf( name, sizeof( name ), "getPushJson/%s", files[ i ].name );
+        add_case( name, files[ i ].size, bench_push_json, &files[ i ] );
+        snprintf( name, sizeof( name ), "getHttpResponseStatus/%s", files[ i ].name );
+        add_case( name, 0, bench_response_status, &files[ i ] );
+        snprintf( name, sizeof( name ), "getHttpResponseBody/%s", files[ i ].name );
+        add_case( name, strlen( files[ i ].response ), bench_response_body, &files[ i ] );
+
+        if ( files[ i ].tokens > 0 )
+        {
+            snprintf( name, sizeof( name ), "simpleJsonTokenize/%s", files[ i ].name );
+            add_case( name, files[ i ].size, bench_tokenize, &files[ i ] );
+            snprintf( name, sizeof( name ), "simpleJsonTokenFind/%s", files[ i ].name );
+            add_case( name, files[ i ].size, bench_token_find, &files[ i ] );
+        }
+
+        /* What the installation callbacks read: results[0].objectId and results[0].installationId */
+        if ( files[ i ].results )
+        {
+            if ( files[ i ].tokens > 0 )
+            {
+                snprintf( name, sizeof( name ), "queryLookup/tokens/%s", files[ i ].name );
+                add_case( name, files[ i ].size, bench_token_lookup, &files[ i ] );
+            }
+            snprintf( name, sizeof( name ), "queryLookup/simpleJsonQuery/%s", files[ i ].name );
+            add_case( name, files[ i ].size, bench_query_lookup, &files[ i ] );
+        }
+
+        /* Request bodies have to fit in the send buffer with the headers */
+        if ( files[ i ].size < sizeof( sending_data_buffer ) / 2 )
+        {
+            snprintf( name, sizeof( name ), "buildRequestHeaders/POST/%s", files[ i ].name );
+            add_case( name, files[ i ].size, bench_request, &files[ i ] );
+            cases[ case_count - 1 ].verb = "POST";
+            cases[ case_count - 1 ].path = "/1/classes/Reading";
+        }
+    }
+
+    add_case( "buildRequestHeaders/GET/installation_query", 0, bench_request, NULL );
+    cases[ case_count - 1 ].verb = "GET";
+    cases[ case_count - 1 ].path = "/1/installations";
+    add_case( "buildRequestHeaders/POST/installation_writer", 0, bench_request, NULL );
+    cases[ case_count - 1 ].verb = "POST";
+    cases[ case_count - 1 ].path = "/1/installations";
+    cases[ case_count - 1 ].json_body = writeInstallationBody;
+
+    printf( "scanner %s, commit %s\n", simpleJsonScanner( ), BENCH_COMMIT );
+    printf( "%-56s %8s %12s %10s %12s\n", "case", "bytes", "ns/op", "MB/s", "cycles/op" );
+    for ( i = 0; i < case_count; i++ )
+    {
+        if ( filter != NULL && strstr( cases[ i ].name, filter ) == NULL )
+        {
+            cases[ i ].iterations = 0;
+            continue;
+        }
+        measure( &cases[ i ], min_ms * 1e6 );
+        printf( "%-56s %8zu %12.1f %10.1f %12.0f\n", cases[ i ].name, cases[ i ].bytes, cases[ i ].ns_per_op,
+                cases[ i ].bytes ? cases[ i ].bytes * 1e3 / cases[ i ].ns_per_op : 0.0, cases[ i ].cycles_per_op );
+    }
+
+    if ( output != NULL && write_results( output ) != 0 )
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+static void bench_processor( const bench_case_t* bench )
+{
+    char value[ 256 ];
+
+    bench_sink += (uintptr_t) simpleJsonProcessor( bench->file->data, bench->file->last_key, value, sizeof( value ) );
+}
+
+static void bench_second_json( const bench_case_t* bench )
+{
+    bench_sink += (uintptr_t) findSecondJson( bench->file->pair );
+}
+
+static void bench_complete_json( const bench_case_t* bench )
+{
+    bench_sink += (uintptr_t) isCompleteJson( bench->file->data );
+}
+
+static void bench_push_json( const bench_case_t* bench )
+{
+    int start;
+    int length;
+
+    bench_sink += (uintptr_t) getPushJson( bench->file->data, bench->file->size, &start, &length ) + (uintptr_t) length;
+}
+
+static void bench_response_status( const bench_case_t* bench )
+{
+    bench_sink += (uintptr_t) getHttpResponseStatus( bench->file->response );
+}
+
+static void bench_response_body( const bench_case_t* bench )
+{
+    bench_sink += (uintptr_t) getHttpResponseBody( bench->file->response );
+}
+
+static void bench_request( const bench_case_t* bench )
+{
+    const char* body = NULL;
+
+    if ( bench->file != NULL )
+    {
+        body = bench->file->data;
+    }
+    else if ( bench->json_body == NULL )
+    {
+        body = "where=%7b%22installationId%22%3a+%221f6c5b7a-3a5c-4b6e-9a1d-2f8b6e0c3d4a%22%7d";
+    }
+
+    bench_sink += (uintptr_t) buildRequestHeaders( &bench_client, bench->path, bench->verb, body, bench->json_body, WICED_TRUE );
+}
+
+/* The tokenizer alone, for its throughput */
+static void bench_tokenize( const bench_case_t* bench )
+{
+    bench_sink += (uintptr_t) simpleJsonTokenize( bench->file->data, bench->file->size, bench_tokens, MAX_TOKENS );
+}
+
+/* Tokenize and find the last top level key, the counterpart of bench_processor */
+static void bench_token_find( const bench_case_t* bench )
+{
+    char value[ 256 ];
+
+    simpleJsonTokenize( bench->file->data, bench->file->size, bench_tokens, MAX_TOKENS );
+    bench_sink += (uintptr_t) simpleJsonTokenCopy( bench->file->data, bench_tokens, simpleJsonTokenFind( bench->file->data, bench_tokens, 0, bench->file->last_key ), value, sizeof( value ) );
+}
+
+static void bench_token_lookup( const bench_case_t* bench )
+{
+    const char*         data = bench->file->data;
+    simple_json_value_t object_id;
+    simple_json_value_t installation_id;
+    int                 first;
+
+    simpleJsonTokenize( data, bench->file->size, bench_tokens, MAX_TOKENS );
+    first = simpleJsonTokenElement( bench_tokens, simpleJsonTokenFind( data, bench_tokens, 0, "results" ), 0 );
+    simpleJsonTokenValue( data, bench_tokens, simpleJsonTokenFind( data, bench_tokens, first, "objectId" ), &object_id );
+    simpleJsonTokenValue( data, bench_tokens, simpleJsonTokenFind( data, bench_tokens, first, "installationId" ), &installation_id );
+    bench_sink += (uintptr_t) object_id.length + (uintptr_t) installation_id.length;
+}
+
+static void bench_query_lookup( const bench_case_t* bench )
+{
+    simple_json_value_t object_id;
+    simple_json_value_t installation_id;
+
+    simpleJsonQuery( bench->file->data, bench->file->size, "results[0].objectId", &object_id );
+    simpleJsonQuery( bench->file->data, bench->file->size, "results[0].installationId", &installation_id );
+    bench_sink += (uintptr_t) object_id.length + (uintptr_t) installation_id.length;
+}
+
+static int load_corpus( const char* directory )
+{
+    DIR*           dir = opendir( directory );
+    struct dirent* entry;
+    unsigned int   i;
+    unsigned int   j;
+
+    if ( dir == NULL )
+    {
+        fprintf( stderr, "cannot open corpus directory %s\n", directory );
+        return -1;
+    }
+
+    while ( ( entry = readdir( dir ) ) != NULL && file_count < MAX_FILES )
+    {
+        corpus_file_t*      file = &files[ file_count ];
+        char                path[ 512 ];
+        FILE*               input;
+        long                size;
+        simple_json_value_t root;
+        simple_json_value_t key;
+        simple_json_value_t value;
+        size_t              offset = 0;
+        size_t              length = strlen( entry->d_name );
+
+        if ( length < 6 || strcmp( entry->d_name + length - 5, ".json" ) != 0 )
+        {
+            continue;
+        }
+
+        snprintf( path, sizeof( path ), "%s/%s", directory, entry->d_name );
+        input = fopen( path, "rb" );
+        if ( input == NULL || fseek( input, 0, SEEK_END ) != 0 || ( size = ftell( input ) ) <= 0 )
+        {
+            fprintf( stderr, "cannot read %s\n", path );
+            return -1;
+        }
+        rewind( input );
+
+        file->size     = (size_t) size;
+        file->data     = malloc( file->size + 1 );
+        file->pair     = malloc( file->size * 2 + 1 );
+        file->response = malloc( sizeof( http_response_headers ) + 16 + file->size );
+        if ( fread( file->data, 1, file->size, input ) != file->size )
+        {
+            fprintf( stderr, "cannot read %s\n", path );
+            return -1;
+        }
+        fclose( input );
+        file->data[ file->size ] = 0;
+
+        memcpy( file->pair, file->data, file->size );
+        memcpy( file->pair + file->size, file->data, file->size + 1 );
+        length = (size_t) sprintf( file->response, http_response_headers, (unsigned int) file->size );
+        memcpy( file->response + length, file->data, file->size + 1 );
+
+        snprintf( file->name, sizeof( file->name ), "%.*s", (int) ( strlen( entry->d_name ) - 5 ), entry->d_name );
+
+        /* simpleJsonProcessor is benchmarked on the last top level key, its worst case */
+        if ( simpleJsonGetValue( file->data, file->size, &root ) != 0 )
+        {
+            while ( simpleJsonNextMember( &root, &offset, &key, &value ) )
+            {
+                snprintf( file->last_key, sizeof( file->last_key ), "%.*s", (int) key.length, key.data );
+            }
+        }
+
+        file->tokens  = simpleJsonTokenize( file->data, file->size, bench_tokens, MAX_TOKENS );
+        file->results = simpleJsonQuery( file->data, file->size, "results[0].installationId", &value );
+
+        file_count++;
+    }
+    closedir( dir );
+
+    /* Stable order, so results can be compared line by line */
+    for ( i = 0; i < file_count; i++ )
+    {
+        for ( j = i + 1; j < file_count; j++ )
+        {
+            if ( files[ j ].size < files[ i ].size || ( files[ j ].size == files[ i ].size && strcmp( files[ j ].name, files[ i ].name ) < 0 ) )
+            {
+                corpus_file_t swap = files[ i ];
+                files[ i ] = files[ j ];
+                files[ j ] = swap;
+            }
+        }
+    }
+
+    if ( file_count == 0 )
+    {
+        fprintf( stderr, "no .json files in %s\n", directory );
+        return -1;
+    }
+
+    return 0;
+}
+
+static void add_case( const char* name, size_t bytes, bench_function_t function, const corpus_file_t* file )
+{
+    bench_case_t* bench;
+
+    if ( case_count >= MAX_CASES )
+    {
+        return;
+    }
+
+    bench = &cases[ case_count++ ];
+    memset( bench, 0, sizeof( *bench ) );
+    snprintf( bench->name, sizeof( bench->name ), "%s", name );
+    bench->bytes    = bytes;
+    bench->function = function;
+    bench->file     = file;
+}
+
+static void measure( bench_case_t* bench, double min_ns )
+{
+    double        ns[ ROUNDS ];
+    double        cycles[ ROUNDS ];
+    unsigned long iterations = 1;
+    unsigned long i;
+    int           round;
+    int           j;
+
+    /* Calibrate so that all the rounds together take at least min_ns */
+    for ( ;; )
+    {
+        double start = now_ns( );
+        for ( i = 0; i < iterations; i++ )
+        {
+            bench->function( bench );
+        }
+        if ( now_ns( ) - start >= min_ns / ROUNDS || iterations >= ( 1UL << 30 ) )
+        {
+            break;
+        }
+        iterations *= 2;
+    }
+
+    for ( round = 0; round < ROUNDS; round++ )
+    {
+        double   start        = now_ns( );
+        uint64_t start_cycles = now_cycles( );
+
+        for ( i = 0; i < iterations; i++ )
+        {
+            bench->function( bench );
+        }
+        cycles[ round ] = (double) ( now_cycles( ) - start_cycles ) / iterations;
+        ns[ round ]     = ( now_ns( ) - start ) / iterations;
+    }
+
+    /* Median of the rounds, less sensitive to noise than the mean */
+    for ( round = 1; round < ROUNDS; round++ )
+    {
+        for ( j = round; j > 0 && ns[ j ] < ns[ j - 1 ]; j-- )
+        {
+            double swap = ns[ j ];
+            ns[ j ]         = ns[ j - 1 ];
+            ns[ j - 1 ]     = swap;
+            swap            = cycles[ j ];
+            cycles[ j ]     = cycles[ j - 1 ];
+            cycles[ j - 1 ] = swap;
+        }
+    }
+
+    bench->ns_per_op     = ns[ ROUNDS / 2 ];
+    bench->cycles_per_op = cycles[ ROUNDS / 2 ];
+    bench->iterations    = iterations;
+}
+
+static double now_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
+
+static uint64_t now_cycles( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc( );
+#elif defined( __aarch64__ )
+    uint64_t ticks;
+    __asm__ volatile( "mrs %0, cntvct_el0" : "=r" ( ticks ) );
+    return ticks;
+#else
+    return 0;
+#endif
+}
+
+static int write_results( const char* path )
+{
+    FILE*        output = fopen( path, "w" );
+    unsigned int i;
+    int          first = 1;
+
+    if ( output == NULL )
+    {
+        fprintf( stderr, "cannot write %s\n", path );
+        return -1;
+    }
+
+    fprintf( output, "{\n  \"commit\": \"%s\",\n  \"scanner\": \"%s\",\n  \"compiler\": \"%s\",\n  \"time\": %ld,\n  \"results\": [\n",
+             BENCH_COMMIT, simpleJsonScanner( ), __VERSION__, (long) time( NULL ) );
+    for ( i = 0; i < case_count; i++ )
+    {
+        const bench_case_t* bench = &cases[ i ];
+
+        if ( bench->iterations == 0 )
+        {
+            continue;
+        }
+        fprintf( output, "%s    {\"name\": \"%s\", \"bytes\": %zu, \"ns_per_op\": %.2f, \"bytes_per_s\": %.0f, \"cycles_per_op\": %.1f, \"iterations\": %lu}",
+                 first ? "" : ",\n", bench->name, bench->bytes, bench->ns_per_op,
+                 bench->bytes ? bench->bytes * 1e9 / bench->ns_per_op : 0.0, bench->cycles_per_op, bench->iterations );
+        first = 0;
+    }
+    fprintf( output, "\n  ]\n}\n" );
+    fclose( output );
+
+    return 0;
+}
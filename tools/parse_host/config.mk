@@ -0,0 +1,75 @@
+#
+# Build configuration of the host library, shared by the tools that link it.
+# Programs must be compiled with the same feature defines as the library,
+# parse_client_t changes with them:
+#
+#   include <path>/parse_host/config.mk
+#   CPPFLAGS += $(PARSE_HOST_CPPFLAGS)
+#
+
+PARSE_HOST  := $(patsubst %/,%,$(dir $(lastword $(MAKEFILE_LIST))))
+REPO        := $(PARSE_HOST)/../..
+SIMPLE_JSON := $(REPO)/libraries/utilities/simple_JSON
+PARSE       := $(REPO)/libraries/protocols/parse
+UUID        := $(REPO)/libraries/utilities/UUID
+TRACE_LIB   := $(REPO)/libraries/utilities/binary_trace
+TIME_SERIES := $(REPO)/libraries/utilities/time_series
+
+PARSE_HOST_CPPFLAGS := -I$(PARSE_HOST)/include -I$(PARSE) -I$(SIMPLE_JSON) -I$(UUID) -I$(TRACE_LIB) -I$(TIME_SERIES) \
+                       -D_GNU_SOURCE \
+                       -DWPRINT_ENABLE_APP_INFO
+
+# Every thread gets its own request and push buffers, so clients can run on several threads
+PARSE_HOST_CPPFLAGS += -D'PARSE_BUFFER_STORAGE=static __thread'
+
+# Request timing is on by default here, with the microsecond host clock
+LATENCY_STATS ?= 1
+ifeq ($(LATENCY_STATS),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_LATENCY_STATS -D'PARSE_LATENCY_CLOCK_US()=wiced_host_time_us()'
+endif
+
+MEMORY_STATS ?= 1
+ifeq ($(MEMORY_STATS),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_MEMORY_STATS
+endif
+
+ASYNC_INIT ?= 1
+ifeq ($(ASYNC_INIT),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_ASYNC_INIT
+endif
+
+TELEMETRY ?= 1
+ifeq ($(TELEMETRY),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_TELEMETRY
+endif
+
+OBJECTS ?= 1
+ifeq ($(OBJECTS),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_OBJECTS
+endif
+
+QUERY_CURSOR ?= 1
+ifeq ($(QUERY_CURSOR),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_QUERY_CURSOR
+endif
+
+TRACE ?= 1
+ifeq ($(TRACE),1)
+PARSE_HOST_CPPFLAGS += -DPARSE_ENABLE_TRACE -DPARSE_TRACE_LEVEL=PARSE_TRACE_LEVEL_DEBUG \
+                       -D'BINARY_TRACE_TIMESTAMP()=wiced_host_time_us()' -DBINARY_TRACE_TIMESTAMP_NS=1000
+endif
+
+ifneq ($(PARSE_SERVER),)
+PARSE_HOST_CPPFLAGS += -DPARSE_SERVER='"$(PARSE_SERVER)"'
+endif
+ifneq ($(HTTPS_PORT),)
+PARSE_HOST_CPPFLAGS += -DHTTPS_PORT=$(HTTPS_PORT)
+endif
+ifneq ($(PUSH_SERVER),)
+PARSE_HOST_CPPFLAGS += -DPUSH_SERVER='"$(PUSH_SERVER)"'
+endif
+ifneq ($(PUSH_PORT),)
+PARSE_HOST_CPPFLAGS += -DPUSH_PORT=$(PUSH_PORT)
+endif
+
+PARSE_HOST_LIBS := $(PARSE_HOST)/libparse_host.a -lssl -lcrypto -lpthread
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* TLS profiles of the Parse requests on the host. They are applied with
+ * wiced_host_tls_set_options(), which the SDK's TLS layer does not have, so
+ * none of this exists on the target. tools/tls_bench measures them. */
+
+#include <stdint.h>
+#include "wiced_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+/* The maximum fragment length the client asks the server for, RFC 6066. A
+ * server that accepts it sends records no larger than the length, so they
+ * can be received in a buffer of that size instead of one for 16 KB records. */
+typedef enum
+{
+    PARSE_TLS_FRAGMENT_DEFAULT = 0, /* Do not send the extension */
+    PARSE_TLS_FRAGMENT_512     = 1,
+    PARSE_TLS_FRAGMENT_1024    = 2,
+    PARSE_TLS_FRAGMENT_2048    = 3,
+    PARSE_TLS_FRAGMENT_4096    = 4
+} parse_tls_fragment_length_t;
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/* How the TLS connections are set up, zero members keep the defaults */
+typedef struct
+{
+    const char*                 name;                   /* For logs and benchmarks                        */
+    uint16_t                    record_buffer_size;     /* Bytes of the record buffers, 0 for the default */
+    parse_tls_fragment_length_t max_fragment_length;    /* Fragment length to negotiate                   */
+    const uint16_t*             cipher_suites;          /* IANA ids of the suites to offer, NULL for all  */
+    uint8_t                     cipher_suite_count;     /* Number of cipher_suites                        */
+} parse_tls_profile_t;
+
+/******************************************************
+ *                 Global Variables
+ ******************************************************/
+
+/* The defaults of the TLS layer */
+extern const parse_tls_profile_t parse_tls_profile_default;
+
+/* 1 KB fragments and record buffers, for the smallest TLS heap during a
+ * request. Requests and responses are limited by the library's buffers
+ * anyway, so they only take more records. Only for servers that accept the
+ * extension, small buffers cannot receive the full size records of others. */
+extern const parse_tls_profile_t parse_tls_profile_small;
+
+/* ECDHE with AES-128-GCM only, the suites cheapest to negotiate and run */
+extern const parse_tls_profile_t parse_tls_profile_fast;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Selects the profile of the TLS connections started after it, by every
+ * client of the process. The profile is referenced, not copied, NULL is
+ * parse_tls_profile_default.
+ *
+ * @return WICED_SUCCESS, or WICED_BADARG if the host TLS layer does not
+ *         support a value. The previous profile then stays
+ */
+wiced_result_t parse_host_set_tls_profile( const parse_tls_profile_t* profile );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* Host only additions to the WICED API, for tuning and accounting in
+ * benchmarks and soak tests. None of this exists on the target. */
+
+#include <stdint.h>
+#include "wiced_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+/* Payload of one packet fragment, the TCP MSS of the target */
+#ifndef WICED_HOST_PACKET_PAYLOAD
+#define WICED_HOST_PACKET_PAYLOAD    ( 1460 )
+#endif
+
+/* Most fragments chained into one received packet */
+#ifndef WICED_HOST_PACKET_CHAIN_MAX
+#define WICED_HOST_PACKET_CHAIN_MAX  ( 4 )
+#endif
+
+/* Upper bound on wiced_tcp_send_buffer() blocking on a full socket */
+#ifndef WICED_HOST_SEND_TIMEOUT_MS
+#define WICED_HOST_SEND_TIMEOUT_MS   ( 20000 )
+#endif
+
+/* Upper bound on a handshake started by wiced_tcp_start_tls() */
+#ifndef WICED_HOST_TLS_TIMEOUT_MS
+#define WICED_HOST_TLS_TIMEOUT_MS    ( 20000 )
+#endif
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    uint32_t packets_in_use;     /* Packets received and not yet deleted */
+    uint32_t packets_peak;       /* Highest packets_in_use seen */
+    uint32_t sockets_open;       /* Connected or listening sockets */
+    uint32_t connects;           /* Successful wiced_tcp_connect() calls */
+    uint32_t tls_handshakes;     /* Successful TLS handshakes */
+    uint64_t bytes_sent;         /* Application bytes, before TLS */
+    uint64_t bytes_received;     /* Application bytes, after TLS */
+} wiced_host_stats_t;
+
+/* Settings of the TLS connections, zero members keep the OpenSSL defaults */
+typedef struct
+{
+    uint16_t        record_buffer_size;     /* Largest record sent                                  */
+    uint8_t         max_fragment_length;    /* RFC 6066 code, 1 to 4 for 512 to 4096, 0 to not ask  */
+    const uint16_t* cipher_suites;          /* IANA ids of the suites to offer, NULL for all        */
+    uint8_t         cipher_suite_count;
+} wiced_host_tls_options_t;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Returns a snapshot of the platform layer counters. A soak test should see
+ * packets_in_use and sockets_open return to zero between iterations.
+ */
+void wiced_host_get_stats( wiced_host_stats_t* stats );
+
+/**
+ * Returns a monotonic clock in microseconds, finer than wiced_time_get_time()
+ */
+uint32_t wiced_host_time_us( void );
+
+/**
+ * Adds the PEM certificates in a file to the trust anchors, so the library
+ * can talk to a test server with a private CA. The WICED_HOST_CA_FILE
+ * environment variable does the same on the first TLS connection.
+ */
+wiced_result_t wiced_host_tls_add_ca_file( const char* path );
+
+/**
+ * Turns server certificate verification on or off, it is on by default.
+ * Setting WICED_HOST_TLS_VERIFY=0 in the environment turns it off.
+ */
+void wiced_host_tls_set_verify( int verify );
+
+/**
+ * Sets the record size, max fragment length and cipher suites of the TLS
+ * connections started after it, NULL for the defaults. The suites are kept
+ * by reference. The SDK's TLS layer sets up every connection the same way,
+ * this is for measuring what such settings save.
+ *
+ * The record size caps the records sent and buffers are released between
+ * reads, the receive buffer follows the negotiated fragment length.
+ *
+ * @return WICED_SUCCESS, or WICED_BADARG if a value is not supported. The
+ *         settings are then unchanged
+ */
+wiced_result_t wiced_host_tls_set_options( const wiced_host_tls_options_t* options );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
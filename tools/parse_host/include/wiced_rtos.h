@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* Host replacement for the WICED RTOS API: mutexes, semaphores and worker threads on pthreads */
+
+#include <pthread.h>
+#include <stdint.h>
+#include "wiced_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WICED_NEVER_TIMEOUT             ( 0xFFFFFFFF )
+#define WICED_WAIT_FOREVER              ( 0xFFFFFFFF )
+#define WICED_NO_WAIT                   ( 0 )
+
+/* Priorities are accepted and ignored */
+#define WICED_DEFAULT_LIBRARY_PRIORITY  ( 5 )
+
+typedef wiced_result_t (*event_handler_t)( void* arg );
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+} wiced_mutex_t;
+
+typedef struct
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t  signal;
+    uint32_t        count;
+} wiced_semaphore_t;
+
+typedef struct
+{
+    event_handler_t function;
+    void*           arg;
+} wiced_host_event_t;
+
+typedef struct
+{
+    pthread_t           thread;
+    pthread_mutex_t     mutex;
+    pthread_cond_t      signal;
+    wiced_host_event_t* events;
+    uint32_t            size;
+    uint32_t            first;
+    uint32_t            count;
+    int                 stop;
+} wiced_worker_thread_t;
+
+wiced_result_t wiced_rtos_init_mutex  ( wiced_mutex_t* mutex );
+wiced_result_t wiced_rtos_lock_mutex  ( wiced_mutex_t* mutex );
+wiced_result_t wiced_rtos_unlock_mutex( wiced_mutex_t* mutex );
+wiced_result_t wiced_rtos_deinit_mutex( wiced_mutex_t* mutex );
+
+wiced_result_t wiced_rtos_init_semaphore  ( wiced_semaphore_t* semaphore );
+wiced_result_t wiced_rtos_set_semaphore   ( wiced_semaphore_t* semaphore );
+wiced_result_t wiced_rtos_get_semaphore   ( wiced_semaphore_t* semaphore, uint32_t timeout_ms );
+wiced_result_t wiced_rtos_deinit_semaphore( wiced_semaphore_t* semaphore );
+
+/**
+ * Worker stacks are at least 256 KB, host frames are much larger than on the device
+ */
+wiced_result_t wiced_rtos_create_worker_thread   ( wiced_worker_thread_t* worker_thread, uint8_t priority, uint32_t stack_size, uint32_t event_queue_size );
+wiced_result_t wiced_rtos_delete_worker_thread   ( wiced_worker_thread_t* worker_thread );
+wiced_result_t wiced_rtos_send_asynchronous_event( wiced_worker_thread_t* worker_thread, event_handler_t function, void* arg );
+
+wiced_result_t wiced_rtos_delay_milliseconds( uint32_t milliseconds );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
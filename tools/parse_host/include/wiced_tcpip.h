@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* Host replacement for the WICED TCP/IP API. Sockets map onto POSIX TCP
+ * sockets, packets onto heap allocated fragment chains. See wiced_host.h for
+ * the host specific tuning and accounting. */
+
+#include <stdint.h>
+#include "wiced_result.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#define GET_IPV4_ADDRESS( a )            ( ( a ).ip.v4 )
+#define SET_IPV4_ADDRESS( a, addr )      do { ( a ).version = WICED_IPV4; ( a ).ip.v4 = ( uint32_t )( addr ); } while ( 0 )
+#define MAKE_IPV4_ADDRESS( a, b, c, d )  ( ( ( (uint32_t) a ) << 24 ) | ( ( (uint32_t) b ) << 16 ) | ( ( (uint32_t) c ) << 8 ) | ( (uint32_t) d ) )
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+typedef enum
+{
+    WICED_STA_INTERFACE,
+    WICED_AP_INTERFACE,
+    WICED_CONFIG_INTERFACE
+} wiced_interface_t;
+
+typedef enum
+{
+    WICED_IPV4 = 4,
+    WICED_IPV6 = 6
+} wiced_ip_version_t;
+
+/******************************************************
+ *                 Type Definitions
+ ******************************************************/
+
+/* Opaque fragment of a received packet, see wiced_packet_get_data() */
+typedef struct wiced_host_packet wiced_packet_t;
+
+typedef struct wiced_tcp_socket wiced_tcp_socket_t;
+
+typedef wiced_result_t (*wiced_socket_callback_t)( wiced_tcp_socket_t* socket, void* arg );
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    wiced_ip_version_t version;
+    union
+    {
+        uint32_t v4;
+        uint32_t v6[ 4 ];
+    } ip;
+} wiced_ip_address_t;
+
+typedef struct
+{
+    const char* peer_cn;
+} wiced_tls_simple_context_t;
+
+struct wiced_tcp_socket
+{
+    int                         fd;
+    int                         listen_fd;
+    void*                       tls;
+    wiced_tls_simple_context_t* tls_context;
+    wiced_socket_callback_t     connect_callback;
+    wiced_socket_callback_t     receive_callback;
+    wiced_socket_callback_t     disconnect_callback;
+    void*                       callback_arg;
+};
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+wiced_result_t wiced_tcp_create_socket     ( wiced_tcp_socket_t* socket, wiced_interface_t interface );
+wiced_result_t wiced_tcp_delete_socket     ( wiced_tcp_socket_t* socket );
+wiced_result_t wiced_tcp_register_callbacks( wiced_tcp_socket_t* socket, wiced_socket_callback_t connect_callback, wiced_socket_callback_t receive_callback, wiced_socket_callback_t disconnect_callback, void* arg );
+wiced_result_t wiced_tcp_connect           ( wiced_tcp_socket_t* socket, const wiced_ip_address_t* address, uint16_t port, uint32_t timeout );
+wiced_result_t wiced_tcp_disconnect        ( wiced_tcp_socket_t* socket );
+wiced_result_t wiced_tcp_listen            ( wiced_tcp_socket_t* socket, uint16_t port );
+wiced_result_t wiced_tcp_accept            ( wiced_tcp_socket_t* socket );
+wiced_result_t wiced_tcp_server_peer       ( wiced_tcp_socket_t* socket, wiced_ip_address_t* address, uint16_t* port );
+wiced_result_t wiced_tcp_send_buffer       ( wiced_tcp_socket_t* socket, const void* buffer, uint16_t length );
+wiced_result_t wiced_tcp_receive           ( wiced_tcp_socket_t* socket, wiced_packet_t** packet, uint32_t timeout );
+wiced_result_t wiced_tcp_enable_tls        ( wiced_tcp_socket_t* socket, void* context );
+wiced_result_t wiced_packet_get_data       ( wiced_packet_t* packet, uint16_t offset, uint8_t** data, uint16_t* fragment_available_data_length, uint16_t* total_available_data_length );
+wiced_result_t wiced_packet_delete         ( wiced_packet_t* packet );
+wiced_result_t wiced_hostname_lookup       ( const char* hostname, wiced_ip_address_t* address, uint32_t timeout_ms );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
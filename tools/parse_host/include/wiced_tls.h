@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* Host replacement for the WICED TLS API, backed by OpenSSL */
+
+#include "wiced_tcpip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+typedef enum
+{
+    WICED_TLS_AS_CLIENT = 0,
+    WICED_TLS_AS_SERVER = 1
+} wiced_tls_endpoint_type_t;
+
+typedef enum
+{
+    TLS_NO_VERIFICATION       = 0,
+    TLS_VERIFICATION_OPTIONAL = 1,
+    TLS_VERIFICATION_REQUIRED = 2
+} wiced_tls_certificate_verification_t;
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+/* A DER certificate, normally a const table in flash */
+typedef struct
+{
+    const uint8_t* data;
+    uint32_t       length;
+} wiced_tls_der_certificate_t;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+/**
+ * Replaces the trust anchors used to verify every TLS server
+ *
+ * @param[in] trusted_ca_certificates : One or more PEM certificates, NULL clears the store
+ *
+ * @return WICED_SUCCESS, or WICED_ERROR if no certificate could be parsed
+ */
+wiced_result_t wiced_tls_init_root_ca_certificates( const char* trusted_ca_certificates );
+
+/**
+ * Host only: same as wiced_tls_init_root_ca_certificates(), from DER certificates, for
+ * the tables of tools/trust_anchors/pem_to_der.py. There is no
+ * base64 to decode, and a TLS layer may verify from the tables without copying them,
+ * so they must stay valid
+ *
+ * @param[in] certificates : The trust anchors, NULL clears the store
+ * @param[in] count        : Number of certificates
+ *
+ * @return WICED_SUCCESS, or WICED_ERROR if no certificate could be parsed
+ */
+wiced_result_t wiced_tls_init_root_ca_certificates_der( const wiced_tls_der_certificate_t* certificates, uint32_t count );
+
+/**
+ * Prepares a client TLS context. When peer_cn is set it is sent as SNI and
+ * the server certificate must match it.
+ */
+wiced_result_t wiced_tls_init_simple_context( wiced_tls_simple_context_t* context, const char* peer_cn );
+
+wiced_result_t wiced_tls_deinit_context( wiced_tls_simple_context_t* context );
+
+/**
+ * Runs the TLS handshake on a connected socket, using the context given to
+ * wiced_tcp_enable_tls(). wiced_tcp_connect() does this itself when TLS was
+ * enabled before it. Only clients are supported on the host.
+ */
+wiced_result_t wiced_tcp_start_tls( wiced_tcp_socket_t* socket, wiced_tls_endpoint_type_t type, wiced_tls_certificate_verification_t verification );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
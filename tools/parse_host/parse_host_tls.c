@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Host implementation of the Parse TLS profiles, on top of
+ * wiced_host_tls_set_options().
+ */
+
+#include "wiced.h"
+#include "parse_host_tls.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256     ( 0xC02B )
+#define TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256       ( 0xC02F )
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const uint16_t tls_fast_cipher_suites[ ] =
+{
+    TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+    TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+};
+
+const parse_tls_profile_t parse_tls_profile_default =
+{
+    .name = "default",
+};
+
+const parse_tls_profile_t parse_tls_profile_small =
+{
+    .name                = "small",
+    .record_buffer_size  = 1024,
+    .max_fragment_length = PARSE_TLS_FRAGMENT_1024,
+};
+
+const parse_tls_profile_t parse_tls_profile_fast =
+{
+    .name               = "fast",
+    .cipher_suites      = tls_fast_cipher_suites,
+    .cipher_suite_count = sizeof( tls_fast_cipher_suites ) / sizeof( tls_fast_cipher_suites[ 0 ] ),
+};
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t parse_host_set_tls_profile( const parse_tls_profile_t* profile )
+{
+    wiced_host_tls_options_t options;
+
+    if ( profile == NULL )
+    {
+        profile = &parse_tls_profile_default;
+    }
+
+    options.record_buffer_size  = profile->record_buffer_size;
+    options.max_fragment_length = (uint8_t) profile->max_fragment_length;
+    options.cipher_suites       = profile->cipher_suites;
+    options.cipher_suite_count  = profile->cipher_suite_count;
+
+    return wiced_host_tls_set_options( &options );
+}
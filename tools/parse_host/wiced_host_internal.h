@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#pragma once
+
+/* Shared between the host platform layer sources, not part of the API */
+
+#include <stdint.h>
+#include "wiced_tcpip.h"
+#include "wiced_host.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define HOST_NO_DEADLINE  ( UINT64_MAX )
+
+#define HOST_STATS_ADD( field, count )  __atomic_add_fetch( &host_stats.field, ( count ), __ATOMIC_RELAXED )
+
+/* Results of the socket I/O helpers, positive values are byte counts */
+#define HOST_IO_CLOSED    (  0 )
+#define HOST_IO_ERROR     ( -1 )
+#define HOST_IO_TIMEOUT   ( -2 )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+struct wiced_host_packet
+{
+    wiced_packet_t* next;
+    uint16_t        length;
+    uint8_t         data[ WICED_HOST_PACKET_PAYLOAD ];
+};
+
+/******************************************************
+ *               Variable Declarations
+ ******************************************************/
+
+/* Updated with __atomic builtins, sockets can be used from several threads */
+extern wiced_host_stats_t host_stats;
+
+/******************************************************
+ *               Function Declarations
+ ******************************************************/
+
+uint64_t       host_deadline    ( uint32_t timeout_ms );
+int            host_wait        ( int fd, short events, uint64_t deadline );
+
+wiced_result_t host_tls_connect ( wiced_tcp_socket_t* socket, int verify, uint64_t deadline );
+int            host_tls_read    ( wiced_tcp_socket_t* socket, uint8_t* buffer, int length, uint64_t deadline );
+int            host_tls_write   ( wiced_tcp_socket_t* socket, const uint8_t* buffer, int length, uint64_t deadline );
+void           host_tls_close   ( wiced_tcp_socket_t* socket );
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Host implementation of the WICED RTOS API on pthreads.
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <time.h>
+#include "wiced.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define WICED_HOST_MIN_STACK_SIZE   ( 256 * 1024 )
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void* worker_thread_main( void* arg );
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t wiced_rtos_init_mutex( wiced_mutex_t* mutex )
+{
+    return ( pthread_mutex_init( &mutex->mutex, NULL ) == 0 ) ? WICED_SUCCESS : WICED_ERROR;
+}
+
+wiced_result_t wiced_rtos_lock_mutex( wiced_mutex_t* mutex )
+{
+    return ( pthread_mutex_lock( &mutex->mutex ) == 0 ) ? WICED_SUCCESS : WICED_ERROR;
+}
+
+wiced_result_t wiced_rtos_unlock_mutex( wiced_mutex_t* mutex )
+{
+    return ( pthread_mutex_unlock( &mutex->mutex ) == 0 ) ? WICED_SUCCESS : WICED_ERROR;
+}
+
+wiced_result_t wiced_rtos_deinit_mutex( wiced_mutex_t* mutex )
+{
+    return ( pthread_mutex_destroy( &mutex->mutex ) == 0 ) ? WICED_SUCCESS : WICED_ERROR;
+}
+
+wiced_result_t wiced_rtos_init_semaphore( wiced_semaphore_t* semaphore )
+{
+    semaphore->count = 0;
+    pthread_mutex_init( &semaphore->mutex, NULL );
+    pthread_cond_init( &semaphore->signal, NULL );
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_rtos_set_semaphore( wiced_semaphore_t* semaphore )
+{
+    pthread_mutex_lock( &semaphore->mutex );
+    semaphore->count++;
+    pthread_cond_signal( &semaphore->signal );
+    pthread_mutex_unlock( &semaphore->mutex );
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_rtos_get_semaphore( wiced_semaphore_t* semaphore, uint32_t timeout_ms )
+{
+    struct timespec deadline;
+    int             error = 0;
+
+    clock_gettime( CLOCK_REALTIME, &deadline );
+    deadline.tv_sec  += timeout_ms / 1000;
+    deadline.tv_nsec += (long) ( timeout_ms % 1000 ) * 1000000;
+    if ( deadline.tv_nsec >= 1000000000 )
+    {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock( &semaphore->mutex );
+    while ( semaphore->count == 0 && error == 0 )
+    {
+        if ( timeout_ms == WICED_NEVER_TIMEOUT )
+        {
+            error = pthread_cond_wait( &semaphore->signal, &semaphore->mutex );
+        }
+        else
+        {
+            error = pthread_cond_timedwait( &semaphore->signal, &semaphore->mutex, &deadline );
+        }
+    }
+    if ( semaphore->count > 0 )
+    {
+        semaphore->count--;
+        error = 0;
+    }
+    pthread_mutex_unlock( &semaphore->mutex );
+
+    return ( error == 0 ) ? WICED_SUCCESS : ( error == ETIMEDOUT ) ? WICED_TIMEOUT : WICED_ERROR;
+}
+
+wiced_result_t wiced_rtos_deinit_semaphore( wiced_semaphore_t* semaphore )
+{
+    pthread_cond_destroy( &semaphore->signal );
+    pthread_mutex_destroy( &semaphore->mutex );
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_rtos_create_worker_thread( wiced_worker_thread_t* worker_thread, uint8_t priority, uint32_t stack_size, uint32_t event_queue_size )
+{
+    pthread_attr_t attributes;
+    int            error;
+
+    UNUSED_PARAMETER( priority );
+
+    memset( worker_thread, 0, sizeof( *worker_thread ) );
+    worker_thread->events = calloc( event_queue_size, sizeof( wiced_host_event_t ) );
+    if ( worker_thread->events == NULL || event_queue_size == 0 )
+    {
+        free( worker_thread->events );
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+    worker_thread->size = event_queue_size;
+    pthread_mutex_init( &worker_thread->mutex, NULL );
+    pthread_cond_init( &worker_thread->signal, NULL );
+
+    pthread_attr_init( &attributes );
+    pthread_attr_setstacksize( &attributes, MAX( stack_size, WICED_HOST_MIN_STACK_SIZE ) );
+    error = pthread_create( &worker_thread->thread, &attributes, worker_thread_main, worker_thread );
+    pthread_attr_destroy( &attributes );
+
+    if ( error != 0 )
+    {
+        pthread_cond_destroy( &worker_thread->signal );
+        pthread_mutex_destroy( &worker_thread->mutex );
+        free( worker_thread->events );
+        return WICED_ERROR;
+    }
+
+    return WICED_SUCCESS;
+}
+
+/* Events still queued are dropped, the one running is finished first */
+wiced_result_t wiced_rtos_delete_worker_thread( wiced_worker_thread_t* worker_thread )
+{
+    pthread_mutex_lock( &worker_thread->mutex );
+    worker_thread->stop = 1;
+    pthread_cond_signal( &worker_thread->signal );
+    pthread_mutex_unlock( &worker_thread->mutex );
+
+    pthread_join( worker_thread->thread, NULL );
+
+    pthread_cond_destroy( &worker_thread->signal );
+    pthread_mutex_destroy( &worker_thread->mutex );
+    free( worker_thread->events );
+    worker_thread->events = NULL;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_rtos_send_asynchronous_event( wiced_worker_thread_t* worker_thread, event_handler_t function, void* arg )
+{
+    wiced_result_t result = WICED_ERROR;
+
+    pthread_mutex_lock( &worker_thread->mutex );
+    if ( worker_thread->count < worker_thread->size && worker_thread->stop == 0 )
+    {
+        wiced_host_event_t* event = &worker_thread->events[ ( worker_thread->first + worker_thread->count ) % worker_thread->size ];
+
+        event->function = function;
+        event->arg      = arg;
+        worker_thread->count++;
+        pthread_cond_signal( &worker_thread->signal );
+        result = WICED_SUCCESS;
+    }
+    pthread_mutex_unlock( &worker_thread->mutex );
+
+    return result;
+}
+
+wiced_result_t wiced_rtos_delay_milliseconds( uint32_t milliseconds )
+{
+    struct timespec delay;
+
+    delay.tv_sec  = milliseconds / 1000;
+    delay.tv_nsec = (long) ( milliseconds % 1000 ) * 1000000;
+    while ( nanosleep( &delay, &delay ) != 0 && errno == EINTR )
+    {
+    }
+
+    return WICED_SUCCESS;
+}
+
+static void* worker_thread_main( void* arg )
+{
+    wiced_worker_thread_t* worker_thread = (wiced_worker_thread_t*) arg;
+
+    while ( 1 )
+    {
+        wiced_host_event_t event;
+
+        pthread_mutex_lock( &worker_thread->mutex );
+        while ( worker_thread->count == 0 && worker_thread->stop == 0 )
+        {
+            pthread_cond_wait( &worker_thread->signal, &worker_thread->mutex );
+        }
+        if ( worker_thread->stop != 0 )
+        {
+            pthread_mutex_unlock( &worker_thread->mutex );
+            break;
+        }
+        event = worker_thread->events[ worker_thread->first ];
+        worker_thread->first = ( worker_thread->first + 1 ) % worker_thread->size;
+        worker_thread->count--;
+        pthread_mutex_unlock( &worker_thread->mutex );
+
+        event.function( event.arg );
+    }
+
+    return NULL;
+}
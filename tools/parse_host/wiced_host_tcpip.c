@@ -0,0 +1,607 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * POSIX implementation of the WICED TCP/IP, packet and DNS API.
+ *
+ * Every received packet is a chain of WICED_HOST_PACKET_PAYLOAD sized
+ * fragments, like a NetX packet spanning several pool buffers, so code
+ * that only looks at the first fragment behaves as it does on the target.
+ * Callbacks run on the calling thread: the disconnect callback is called
+ * from wiced_tcp_receive() when the peer closes the connection.
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "wiced.h"
+#include "wiced_tls.h"
+#include "dns.h"
+#include "wiced_host_internal.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define LISTEN_BACKLOG  ( 4 )
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static int  open_tcp_socket( void );
+static int  socket_read    ( wiced_tcp_socket_t* socket, uint8_t* buffer, int length, uint64_t deadline );
+static int  socket_write   ( wiced_tcp_socket_t* socket, const uint8_t* buffer, int length, uint64_t deadline );
+static void socket_close   ( int* fd );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+wiced_host_stats_t host_stats;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t wiced_tcp_create_socket( wiced_tcp_socket_t* socket, wiced_interface_t interface )
+{
+    UNUSED_PARAMETER( interface );
+
+    memset( socket, 0, sizeof( *socket ) );
+    socket->fd        = -1;
+    socket->listen_fd = -1;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_delete_socket( wiced_tcp_socket_t* socket )
+{
+    wiced_tcp_disconnect( socket );
+    socket_close( &socket->listen_fd );
+    socket->tls_context = NULL;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_register_callbacks( wiced_tcp_socket_t* socket, wiced_socket_callback_t connect_callback, wiced_socket_callback_t receive_callback, wiced_socket_callback_t disconnect_callback, void* arg )
+{
+    socket->connect_callback    = connect_callback;
+    socket->receive_callback    = receive_callback;
+    socket->disconnect_callback = disconnect_callback;
+    socket->callback_arg        = arg;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_enable_tls( wiced_tcp_socket_t* socket, void* context )
+{
+    socket->tls_context = (wiced_tls_simple_context_t*) context;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_connect( wiced_tcp_socket_t* socket, const wiced_ip_address_t* address, uint16_t port, uint32_t timeout )
+{
+    struct sockaddr_in peer;
+    uint64_t           deadline = host_deadline( timeout );
+    int                error    = 0;
+    socklen_t          length   = sizeof( error );
+    int                ready;
+
+    if ( socket->fd >= 0 || address->version != WICED_IPV4 )
+    {
+        return WICED_BADARG;
+    }
+
+    socket->fd = open_tcp_socket( );
+    if ( socket->fd < 0 )
+    {
+        return WICED_ERROR;
+    }
+    HOST_STATS_ADD( sockets_open, 1 );
+
+    memset( &peer, 0, sizeof( peer ) );
+    peer.sin_family      = AF_INET;
+    peer.sin_port        = htons( port );
+    peer.sin_addr.s_addr = htonl( address->ip.v4 );
+
+    if ( connect( socket->fd, (struct sockaddr*) &peer, sizeof( peer ) ) != 0 )
+    {
+        if ( errno != EINPROGRESS )
+        {
+            goto FAILED;
+        }
+
+        ready = host_wait( socket->fd, POLLOUT, deadline );
+        if ( ready <= 0 )
+        {
+            socket_close( &socket->fd );
+            return ( ready == 0 ) ? WICED_TIMEOUT : WICED_ERROR;
+        }
+
+        if ( getsockopt( socket->fd, SOL_SOCKET, SO_ERROR, &error, &length ) != 0 || error != 0 )
+        {
+            goto FAILED;
+        }
+    }
+
+    if ( socket->tls_context != NULL && host_tls_connect( socket, WICED_TRUE, deadline ) != WICED_SUCCESS )
+    {
+        goto FAILED;
+    }
+
+    HOST_STATS_ADD( connects, 1 );
+
+    return WICED_SUCCESS;
+
+FAILED:
+    socket_close( &socket->fd );
+    return WICED_ERROR;
+}
+
+wiced_result_t wiced_tcp_disconnect( wiced_tcp_socket_t* socket )
+{
+    if ( socket->tls != NULL )
+    {
+        host_tls_close( socket );
+    }
+    socket_close( &socket->fd );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_listen( wiced_tcp_socket_t* socket, uint16_t port )
+{
+    struct sockaddr_in local;
+    int                reuse = 1;
+
+    if ( socket->listen_fd >= 0 )
+    {
+        return WICED_SUCCESS;
+    }
+
+    socket->listen_fd = open_tcp_socket( );
+    if ( socket->listen_fd < 0 )
+    {
+        return WICED_ERROR;
+    }
+    HOST_STATS_ADD( sockets_open, 1 );
+
+    memset( &local, 0, sizeof( local ) );
+    local.sin_family      = AF_INET;
+    local.sin_port        = htons( port );
+    local.sin_addr.s_addr = htonl( INADDR_ANY );
+
+    setsockopt( socket->listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+    if ( bind( socket->listen_fd, (struct sockaddr*) &local, sizeof( local ) ) != 0 || listen( socket->listen_fd, LISTEN_BACKLOG ) != 0 )
+    {
+        socket_close( &socket->listen_fd );
+        return WICED_ERROR;
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_accept( wiced_tcp_socket_t* socket )
+{
+    int nodelay = 1;
+
+    if ( socket->listen_fd < 0 || socket->fd >= 0 )
+    {
+        return WICED_ERROR;
+    }
+
+    /* Server side TLS is not used by the libraries built on the host */
+    if ( socket->tls_context != NULL )
+    {
+        return WICED_UNSUPPORTED;
+    }
+
+    while ( socket->fd < 0 )
+    {
+        if ( host_wait( socket->listen_fd, POLLIN, HOST_NO_DEADLINE ) < 0 )
+        {
+            return WICED_ERROR;
+        }
+
+        socket->fd = accept4( socket->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC );
+        if ( socket->fd < 0 && errno != EAGAIN && errno != EINTR && errno != ECONNABORTED )
+        {
+            return WICED_ERROR;
+        }
+    }
+
+    setsockopt( socket->fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof( nodelay ) );
+    HOST_STATS_ADD( sockets_open, 1 );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_server_peer( wiced_tcp_socket_t* socket, wiced_ip_address_t* address, uint16_t* port )
+{
+    struct sockaddr_in peer;
+    socklen_t          length = sizeof( peer );
+
+    if ( socket->fd < 0 || getpeername( socket->fd, (struct sockaddr*) &peer, &length ) != 0 || peer.sin_family != AF_INET )
+    {
+        return WICED_ERROR;
+    }
+
+    address->version = WICED_IPV4;
+    address->ip.v4   = ntohl( peer.sin_addr.s_addr );
+    *port            = ntohs( peer.sin_port );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_send_buffer( wiced_tcp_socket_t* socket, const void* buffer, uint16_t length )
+{
+    const uint8_t* data     = (const uint8_t*) buffer;
+    uint64_t       deadline = host_deadline( WICED_HOST_SEND_TIMEOUT_MS );
+    int            sent;
+
+    if ( socket->fd < 0 )
+    {
+        return WICED_ERROR;
+    }
+
+    while ( length > 0 )
+    {
+        sent = socket_write( socket, data, length, deadline );
+        if ( sent <= 0 )
+        {
+            return ( sent == HOST_IO_TIMEOUT ) ? WICED_TIMEOUT : WICED_ERROR;
+        }
+
+        HOST_STATS_ADD( bytes_sent, (uint64_t) sent );
+        data   += sent;
+        length  = (uint16_t) ( length - sent );
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_receive( wiced_tcp_socket_t* socket, wiced_packet_t** packet, uint32_t timeout )
+{
+    wiced_packet_t* head     = NULL;
+    wiced_packet_t* tail     = NULL;
+    uint64_t        deadline = host_deadline( timeout );
+    int             result   = HOST_IO_ERROR;
+    int             fragments;
+
+    *packet = NULL;
+
+    if ( socket->fd < 0 )
+    {
+        return WICED_ERROR;
+    }
+
+    /* Block for the first fragment only, then chain whatever else is already buffered */
+    for ( fragments = 0; fragments < WICED_HOST_PACKET_CHAIN_MAX; ++fragments )
+    {
+        wiced_packet_t* fragment = (wiced_packet_t*) malloc( sizeof( wiced_packet_t ) );
+
+        if ( fragment == NULL )
+        {
+            break;
+        }
+
+        result = socket_read( socket, fragment->data, WICED_HOST_PACKET_PAYLOAD, ( head == NULL ) ? deadline : 0 );
+        if ( result <= 0 )
+        {
+            free( fragment );
+            break;
+        }
+
+        fragment->next   = NULL;
+        fragment->length = (uint16_t) result;
+        if ( head == NULL )
+        {
+            head = fragment;
+        }
+        else
+        {
+            tail->next = fragment;
+        }
+        tail = fragment;
+        HOST_STATS_ADD( bytes_received, (uint64_t) result );
+
+        if ( result < WICED_HOST_PACKET_PAYLOAD )
+        {
+            break;
+        }
+    }
+
+    if ( head != NULL )
+    {
+        uint32_t in_use = HOST_STATS_ADD( packets_in_use, 1 );
+        uint32_t peak   = __atomic_load_n( &host_stats.packets_peak, __ATOMIC_RELAXED );
+
+        while ( in_use > peak && !__atomic_compare_exchange_n( &host_stats.packets_peak, &peak, in_use, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+        {
+        }
+
+        *packet = head;
+        return WICED_SUCCESS;
+    }
+
+    if ( result == HOST_IO_TIMEOUT )
+    {
+        return WICED_TIMEOUT;
+    }
+
+    if ( result == HOST_IO_CLOSED && socket->disconnect_callback != NULL )
+    {
+        socket->disconnect_callback( socket, socket->callback_arg );
+    }
+
+    return WICED_ERROR;
+}
+
+wiced_result_t wiced_packet_get_data( wiced_packet_t* packet, uint16_t offset, uint8_t** data, uint16_t* fragment_available_data_length, uint16_t* total_available_data_length )
+{
+    uint32_t total = 0;
+
+    /* Find the fragment holding the offset, then count what follows it */
+    while ( packet != NULL && offset >= packet->length )
+    {
+        offset = (uint16_t) ( offset - packet->length );
+        packet = packet->next;
+    }
+
+    if ( packet == NULL )
+    {
+        return WICED_BADARG;
+    }
+
+    *data                           = packet->data + offset;
+    *fragment_available_data_length = (uint16_t) ( packet->length - offset );
+
+    for ( total = *fragment_available_data_length, packet = packet->next; packet != NULL; packet = packet->next )
+    {
+        total += packet->length;
+    }
+    *total_available_data_length = (uint16_t) MIN( total, 0xFFFF );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_packet_delete( wiced_packet_t* packet )
+{
+    if ( packet == NULL )
+    {
+        return WICED_BADARG;
+    }
+
+    HOST_STATS_ADD( packets_in_use, (uint32_t) -1 );
+
+    while ( packet != NULL )
+    {
+        wiced_packet_t* next = packet->next;
+        free( packet );
+        packet = next;
+    }
+
+    return WICED_SUCCESS;
+}
+
+/* getaddrinfo() has no timeout, the resolver's own settings apply */
+wiced_result_t wiced_hostname_lookup( const char* hostname, wiced_ip_address_t* address, uint32_t timeout_ms )
+{
+    struct addrinfo  hints;
+    struct addrinfo* result = NULL;
+
+    UNUSED_PARAMETER( timeout_ms );
+
+    memset( &hints, 0, sizeof( hints ) );
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    if ( getaddrinfo( hostname, NULL, &hints, &result ) != 0 || result == NULL )
+    {
+        return WICED_ERROR;
+    }
+
+    address->version = WICED_IPV4;
+    address->ip.v4   = ntohl( ( (struct sockaddr_in*) result->ai_addr )->sin_addr.s_addr );
+    freeaddrinfo( result );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t dns_client_hostname_lookup( const char* hostname, wiced_ip_address_t* address, uint32_t timeout_ms )
+{
+    return wiced_hostname_lookup( hostname, address, timeout_ms );
+}
+
+void wiced_host_get_stats( wiced_host_stats_t* stats )
+{
+    stats->packets_in_use = __atomic_load_n( &host_stats.packets_in_use, __ATOMIC_RELAXED );
+    stats->packets_peak   = __atomic_load_n( &host_stats.packets_peak,   __ATOMIC_RELAXED );
+    stats->sockets_open   = __atomic_load_n( &host_stats.sockets_open,   __ATOMIC_RELAXED );
+    stats->connects       = __atomic_load_n( &host_stats.connects,       __ATOMIC_RELAXED );
+    stats->tls_handshakes = __atomic_load_n( &host_stats.tls_handshakes, __ATOMIC_RELAXED );
+    stats->bytes_sent     = __atomic_load_n( &host_stats.bytes_sent,     __ATOMIC_RELAXED );
+    stats->bytes_received = __atomic_load_n( &host_stats.bytes_received, __ATOMIC_RELAXED );
+}
+
+uint64_t host_deadline( uint32_t timeout_ms )
+{
+    struct timespec now;
+
+    if ( timeout_ms == WICED_NEVER_TIMEOUT )
+    {
+        return HOST_NO_DEADLINE;
+    }
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (uint64_t) now.tv_sec * 1000 + (uint64_t) now.tv_nsec / 1000000 + timeout_ms;
+}
+
+/* Returns 1 when the descriptor is ready, 0 at the deadline and -1 on errors */
+int host_wait( int fd, short events, uint64_t deadline )
+{
+    struct pollfd entry;
+    int           result;
+
+    entry.fd     = fd;
+    entry.events = events;
+
+    do
+    {
+        int wait_ms = -1;
+
+        if ( deadline != HOST_NO_DEADLINE )
+        {
+            uint64_t now = host_deadline( 0 );
+            wait_ms = ( now >= deadline ) ? 0 : (int) MIN( deadline - now, 0x7FFFFFFF );
+        }
+
+        entry.revents = 0;
+        result = poll( &entry, 1, wait_ms );
+    } while ( result < 0 && errno == EINTR );
+
+    if ( result > 0 && ( entry.revents & ( POLLERR | POLLNVAL ) ) != 0 && ( entry.revents & events ) == 0 )
+    {
+        return -1;
+    }
+
+    return ( result > 0 ) ? 1 : result;
+}
+
+static int open_tcp_socket( void )
+{
+    int fd      = socket( AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+    int nodelay = 1;
+
+    /* NetX has no Nagle algorithm, every send goes out immediately */
+    if ( fd >= 0 )
+    {
+        setsockopt( fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof( nodelay ) );
+    }
+
+    return fd;
+}
+
+static int socket_read( wiced_tcp_socket_t* socket, uint8_t* buffer, int length, uint64_t deadline )
+{
+    if ( socket->tls != NULL )
+    {
+        return host_tls_read( socket, buffer, length, deadline );
+    }
+
+    while ( 1 )
+    {
+        ssize_t count = recv( socket->fd, buffer, (size_t) length, 0 );
+        int     ready;
+
+        if ( count >= 0 )
+        {
+            return (int) count;
+        }
+
+        if ( errno == EINTR )
+        {
+            continue;
+        }
+
+        if ( errno != EAGAIN && errno != EWOULDBLOCK )
+        {
+            return HOST_IO_ERROR;
+        }
+
+        ready = host_wait( socket->fd, POLLIN, deadline );
+        if ( ready <= 0 )
+        {
+            return ( ready == 0 ) ? HOST_IO_TIMEOUT : HOST_IO_ERROR;
+        }
+    }
+}
+
+static int socket_write( wiced_tcp_socket_t* socket, const uint8_t* buffer, int length, uint64_t deadline )
+{
+    if ( socket->tls != NULL )
+    {
+        return host_tls_write( socket, buffer, length, deadline );
+    }
+
+    while ( 1 )
+    {
+        ssize_t count = send( socket->fd, buffer, (size_t) length, MSG_NOSIGNAL );
+        int     ready;
+
+        if ( count > 0 )
+        {
+            return (int) count;
+        }
+
+        if ( count < 0 && errno == EINTR )
+        {
+            continue;
+        }
+
+        if ( count == 0 || ( errno != EAGAIN && errno != EWOULDBLOCK ) )
+        {
+            return HOST_IO_ERROR;
+        }
+
+        ready = host_wait( socket->fd, POLLOUT, deadline );
+        if ( ready <= 0 )
+        {
+            return ( ready == 0 ) ? HOST_IO_TIMEOUT : HOST_IO_ERROR;
+        }
+    }
+}
+
+static void socket_close( int* fd )
+{
+    if ( *fd >= 0 )
+    {
+        close( *fd );
+        *fd = -1;
+        HOST_STATS_ADD( sockets_open, (uint32_t) -1 );
+    }
+}
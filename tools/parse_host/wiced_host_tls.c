@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * OpenSSL implementation of the WICED TLS API.
+ *
+ * All client connections share one SSL_CTX. The trust anchors loaded by
+ * wiced_tls_init_root_ca_certificates() are pinned by each connection when
+ * it is created, so replacing them never affects a handshake in progress.
+ * The options of wiced_host_tls_set_options() are applied to the SSL of each
+ * connection as it is created.
+ */
+
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <openssl/err.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include "wiced.h"
+#include "wiced_tls.h"
+#include "wiced_host_internal.h"
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void         tls_init_once ( void );
+static wiced_result_t tls_set_store( const void* source, const char* pem, const wiced_tls_der_certificate_t* der, uint32_t der_count );
+static X509_STORE*  tls_new_store ( const char* pem, const wiced_tls_der_certificate_t* der, uint32_t der_count );
+static int          tls_wait      ( wiced_tcp_socket_t* socket, int result, uint64_t deadline );
+static int          tls_set_options( SSL* ssl, const wiced_host_tls_options_t* options );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static pthread_once_t           tls_once     = PTHREAD_ONCE_INIT;
+static pthread_mutex_t          tls_mutex    = PTHREAD_MUTEX_INITIALIZER;
+static SSL_CTX*                 tls_ctx      = NULL;
+static X509_STORE*              tls_store    = NULL;
+static const void*              tls_store_source;
+static char*                    tls_ca_file  = NULL;
+static int                      tls_verify   = 1;
+static wiced_host_tls_options_t tls_options;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t wiced_tls_init_root_ca_certificates( const char* trusted_ca_certificates )
+{
+    return tls_set_store( trusted_ca_certificates, trusted_ca_certificates, NULL, 0 );
+}
+
+wiced_result_t wiced_tls_init_root_ca_certificates_der( const wiced_tls_der_certificate_t* certificates, uint32_t count )
+{
+    return tls_set_store( certificates, NULL, certificates, count );
+}
+
+wiced_result_t wiced_tls_init_simple_context( wiced_tls_simple_context_t* context, const char* peer_cn )
+{
+    memset( context, 0, sizeof( *context ) );
+    context->peer_cn = peer_cn;
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tls_deinit_context( wiced_tls_simple_context_t* context )
+{
+    memset( context, 0, sizeof( *context ) );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_tcp_start_tls( wiced_tcp_socket_t* socket, wiced_tls_endpoint_type_t type, wiced_tls_certificate_verification_t verification )
+{
+    if ( socket->fd < 0 || socket->tls != NULL || socket->tls_context == NULL )
+    {
+        return WICED_ERROR;
+    }
+
+    if ( type != WICED_TLS_AS_CLIENT )
+    {
+        return WICED_UNSUPPORTED;
+    }
+
+    return host_tls_connect( socket, verification != TLS_NO_VERIFICATION, host_deadline( WICED_HOST_TLS_TIMEOUT_MS ) );
+}
+
+wiced_result_t wiced_host_tls_add_ca_file( const char* path )
+{
+    char* copy = strdup( path );
+
+    pthread_once( &tls_once, tls_init_once );
+
+    if ( copy == NULL )
+    {
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+
+    pthread_mutex_lock( &tls_mutex );
+    free( tls_ca_file );
+    tls_ca_file = copy;
+    if ( tls_store != NULL && X509_STORE_load_locations( tls_store, tls_ca_file, NULL ) != 1 )
+    {
+        pthread_mutex_unlock( &tls_mutex );
+        return WICED_ERROR;
+    }
+    pthread_mutex_unlock( &tls_mutex );
+
+    return WICED_SUCCESS;
+}
+
+void wiced_host_tls_set_verify( int verify )
+{
+    pthread_once( &tls_once, tls_init_once );
+
+    pthread_mutex_lock( &tls_mutex );
+    tls_verify = verify;
+    pthread_mutex_unlock( &tls_mutex );
+}
+
+wiced_result_t wiced_host_tls_set_options( const wiced_host_tls_options_t* options )
+{
+    static const wiced_host_tls_options_t defaults;
+
+    if ( options == NULL )
+    {
+        options = &defaults;
+    }
+    if ( options->max_fragment_length > TLSEXT_max_fragment_length_4096 ||
+         ( options->record_buffer_size != 0 && ( options->record_buffer_size < 512 || options->record_buffer_size > SSL3_RT_MAX_PLAIN_LENGTH ) ) ||
+         ( options->cipher_suite_count != 0 && options->cipher_suites == NULL ) )
+    {
+        return WICED_BADARG;
+    }
+
+    pthread_mutex_lock( &tls_mutex );
+    tls_options = *options;
+    pthread_mutex_unlock( &tls_mutex );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t host_tls_connect( wiced_tcp_socket_t* socket, int verify, uint64_t deadline )
+{
+    const char*              peer_cn = socket->tls_context->peer_cn;
+    wiced_host_tls_options_t options;
+    SSL*                     ssl;
+    int                      result;
+
+    pthread_once( &tls_once, tls_init_once );
+    if ( tls_ctx == NULL )
+    {
+        return WICED_ERROR;
+    }
+
+    ssl = SSL_new( tls_ctx );
+    if ( ssl == NULL )
+    {
+        return WICED_OUT_OF_HEAP_SPACE;
+    }
+
+    pthread_mutex_lock( &tls_mutex );
+    if ( tls_store == NULL && tls_ca_file != NULL )
+    {
+        tls_store = X509_STORE_new( );
+        if ( tls_store != NULL )
+        {
+            X509_STORE_load_locations( tls_store, tls_ca_file, NULL );
+        }
+    }
+    if ( tls_store != NULL )
+    {
+        SSL_set1_verify_cert_store( ssl, tls_store );
+    }
+    SSL_set_verify( ssl, ( tls_verify && verify ) ? SSL_VERIFY_PEER : SSL_VERIFY_NONE, NULL );
+    options = tls_options;
+    pthread_mutex_unlock( &tls_mutex );
+
+    if ( tls_set_options( ssl, &options ) != 1 )
+    {
+        WPRINT_LIB_INFO( ("TLS options not supported\n") );
+        ERR_clear_error( );
+        SSL_free( ssl );
+        return WICED_UNSUPPORTED;
+    }
+
+    if ( peer_cn != NULL )
+    {
+        SSL_set_tlsext_host_name( ssl, peer_cn );
+        SSL_set1_host( ssl, peer_cn );
+    }
+
+    SSL_set_fd( ssl, socket->fd );
+    socket->tls = ssl;
+
+    do
+    {
+        result = SSL_connect( ssl );
+    } while ( result != 1 && tls_wait( socket, result, deadline ) > 0 );
+
+    if ( result != 1 )
+    {
+        WPRINT_LIB_INFO( ("TLS handshake failed: %s\n", X509_verify_cert_error_string( SSL_get_verify_result( ssl ) )) );
+        ERR_clear_error( );
+        SSL_free( ssl );
+        socket->tls = NULL;
+        return WICED_ERROR;
+    }
+
+    HOST_STATS_ADD( tls_handshakes, 1 );
+
+    return WICED_SUCCESS;
+}
+
+int host_tls_read( wiced_tcp_socket_t* socket, uint8_t* buffer, int length, uint64_t deadline )
+{
+    SSL* ssl = (SSL*) socket->tls;
+
+    while ( 1 )
+    {
+        int result = SSL_read( ssl, buffer, length );
+        int ready;
+
+        if ( result > 0 )
+        {
+            return result;
+        }
+
+        ready = tls_wait( socket, result, deadline );
+        if ( ready <= 0 )
+        {
+            return ready;
+        }
+    }
+}
+
+int host_tls_write( wiced_tcp_socket_t* socket, const uint8_t* buffer, int length, uint64_t deadline )
+{
+    SSL* ssl = (SSL*) socket->tls;
+
+    while ( 1 )
+    {
+        int result = SSL_write( ssl, buffer, length );
+        int ready;
+
+        if ( result > 0 )
+        {
+            return result;
+        }
+
+        ready = tls_wait( socket, result, deadline );
+        if ( ready <= 0 )
+        {
+            return ( ready == HOST_IO_CLOSED ) ? HOST_IO_ERROR : ready;
+        }
+    }
+}
+
+void host_tls_close( wiced_tcp_socket_t* socket )
+{
+    SSL* ssl = (SSL*) socket->tls;
+
+    /* Send close_notify if the socket has room, never wait for the reply */
+    SSL_shutdown( ssl );
+    ERR_clear_error( );
+    SSL_free( ssl );
+    socket->tls = NULL;
+}
+
+static void tls_init_once( void )
+{
+    const char* ca_file = getenv( "WICED_HOST_CA_FILE" );
+    const char* verify  = getenv( "WICED_HOST_TLS_VERIFY" );
+
+    /* OpenSSL writes to the socket with write(), a peer reset must not kill the process */
+    signal( SIGPIPE, SIG_IGN );
+
+    tls_ctx = SSL_CTX_new( TLS_client_method( ) );
+    if ( tls_ctx != NULL )
+    {
+        SSL_CTX_set_min_proto_version( tls_ctx, TLS1_2_VERSION );
+        SSL_CTX_set_mode( tls_ctx, SSL_MODE_AUTO_RETRY );
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+        /* Servers that close without close_notify end the stream like a TCP close does */
+        SSL_CTX_set_options( tls_ctx, SSL_OP_IGNORE_UNEXPECTED_EOF );
+#endif
+    }
+
+    if ( ca_file != NULL && ca_file[ 0 ] != 0 )
+    {
+        tls_ca_file = strdup( ca_file );
+    }
+
+    if ( verify != NULL && strcmp( verify, "0" ) == 0 )
+    {
+        tls_verify = 0;
+    }
+}
+
+/* source identifies the certificates, NULL clears the store */
+static wiced_result_t tls_set_store( const void* source, const char* pem, const wiced_tls_der_certificate_t* der, uint32_t der_count )
+{
+    X509_STORE* store = NULL;
+    X509_STORE* old_store;
+
+    pthread_once( &tls_once, tls_init_once );
+
+    /* Every client passes the same certificates, only parse them once */
+    pthread_mutex_lock( &tls_mutex );
+    if ( source != NULL && source == tls_store_source )
+    {
+        pthread_mutex_unlock( &tls_mutex );
+        return WICED_SUCCESS;
+    }
+    pthread_mutex_unlock( &tls_mutex );
+
+    if ( source != NULL )
+    {
+        store = tls_new_store( pem, der, der_count );
+        if ( store == NULL )
+        {
+            return WICED_ERROR;
+        }
+    }
+
+    pthread_mutex_lock( &tls_mutex );
+    old_store        = tls_store;
+    tls_store        = store;
+    tls_store_source = source;
+    pthread_mutex_unlock( &tls_mutex );
+
+    X509_STORE_free( old_store );
+
+    return WICED_SUCCESS;
+}
+
+static X509_STORE* tls_new_store( const char* pem, const wiced_tls_der_certificate_t* der, uint32_t der_count )
+{
+    X509_STORE* store = X509_STORE_new( );
+    X509*       certificate;
+    uint32_t    index;
+    int         count = 0;
+
+    if ( store == NULL )
+    {
+        return NULL;
+    }
+
+    if ( pem != NULL )
+    {
+        BIO* bio = BIO_new_mem_buf( pem, -1 );
+
+        while ( bio != NULL && ( certificate = PEM_read_bio_X509( bio, NULL, NULL, NULL ) ) != NULL )
+        {
+            if ( X509_STORE_add_cert( store, certificate ) == 1 )
+            {
+                ++count;
+            }
+            X509_free( certificate );
+        }
+        BIO_free( bio );
+    }
+
+    for ( index = 0; der != NULL && index < der_count; index++ )
+    {
+        const unsigned char* data = der[ index ].data;
+
+        certificate = d2i_X509( NULL, &data, (long) der[ index ].length );
+        if ( certificate != NULL && X509_STORE_add_cert( store, certificate ) == 1 )
+        {
+            ++count;
+        }
+        X509_free( certificate );
+    }
+    ERR_clear_error( );
+
+    pthread_mutex_lock( &tls_mutex );
+    if ( tls_ca_file != NULL && X509_STORE_load_locations( store, tls_ca_file, NULL ) == 1 )
+    {
+        ++count;
+    }
+    pthread_mutex_unlock( &tls_mutex );
+
+    if ( count == 0 )
+    {
+        X509_STORE_free( store );
+        return NULL;
+    }
+
+    return store;
+}
+
+/* Waits for the socket as OpenSSL asks, returns 1 to retry or a HOST_IO_ result */
+static int tls_wait( wiced_tcp_socket_t* socket, int result, uint64_t deadline )
+{
+    int ready;
+
+    switch ( SSL_get_error( (SSL*) socket->tls, result ) )
+    {
+        case SSL_ERROR_WANT_READ:
+            ready = host_wait( socket->fd, POLLIN, deadline );
+            break;
+
+        case SSL_ERROR_WANT_WRITE:
+            ready = host_wait( socket->fd, POLLOUT, deadline );
+            break;
+
+        case SSL_ERROR_ZERO_RETURN:
+            return HOST_IO_CLOSED;
+
+        case SSL_ERROR_SYSCALL:
+            ERR_clear_error( );
+            return ( result == 0 ) ? HOST_IO_CLOSED : HOST_IO_ERROR;
+
+        default:
+            ERR_clear_error( );
+            return HOST_IO_ERROR;
+    }
+
+    if ( ready == 0 )
+    {
+        return HOST_IO_TIMEOUT;
+    }
+
+    return ( ready > 0 ) ? 1 : HOST_IO_ERROR;
+}
+
+/* TLS 1.3 suites are set apart from the others in OpenSSL, a list of only one
+ * kind also limits the protocol versions so the other kind is not offered */
+static int tls_set_options( SSL* ssl, const wiced_host_tls_options_t* options )
+{
+    char    tls12[ 512 ] = "";
+    char    tls13[ 256 ] = "";
+    uint8_t i;
+
+    if ( options->max_fragment_length != 0 && SSL_set_tlsext_max_fragment_length( ssl, options->max_fragment_length ) != 1 )
+    {
+        return 0;
+    }
+
+    if ( options->record_buffer_size != 0 )
+    {
+        SSL_set_max_send_fragment( ssl, options->record_buffer_size );
+        SSL_set_mode( ssl, SSL_MODE_RELEASE_BUFFERS );
+    }
+
+    if ( options->cipher_suite_count == 0 )
+    {
+        return 1;
+    }
+
+    for ( i = 0; i < options->cipher_suite_count; i++ )
+    {
+        const unsigned char id[ 2 ] = { (unsigned char) ( options->cipher_suites[ i ] >> 8 ), (unsigned char) options->cipher_suites[ i ] };
+        const SSL_CIPHER*   cipher  = SSL_CIPHER_find( ssl, id );
+        char*               list    = ( id[ 0 ] == 0x13 ) ? tls13 : tls12;
+        size_t              size    = ( id[ 0 ] == 0x13 ) ? sizeof( tls13 ) : sizeof( tls12 );
+
+        if ( cipher == NULL )
+        {
+            continue;
+        }
+        if ( list[ 0 ] != '\0' )
+        {
+            strncat( list, ":", size - strlen( list ) - 1 );
+        }
+        strncat( list, SSL_CIPHER_get_name( cipher ), size - strlen( list ) - 1 );
+    }
+
+    if ( tls12[ 0 ] == '\0' && tls13[ 0 ] == '\0' )
+    {
+        return 0;
+    }
+    if ( tls13[ 0 ] == '\0' )
+    {
+        return SSL_set_max_proto_version( ssl, TLS1_2_VERSION ) && SSL_set_cipher_list( ssl, tls12 );
+    }
+    if ( tls12[ 0 ] == '\0' )
+    {
+        return SSL_set_min_proto_version( ssl, TLS1_3_VERSION ) && SSL_set_ciphersuites( ssl, tls13 );
+    }
+    return SSL_set_cipher_list( ssl, tls12 ) && SSL_set_ciphersuites( ssl, tls13 );
+}
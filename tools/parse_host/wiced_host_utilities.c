@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Host implementation of the WICED utility, random number and HTTP helpers.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "wiced.h"
+#include "wwd_crypto.h"
+#include "http.h"
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void     open_random  ( void );
+static void     set_time_base( void );
+static uint64_t monotonic_us ( void );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static pthread_once_t random_once = PTHREAD_ONCE_INIT;
+static int            random_fd   = -1;
+static pthread_once_t time_once   = PTHREAD_ONCE_INIT;
+static uint64_t       time_base_us;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+wiced_result_t wwd_wifi_get_random( void* buffer, uint16_t buffer_length )
+{
+    uint8_t* data = (uint8_t*) buffer;
+
+    pthread_once( &random_once, open_random );
+    if ( random_fd < 0 )
+    {
+        return WICED_ERROR;
+    }
+
+    while ( buffer_length > 0 )
+    {
+        ssize_t count = read( random_fd, data, buffer_length );
+
+        if ( count <= 0 )
+        {
+            if ( count < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            return WICED_ERROR;
+        }
+
+        data          += count;
+        buffer_length  = (uint16_t) ( buffer_length - count );
+    }
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_time_get_time( wiced_time_t* time_ptr )
+{
+    pthread_once( &time_once, set_time_base );
+
+    *time_ptr = (wiced_time_t) ( ( monotonic_us( ) - time_base_us ) / 1000 );
+
+    return WICED_SUCCESS;
+}
+
+wiced_result_t wiced_time_get_utc_time_ms( wiced_utc_time_ms_t* utc_time_ms )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_REALTIME, &now );
+    *utc_time_ms = (wiced_utc_time_ms_t) now.tv_sec * 1000 + (wiced_utc_time_ms_t) ( now.tv_nsec / 1000000 );
+
+    return WICED_SUCCESS;
+}
+
+uint32_t wiced_host_time_us( void )
+{
+    pthread_once( &time_once, set_time_base );
+
+    return (uint32_t) ( monotonic_us( ) - time_base_us );
+}
+
+char nibble_to_hexchar( uint8_t nibble )
+{
+    if ( nibble > 9 )
+    {
+        return (char) ( 'A' + ( nibble - 10 ) );
+    }
+
+    return (char) ( '0' + nibble );
+}
+
+wiced_result_t http_process_response( wiced_packet_t* packet, http_status_code_t* response_code )
+{
+    uint8_t* data;
+    uint16_t fragment_length;
+    uint16_t total_length;
+    int      code = 0;
+    int      a;
+
+    if ( wiced_packet_get_data( packet, 0, &data, &fragment_length, &total_length ) != WICED_SUCCESS )
+    {
+        return WICED_ERROR;
+    }
+
+    /* "HTTP/1.x NNN", the status line must start in the first fragment */
+    if ( fragment_length < 12 || memcmp( data, "HTTP/1.", 7 ) != 0 || data[ 8 ] != ' ' )
+    {
+        return WICED_ERROR;
+    }
+
+    for ( a = 9; a < 12; ++a )
+    {
+        if ( data[ a ] < '0' || data[ a ] > '9' )
+        {
+            return WICED_ERROR;
+        }
+        code = code * 10 + ( data[ a ] - '0' );
+    }
+
+    *response_code = (http_status_code_t) code;
+
+    return WICED_SUCCESS;
+}
+
+static void set_time_base( void )
+{
+    time_base_us = monotonic_us( );
+}
+
+static uint64_t monotonic_us( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+static void open_random( void )
+{
+    random_fd = open( "/dev/urandom", O_RDONLY | O_CLOEXEC );
+}
@@ -0,0 +1,840 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Fleet load generator: many simulated devices in one process against a
+ * Parse server, normally tools/parse_mock
+ *
+ * Every device is a parse_client_t with its own installation and a push
+ * thread running parse_run_push_loop(), reconnecting when the connection
+ * drops. A pool of request workers sends each device's request mix, each
+ * worker owning a fixed share of the devices, so that a client is only
+ * ever used by its worker and its push thread. The library's request and
+ * push buffers are thread local in the host build.
+ *
+ * Push delivery latency is measured from the "sent_us" field the workers
+ * put in the pushes they send, or the "sent" field of the pushes of the
+ * mock's --push-interval generator. Both use the wall clock, so the mock
+ * has to run on the same host.
+ */
+
+#include "wiced.h"
+#include "wiced_host.h"
+#include "parse.h"
+#include "parse_schema.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#define LOAD_ATOMIC_ADD( counter, value )   __atomic_fetch_add( &( counter ), ( value ), __ATOMIC_RELAXED )
+#define LOAD_ATOMIC_GET( counter )          __atomic_load_n( &( counter ), __ATOMIC_RELAXED )
+
+/* Fields of the LoadReading objects that are created and updated */
+#define LOAD_READING_FIELDS( FIELD )        \
+    FIELD( INT, device, 0 )                 \
+    FIELD( INT, value,  0 )
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define DEFAULT_DEVICES         ( 20 )
+#define DEFAULT_WORKERS         ( 4 )
+#define DEFAULT_DURATION_S      ( 30 )
+#define DEFAULT_RATE            ( 0.5 )     /* Requests per second per device */
+#define DEFAULT_MIX             "create=4,query=3,update=2,push=1"
+#define DEFAULT_APP_ID          "loadAppId"
+#define DEFAULT_CLIENT_KEY      "loadClientKey"
+
+#define THREAD_STACK_SIZE       ( 256 * 1024 )
+#define PROGRESS_INTERVAL_S     ( 5 )
+#define RECONNECT_DELAY_US      ( 1000000 )
+#define LOAD_CLASS_PATH         "/1/classes/LoadReading"
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+typedef enum
+{
+    LOAD_CREATE,
+    LOAD_QUERY,
+    LOAD_UPDATE,
+    LOAD_PUSH,
+    LOAD_REQUEST_COUNT
+} load_request_t;
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+PARSE_SCHEMA_DECLARE( load_reading, LOAD_READING_FIELDS )
+
+typedef struct
+{
+    uint32_t* values;
+    size_t    count;
+    size_t    capacity;
+} load_samples_t;
+
+typedef struct
+{
+    parse_client_t  client;         /* First, callbacks cast the client back to the device */
+    unsigned int    index;
+    volatile int    ready;          /* Installation created, push thread started */
+    char            object_id[ OBJECT_ID_MAX_LEN + 1 ];
+    pthread_t       push_thread;
+    void*           push_stack;
+
+    /* Written by the push thread, under lock */
+    pthread_mutex_t lock;
+    int             push_connected;
+    uint32_t        push_connects;
+    uint32_t        push_failures;
+    uint32_t        pushes;
+    load_samples_t  push_latency;
+} load_device_t;
+
+typedef struct
+{
+    unsigned int    index;
+    pthread_t       thread;
+    void*           stack;
+    unsigned int    seed;
+    uint32_t        bootstrap_failures;
+    load_samples_t  bootstrap;
+    uint32_t        requests[ LOAD_REQUEST_COUNT ];
+    uint32_t        errors  [ LOAD_REQUEST_COUNT ];
+    load_samples_t  latency [ LOAD_REQUEST_COUNT ];
+
+    /* Result of the request in flight, set by the callback */
+    int             status;
+    load_device_t*  device;
+} load_worker_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void*    push_thread_main    ( void* arg );
+static void*    worker_thread_main  ( void* arg );
+static void     push_received       ( parse_client_t* client, int error, const char* data, const parse_push_t* push );
+static void     request_done        ( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody );
+static void     send_load_request   ( load_worker_t* worker, load_device_t* device, load_request_t request );
+static int      parse_mix           ( const char* mix );
+static void     start_thread        ( pthread_t* thread, void** stack, const char* name, void* ( *main )( void* ), void* arg );
+static void     samples_add         ( load_samples_t* samples, uint32_t value );
+static void     samples_merge       ( load_samples_t* into, const load_samples_t* from );
+static void     print_distribution  ( const char* name, load_samples_t* samples, double scale, const char* unit );
+static uint32_t percentile          ( const load_samples_t* samples, unsigned int percent );
+static int      compare_uint32      ( const void* a, const void* b );
+static uint64_t now_us              ( void );
+static int64_t  wall_time_us        ( void );
+static long     resident_kb         ( void );
+static void     print_progress      ( double elapsed );
+static void     print_report        ( double elapsed, long rss_before_kb, long rss_after_kb );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const char* const request_names[ LOAD_REQUEST_COUNT ] =
+{
+    [ LOAD_CREATE ] = "create",
+    [ LOAD_QUERY  ] = "query",
+    [ LOAD_UPDATE ] = "update",
+    [ LOAD_PUSH   ] = "push",
+};
+
+static unsigned int    device_count  = DEFAULT_DEVICES;
+static unsigned int    worker_count  = DEFAULT_WORKERS;
+static double          duration_s    = DEFAULT_DURATION_S;
+static double          request_rate  = DEFAULT_RATE;
+static const char*     app_id        = DEFAULT_APP_ID;
+static const char*     client_key    = DEFAULT_CLIENT_KEY;
+static unsigned int    mix_weights[ LOAD_REQUEST_COUNT ];
+static unsigned int    mix_total;
+
+static load_device_t*  devices;
+static load_worker_t*  workers;
+static uint64_t        start_us;
+static uint64_t        deadline_us;
+static uint32_t        devices_ready;
+static uint32_t        push_reconnects;
+
+static __thread load_worker_t* current_worker;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+PARSE_SCHEMA_DEFINE( load_reading, LOAD_READING_FIELDS )
+
+int main( int argc, char** argv )
+{
+    long         rss_before_kb;
+    long         rss_after_kb;
+    double       next_progress = PROGRESS_INTERVAL_S;
+    const char*  mix           = DEFAULT_MIX;
+    unsigned int a;
+    int          arg;
+
+    for ( arg = 1; arg < argc; arg++ )
+    {
+        if ( strcmp( argv[ arg ], "-n" ) == 0 && arg + 1 < argc )
+        {
+            device_count = (unsigned int) atoi( argv[ ++arg ] );
+        }
+        else if ( strcmp( argv[ arg ], "-w" ) == 0 && arg + 1 < argc )
+        {
+            worker_count = (unsigned int) atoi( argv[ ++arg ] );
+        }
+        else if ( strcmp( argv[ arg ], "-d" ) == 0 && arg + 1 < argc )
+        {
+            duration_s = atof( argv[ ++arg ] );
+        }
+        else if ( strcmp( argv[ arg ], "-r" ) == 0 && arg + 1 < argc )
+        {
+            request_rate = atof( argv[ ++arg ] );
+        }
+        else if ( strcmp( argv[ arg ], "-m" ) == 0 && arg + 1 < argc )
+        {
+            mix = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-a" ) == 0 && arg + 1 < argc )
+        {
+            app_id = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-k" ) == 0 && arg + 1 < argc )
+        {
+            client_key = argv[ ++arg ];
+        }
+        else
+        {
+            fprintf( stderr, "usage: %s [-n devices] [-w workers] [-d seconds] [-r requests_per_s_per_device]\n"
+                             "       [-m create=4,query=3,update=2,push=1] [-a app_id] [-k client_key]\n", argv[ 0 ] );
+            return 2;
+        }
+    }
+
+    if ( device_count == 0 || worker_count == 0 || parse_mix( mix ) != 0 )
+    {
+        fprintf( stderr, "%s: bad device count, worker count or request mix\n", argv[ 0 ] );
+        return 2;
+    }
+    if ( worker_count > device_count )
+    {
+        worker_count = device_count;
+    }
+
+    devices = calloc( device_count, sizeof( load_device_t ) );
+    workers = calloc( worker_count, sizeof( load_worker_t ) );
+    if ( devices == NULL || workers == NULL )
+    {
+        fprintf( stderr, "%s: out of memory\n", argv[ 0 ] );
+        return 1;
+    }
+
+    printf( "%u devices, %u workers, %.0f s, %.2f requests/s per device, mix %s\n", device_count, worker_count, duration_s, request_rate, mix );
+
+    rss_before_kb = resident_kb( );
+    start_us      = now_us( );
+    deadline_us   = start_us + (uint64_t) ( duration_s * 1e6 );
+
+    for ( a = 0; a < device_count; a++ )
+    {
+        devices[ a ].index = a;
+        pthread_mutex_init( &devices[ a ].lock, NULL );
+    }
+    for ( a = 0; a < worker_count; a++ )
+    {
+        workers[ a ].index = a;
+        workers[ a ].seed  = 0x9E3779B9u * ( a + 1 );
+        start_thread( &workers[ a ].thread, &workers[ a ].stack, ( a == 0 ) ? "worker 0" : NULL, worker_thread_main, &workers[ a ] );
+    }
+
+    /* Memory is sampled once every device is up, before the end of the run */
+    rss_after_kb = 0;
+    while ( now_us( ) < deadline_us )
+    {
+        double elapsed;
+
+        usleep( 100000 );
+        elapsed = ( now_us( ) - start_us ) / 1e6;
+        if ( rss_after_kb == 0 && LOAD_ATOMIC_GET( devices_ready ) == device_count )
+        {
+            rss_after_kb = resident_kb( );
+        }
+        if ( elapsed >= next_progress )
+        {
+            print_progress( elapsed );
+            next_progress += PROGRESS_INTERVAL_S;
+        }
+    }
+
+    for ( a = 0; a < worker_count; a++ )
+    {
+        pthread_join( workers[ a ].thread, NULL );
+    }
+
+    /* Push threads are left running, the report reads their counters under the device locks */
+    print_report( ( now_us( ) - start_us ) / 1e6, rss_before_kb, rss_after_kb );
+
+    return 0;
+}
+
+static void* worker_thread_main( void* arg )
+{
+    load_worker_t* worker = (load_worker_t*) arg;
+    unsigned int   owned  = 0;
+    unsigned int   a;
+
+    current_worker = worker;
+
+    /* Bootstrap: create the installations of the owned devices and start their push threads */
+    for ( a = worker->index; a < device_count && now_us( ) < deadline_us; a += worker_count )
+    {
+        load_device_t* device  = &devices[ a ];
+        uint64_t       started = now_us( );
+
+        parse_init( &device->client, app_id, client_key, "" );
+        if ( device->client.installationObjectId[ 0 ] == 0 )
+        {
+            ++worker->bootstrap_failures;
+            LOAD_ATOMIC_ADD( devices_ready, 1 );
+            continue;
+        }
+        samples_add( &worker->bootstrap, (uint32_t) ( now_us( ) - started ) );
+
+        parse_set_push_decoded_callback( &device->client, push_received );
+        start_thread( &device->push_thread, &device->push_stack, ( a < 3 ) ? "push" : NULL, push_thread_main, device );
+        device->ready = 1;
+        ++owned;
+        LOAD_ATOMIC_ADD( devices_ready, 1 );
+    }
+
+    /* Requests arrive at random, at request_rate per owned device */
+    while ( owned > 0 && request_rate > 0 )
+    {
+        double         wait_s = -log( 1.0 - rand_r( &worker->seed ) / ( RAND_MAX + 1.0 ) ) / ( request_rate * owned );
+        uint64_t       at     = now_us( ) + (uint64_t) ( wait_s * 1e6 );
+        load_device_t* device;
+        unsigned int   pick;
+        unsigned int   request;
+
+        if ( at >= deadline_us )
+        {
+            break;
+        }
+        while ( now_us( ) < at )
+        {
+            usleep( (useconds_t) MIN( at - now_us( ), 100000 ) );
+        }
+
+        do
+        {
+            device = &devices[ worker->index + worker_count * ( rand_r( &worker->seed ) % ( ( device_count - worker->index + worker_count - 1 ) / worker_count ) ) ];
+        } while ( !device->ready );
+
+        pick = (unsigned int) rand_r( &worker->seed ) % mix_total;
+        for ( request = 0; pick >= mix_weights[ request ]; request++ )
+        {
+            pick -= mix_weights[ request ];
+        }
+
+        send_load_request( worker, device, (load_request_t) request );
+    }
+
+    return NULL;
+}
+
+static void send_load_request( load_worker_t* worker, load_device_t* device, load_request_t request )
+{
+    char                 path[ 96 ];
+    char                 body[ 256 ];
+    load_reading_t       reading;
+    simple_json_writer_t writer;
+    uint64_t             started;
+
+    switch ( request )
+    {
+        case LOAD_UPDATE:
+            if ( device->object_id[ 0 ] != 0 )
+            {
+                snprintf( path, sizeof( path ), LOAD_CLASS_PATH "/%s", device->object_id );
+                memset( &reading, 0, sizeof( reading ) );
+                reading.value         = rand_r( &worker->seed ) % 1000;
+                reading.present.value = 1;
+                simpleJsonWriterInit( &writer, body, sizeof( body ) );
+                load_reading_write( &writer, &reading );
+                simpleJsonWriterFinish( &writer );
+                break;
+            }
+            /* Nothing to update yet */
+            request = LOAD_CREATE;
+            /* fall through */
+
+        case LOAD_CREATE:
+            snprintf( path, sizeof( path ), LOAD_CLASS_PATH );
+            reading.device = (int32_t) device->index;
+            reading.value  = rand_r( &worker->seed ) % 1000;
+            PARSE_SCHEMA_SET_ALL( &reading );
+            simpleJsonWriterInit( &writer, body, sizeof( body ) );
+            load_reading_write( &writer, &reading );
+            simpleJsonWriterFinish( &writer );
+            break;
+
+        case LOAD_QUERY:
+            snprintf( path, sizeof( path ), LOAD_CLASS_PATH );
+            snprintf( body, sizeof( body ), "where=%%7B%%22device%%22%%3A%u%%7D&limit=10", device->index );
+            break;
+
+        case LOAD_PUSH:
+        default:
+        {
+            const load_device_t* target = &devices[ (unsigned int) rand_r( &worker->seed ) % device_count ];
+
+            if ( !target->ready )
+            {
+                target = device;
+            }
+            snprintf( path, sizeof( path ), "/1/push" );
+            snprintf( body, sizeof( body ), "{\"where\":{\"installationId\":\"%s\"},\"data\":{\"alert\":\"load\",\"sent_us\":%lld}}",
+                      target->client.installation_id, (long long) wall_time_us( ) );
+            break;
+        }
+    }
+
+    worker->status = -1;
+    worker->device = device;
+    started        = now_us( );
+
+    parse_send_request( &device->client, ( request == LOAD_UPDATE ) ? "PUT" : ( request == LOAD_QUERY ) ? "GET" : "POST", path, body, request_done );
+
+    ++worker->requests[ request ];
+    if ( worker->status < 200 || worker->status >= 300 )
+    {
+        ++worker->errors[ request ];
+    }
+    else
+    {
+        samples_add( &worker->latency[ request ], (uint32_t) ( now_us( ) - started ) );
+    }
+}
+
+static void request_done( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody )
+{
+    load_worker_t*      worker = current_worker;
+    simple_json_value_t object_id;
+
+    UNUSED_PARAMETER( client );
+
+    worker->status = ( error == 0 ) ? httpStatus : -1;
+
+    /* Remember created objects, for updates */
+    if ( worker->status == 201 && httpResponseBody != NULL &&
+         simpleJsonQuery( httpResponseBody, strlen( httpResponseBody ), "objectId", &object_id ) &&
+         strstr( httpResponseBody, "\"push_id\"" ) == NULL )
+    {
+        simpleJsonUnescape( &object_id, worker->device->object_id, sizeof( worker->device->object_id ) );
+    }
+}
+
+static void* push_thread_main( void* arg )
+{
+    load_device_t* device = (load_device_t*) arg;
+    int            first  = 1;
+
+    while ( 1 )
+    {
+        if ( parse_start_push_service( &device->client ) != 0 )
+        {
+            pthread_mutex_lock( &device->lock );
+            ++device->push_failures;
+            pthread_mutex_unlock( &device->lock );
+            wiced_tcp_delete_socket( &device->client.tcp_socket );
+            usleep( RECONNECT_DELAY_US );
+            continue;
+        }
+
+        pthread_mutex_lock( &device->lock );
+        ++device->push_connects;
+        device->push_connected = 1;
+        pthread_mutex_unlock( &device->lock );
+        if ( !first )
+        {
+            LOAD_ATOMIC_ADD( push_reconnects, 1 );
+        }
+        first = 0;
+
+        parse_run_push_loop( &device->client );
+
+        pthread_mutex_lock( &device->lock );
+        device->push_connected = 0;
+        pthread_mutex_unlock( &device->lock );
+        wiced_tcp_delete_socket( &device->client.tcp_socket );
+    }
+
+    return NULL;
+}
+
+static void push_received( parse_client_t* client, int error, const char* data, const parse_push_t* push )
+{
+    load_device_t*             device  = (load_device_t*) client;
+    const simple_json_value_t* sent;
+    int64_t                    sent_us = 0;
+    double                     sent_s;
+
+    UNUSED_PARAMETER( data );
+
+    if ( error != 0 || push == NULL )
+    {
+        return;
+    }
+
+    if ( ( sent = parse_push_find_custom( push, "sent_us" ) ) != NULL )
+    {
+        simpleJsonGetInt64( sent, &sent_us );
+    }
+    else if ( ( sent = parse_push_find_custom( push, "sent" ) ) != NULL && simpleJsonGetDouble( sent, &sent_s ) )
+    {
+        sent_us = (int64_t) ( sent_s * 1e6 );
+    }
+
+    pthread_mutex_lock( &device->lock );
+    ++device->pushes;
+    if ( sent_us > 0 )
+    {
+        int64_t latency = wall_time_us( ) - sent_us;
+
+        samples_add( &device->push_latency, (uint32_t) MAX( latency, 0 ) );
+    }
+    pthread_mutex_unlock( &device->lock );
+}
+
+static int parse_mix( const char* mix )
+{
+    const char* p = mix;
+
+    memset( mix_weights, 0, sizeof( mix_weights ) );
+    mix_total = 0;
+
+    while ( *p != 0 )
+    {
+        unsigned int request;
+        size_t       length = strcspn( p, "=" );
+        char*        end;
+        long         weight;
+
+        for ( request = 0; request < LOAD_REQUEST_COUNT; request++ )
+        {
+            if ( strlen( request_names[ request ] ) == length && strncmp( p, request_names[ request ], length ) == 0 )
+            {
+                break;
+            }
+        }
+        if ( request == LOAD_REQUEST_COUNT || p[ length ] != '=' )
+        {
+            return -1;
+        }
+
+        weight = strtol( p + length + 1, &end, 10 );
+        if ( weight < 0 || ( *end != ',' && *end != 0 ) )
+        {
+            return -1;
+        }
+        mix_weights[ request ] = (unsigned int) weight;
+        mix_total             += (unsigned int) weight;
+        p                      = ( *end == ',' ) ? end + 1 : end;
+    }
+
+    return ( mix_total > 0 ) ? 0 : -1;
+}
+
+static void start_thread( pthread_t* thread, void** stack, const char* name, void* ( *main )( void* ), void* arg )
+{
+    pthread_attr_t attributes;
+
+    *stack = malloc( THREAD_STACK_SIZE );
+    if ( *stack == NULL )
+    {
+        fprintf( stderr, "out of memory for thread stacks\n" );
+        exit( 1 );
+    }
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    /* A few stacks are painted, the library keeps PARSE_MEMORY_MAX_STACKS of them */
+    if ( name != NULL )
+    {
+        parse_paint_stack( name, *stack, THREAD_STACK_SIZE );
+    }
+#else
+    UNUSED_PARAMETER( name );
+#endif
+
+    pthread_attr_init( &attributes );
+    pthread_attr_setstack( &attributes, *stack, THREAD_STACK_SIZE );
+    if ( pthread_create( thread, &attributes, main, arg ) != 0 )
+    {
+        fprintf( stderr, "cannot create thread\n" );
+        exit( 1 );
+    }
+    pthread_attr_destroy( &attributes );
+}
+
+static void samples_add( load_samples_t* samples, uint32_t value )
+{
+    if ( samples->count == samples->capacity )
+    {
+        size_t    capacity = ( samples->capacity == 0 ) ? 256 : samples->capacity * 2;
+        uint32_t* values   = realloc( samples->values, capacity * sizeof( uint32_t ) );
+
+        if ( values == NULL )
+        {
+            return;
+        }
+        samples->values   = values;
+        samples->capacity = capacity;
+    }
+    samples->values[ samples->count++ ] = value;
+}
+
+static void samples_merge( load_samples_t* into, const load_samples_t* from )
+{
+    size_t a;
+
+    for ( a = 0; a < from->count; a++ )
+    {
+        samples_add( into, from->values[ a ] );
+    }
+}
+
+static void print_distribution( const char* name, load_samples_t* samples, double scale, const char* unit )
+{
+    qsort( samples->values, samples->count, sizeof( uint32_t ), compare_uint32 );
+    printf( "  %-10s %8lu  p50 %8.1f  p90 %8.1f  p99 %8.1f  max %8.1f %s\n", name, (unsigned long) samples->count,
+            percentile( samples, 50 ) * scale, percentile( samples, 90 ) * scale,
+            percentile( samples, 99 ) * scale, percentile( samples, 100 ) * scale, unit );
+}
+
+static uint32_t percentile( const load_samples_t* samples, unsigned int percent )
+{
+    size_t rank;
+
+    if ( samples->count == 0 )
+    {
+        return 0;
+    }
+
+    /* Nearest rank */
+    rank = ( samples->count * percent + 99 ) / 100;
+    return samples->values[ ( rank == 0 ) ? 0 : rank - 1 ];
+}
+
+static int compare_uint32( const void* a, const void* b )
+{
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+
+    return ( x > y ) - ( x < y );
+}
+
+static uint64_t now_us( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+}
+
+static int64_t wall_time_us( void )
+{
+    struct timeval now;
+
+    gettimeofday( &now, NULL );
+    return (int64_t) now.tv_sec * 1000000 + now.tv_usec;
+}
+
+static long resident_kb( void )
+{
+    FILE* statm = fopen( "/proc/self/statm", "r" );
+    long  size;
+    long  resident = 0;
+
+    if ( statm != NULL )
+    {
+        if ( fscanf( statm, "%ld %ld", &size, &resident ) != 2 )
+        {
+            resident = 0;
+        }
+        fclose( statm );
+    }
+
+    return resident * ( sysconf( _SC_PAGESIZE ) / 1024 );
+}
+
+static void print_progress( double elapsed )
+{
+    uint32_t     requests  = 0;
+    uint32_t     pushes    = 0;
+    uint32_t     connected = 0;
+    unsigned int a;
+    unsigned int r;
+
+    /* Worker counters are read without locks, they are only a progress indication */
+    for ( a = 0; a < worker_count; a++ )
+    {
+        for ( r = 0; r < LOAD_REQUEST_COUNT; r++ )
+        {
+            requests += LOAD_ATOMIC_GET( workers[ a ].requests[ r ] );
+        }
+    }
+    for ( a = 0; a < device_count; a++ )
+    {
+        pthread_mutex_lock( &devices[ a ].lock );
+        pushes    += devices[ a ].pushes;
+        connected += (uint32_t) devices[ a ].push_connected;
+        pthread_mutex_unlock( &devices[ a ].lock );
+    }
+
+    printf( "%6.1f s  %u/%u devices up, %u push connected, %u requests, %u pushes received\n", elapsed,
+            LOAD_ATOMIC_GET( devices_ready ), device_count, connected, requests, pushes );
+    fflush( stdout );
+}
+
+static void print_report( double elapsed, long rss_before_kb, long rss_after_kb )
+{
+    load_samples_t     bootstrap = { NULL, 0, 0 };
+    load_samples_t     latency[ LOAD_REQUEST_COUNT ];
+    load_samples_t     push_latency = { NULL, 0, 0 };
+    uint32_t           requests = 0;
+    uint32_t           errors   = 0;
+    uint32_t           bootstrap_failures = 0;
+    uint32_t           pushes   = 0;
+    uint32_t           push_connects = 0;
+    uint32_t           push_failures = 0;
+    uint32_t           connected = 0;
+    uint32_t           push_threads = 0;
+    wiced_host_stats_t stats;
+    unsigned int       a;
+    unsigned int       r;
+
+    memset( latency, 0, sizeof( latency ) );
+    wiced_host_get_stats( &stats );
+
+    for ( a = 0; a < worker_count; a++ )
+    {
+        bootstrap_failures += workers[ a ].bootstrap_failures;
+        samples_merge( &bootstrap, &workers[ a ].bootstrap );
+        for ( r = 0; r < LOAD_REQUEST_COUNT; r++ )
+        {
+            requests += workers[ a ].requests[ r ];
+            errors   += workers[ a ].errors[ r ];
+            samples_merge( &latency[ r ], &workers[ a ].latency[ r ] );
+        }
+    }
+    for ( a = 0; a < device_count; a++ )
+    {
+        pthread_mutex_lock( &devices[ a ].lock );
+        pushes        += devices[ a ].pushes;
+        push_connects += devices[ a ].push_connects;
+        push_failures += devices[ a ].push_failures;
+        connected     += (uint32_t) devices[ a ].push_connected;
+        push_threads  += (uint32_t) devices[ a ].ready;
+        samples_merge( &push_latency, &devices[ a ].push_latency );
+        pthread_mutex_unlock( &devices[ a ].lock );
+    }
+
+    printf( "\nran %.1f s\n", elapsed );
+
+    printf( "bootstrap: %lu installations, %u failed\n", (unsigned long) bootstrap.count, bootstrap_failures );
+    print_distribution( "install", &bootstrap, 1e-3, "ms" );
+
+    printf( "requests: %u, %u failed, %.1f/s\n", requests, errors, requests / elapsed );
+    for ( r = 0; r < LOAD_REQUEST_COUNT; r++ )
+    {
+        if ( mix_weights[ r ] != 0 )
+        {
+            print_distribution( request_names[ r ], &latency[ r ], 1e-3, "ms" );
+        }
+    }
+
+    printf( "push: %u received, %.1f/s, %u connected at the end\n", pushes, pushes / elapsed, connected );
+    print_distribution( "delivery", &push_latency, 1e-3, "ms" );
+
+    printf( "connections: %u TCP connects (%.1f/s), %u TLS handshakes, %u push connects, %u push reconnects, %u push connect failures\n",
+            stats.connects, stats.connects / elapsed, stats.tls_handshakes, push_connects, LOAD_ATOMIC_GET( push_reconnects ), push_failures );
+    printf( "traffic: %.1f KB sent, %.1f KB received, peak %u packets in use\n",
+            stats.bytes_sent / 1024.0, stats.bytes_received / 1024.0, stats.packets_peak );
+
+    printf( "memory: parse_client_t %lu bytes, %u threads with their own library buffers", (unsigned long) sizeof( parse_client_t ), worker_count + push_threads );
+    if ( rss_after_kb > rss_before_kb )
+    {
+        printf( ", resident +%.1f KB per device", (double) ( rss_after_kb - rss_before_kb ) / device_count );
+    }
+    printf( "\n" );
+
+#ifdef PARSE_ENABLE_MEMORY_STATS
+    {
+        uint32_t            library = 0;
+        parse_stack_usage_t stack;
+
+        for ( r = 0; r < PARSE_MEMORY_BUFFER_COUNT; r++ )
+        {
+            parse_memory_usage_t usage;
+
+            if ( parse_get_memory_usage( (parse_memory_buffer_t) r, &usage ) == WICED_SUCCESS && usage.location == PARSE_MEMORY_STATIC )
+            {
+                library += usage.size;
+            }
+        }
+        printf( "  library buffers %lu bytes per thread\n", (unsigned long) library );
+
+        for ( r = 0; parse_get_stack_usage( r, &stack ) == WICED_SUCCESS; r++ )
+        {
+            printf( "  stack of %-8s %6lu bytes used\n", stack.name, (unsigned long) stack.used );
+        }
+    }
+#endif
+}
@@ -0,0 +1,666 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Local mock of api.parse.com and push.parse.com for load and latency tests.
+
+Usage:
+    parse_mock.py [--https-port 8443] [--push-port 8253]
+                  [--latency 20 --jitter 10] [--bandwidth 20000] [--fragment 512] [--chunked]
+                  [--error-rate 0.01] [--drop-rate 0.01]
+                  [--push-interval 1 --push-size 256]
+
+Point the host build at it and trust its certificate:
+    make -C tools/parse_host PARSE_SERVER=localhost HTTPS_PORT=8443 PUSH_SERVER=localhost
+    WICED_HOST_CA_FILE=tools/parse_mock/certs/cert.pem ./client
+
+REST runs over HTTPS with a self-signed certificate, generated with the
+openssl command line tool on first use. It keeps objects in memory and serves
+/1/installations, /1/classes/<class>, /1/batch and /1/push, plus
+GET /mock/stats with the server counters.
+
+Push runs over plain TCP like push.parse.com: the client's first line is its
+handshake, "{}" keepalive lines are echoed and notifications are written as
+one JSON object per line. POST /1/push and --push-interval send them.
+
+Every REST response and push line goes through the injector: --latency and
+--jitter delay it, --bandwidth caps the write rate, --fragment writes it in
+pieces of that many bytes, --error-rate answers with a Parse error instead
+and --drop-rate closes the connection before or half way through it.
+--chunked frames REST bodies in chunks instead of with a Content-Length.
+"""
+
+import argparse
+import asyncio
+import collections
+import json
+import os
+import random
+import signal
+import ssl
+import string
+import subprocess
+import sys
+import time
+import urllib.parse
+from datetime import datetime, timezone
+
+ID_CHARS = string.ascii_letters + string.digits
+MISSING = object()
+
+# Parse error codes
+INTERNAL_SERVER_ERROR = 1
+OBJECT_NOT_FOUND = 101
+INVALID_QUERY = 102
+INVALID_JSON = 107
+INCORRECT_TYPE = 111
+REQUEST_LIMIT_EXCEEDED = 155
+
+QUERY_LIMIT_DEFAULT = 100
+QUERY_LIMIT_MAX = 1000
+BATCH_LIMIT = 50
+MAX_BODY = 1 << 20
+
+# Responses used by --error-rate, as the real service returned them under load
+INJECTED_ERRORS = (
+    (500, INTERNAL_SERVER_ERROR, "Internal server error."),
+    (429, REQUEST_LIMIT_EXCEEDED, "This application performed too many requests."),
+)
+
+REASONS = {200: "OK", 201: "Created", 400: "Bad Request", 401: "Unauthorized",
+           404: "Not Found", 405: "Method Not Allowed", 413: "Payload Too Large",
+           429: "Too Many Requests", 500: "Internal Server Error"}
+
+
+class ParseError(Exception):
+    def __init__(self, status, code, message):
+        super().__init__(message)
+        self.status = status
+        self.code = code
+        self.message = message
+
+    def body(self):
+        return {"code": self.code, "error": self.message}
+
+
+def now_iso():
+    now = datetime.now(timezone.utc)
+    return now.strftime("%Y-%m-%dT%H:%M:%S.") + "%03dZ" % (now.microsecond // 1000)
+
+
+def unwrap(value):
+    """Dates in queries arrive as {"__type": "Date", "iso": ...}, stored as the iso string."""
+    if isinstance(value, dict) and value.get("__type") == "Date":
+        return value.get("iso")
+    return value
+
+
+class Injector:
+    """Delays, throttles, fragments, fails or drops responses."""
+
+    def __init__(self, args, stats):
+        self.rng = random.Random(args.seed)
+        self.latency = args.latency / 1000.0
+        self.jitter = args.jitter / 1000.0
+        self.bandwidth = args.bandwidth
+        self.fragment = args.fragment
+        self.fragment_delay = args.fragment_delay / 1000.0
+        self.error_rate = args.error_rate
+        self.drop_rate = args.drop_rate
+        self.stats = stats
+
+    async def delay(self):
+        wait = self.latency
+        if self.jitter:
+            wait += self.rng.uniform(0, self.jitter)
+        if wait > 0:
+            await asyncio.sleep(wait)
+
+    def error(self):
+        if self.error_rate and self.rng.random() < self.error_rate:
+            self.stats["inject.errors"] += 1
+            return self.rng.choice(INJECTED_ERRORS)
+        return None
+
+    def drop(self):
+        """Returns None, "before" to drop before the response or "during" to cut it short."""
+        if self.drop_rate and self.rng.random() < self.drop_rate:
+            self.stats["inject.drops"] += 1
+            return self.rng.choice(("before", "during"))
+        return None
+
+    async def write(self, writer, data):
+        size = self.fragment or (1460 if self.bandwidth else len(data))
+        for offset in range(0, len(data), size):
+            chunk = data[offset:offset + size]
+            writer.write(chunk)
+            await writer.drain()
+            self.stats["bytes.out"] += len(chunk)
+            pause = self.fragment_delay if offset + size < len(data) else 0
+            if self.bandwidth:
+                pause = max(pause, len(chunk) / float(self.bandwidth))
+            if pause:
+                await asyncio.sleep(pause)
+
+
+class Store:
+    """In memory classes of objects, with the Parse update operators and query constraints."""
+
+    def __init__(self, rng):
+        self.rng = rng
+        self.classes = collections.defaultdict(dict)
+
+    def new_id(self, objects):
+        while True:
+            object_id = "".join(self.rng.choice(ID_CHARS) for _ in range(10))
+            if object_id not in objects:
+                return object_id
+
+    def create(self, class_name, body):
+        objects = self.classes[class_name]
+        obj = {}
+        self.apply(obj, body)
+        obj["objectId"] = self.new_id(objects)
+        obj["createdAt"] = obj["updatedAt"] = now_iso()
+        objects[obj["objectId"]] = obj
+        return obj
+
+    def get(self, class_name, object_id):
+        obj = self.classes[class_name].get(object_id)
+        if obj is None:
+            raise ParseError(404, OBJECT_NOT_FOUND, "object not found for get")
+        return obj
+
+    def update(self, class_name, object_id, body):
+        obj = self.classes[class_name].get(object_id)
+        if obj is None:
+            raise ParseError(404, OBJECT_NOT_FOUND, "object not found for update")
+        changed = self.apply(obj, body)
+        obj["updatedAt"] = now_iso()
+        changed["updatedAt"] = obj["updatedAt"]
+        return changed
+
+    def delete(self, class_name, object_id):
+        if self.classes[class_name].pop(object_id, None) is None:
+            raise ParseError(404, OBJECT_NOT_FOUND, "object not found for delete")
+
+    def find(self, class_name, where):
+        return [obj for obj in self.classes[class_name].values() if self.matches(obj, where)]
+
+    @staticmethod
+    def apply(obj, body):
+        """Applies a create or update body, returns the fields set by operators."""
+        if not isinstance(body, dict):
+            raise ParseError(400, INVALID_JSON, "invalid JSON")
+        changed = {}
+        for key, value in body.items():
+            if key in ("objectId", "createdAt", "updatedAt"):
+                continue
+            if not isinstance(value, dict) or "__op" not in value:
+                obj[key] = value
+                continue
+            op = value["__op"]
+            if op == "Delete":
+                obj.pop(key, None)
+            elif op == "Increment":
+                current = obj.get(key, 0)
+                amount = value.get("amount", 1)
+                if isinstance(current, bool) or not isinstance(current, (int, float)) or not isinstance(amount, (int, float)):
+                    raise ParseError(400, INCORRECT_TYPE, "cannot increment a non-number type")
+                obj[key] = changed[key] = current + amount
+            elif op in ("Add", "AddUnique", "Remove"):
+                current = list(obj.get(key, []))
+                items = value.get("objects", [])
+                if not isinstance(current, list) or not isinstance(items, list):
+                    raise ParseError(400, INCORRECT_TYPE, "%s requires an array" % op)
+                if op == "Add":
+                    current.extend(items)
+                elif op == "AddUnique":
+                    current.extend(item for item in items if item not in current)
+                else:
+                    current = [item for item in current if item not in items]
+                obj[key] = changed[key] = current
+            else:
+                raise ParseError(400, INVALID_JSON, "unknown operator %s" % op)
+        return changed
+
+    @staticmethod
+    def matches(obj, where):
+        for key, condition in where.items():
+            value = obj.get(key, MISSING)
+            if isinstance(condition, dict) and any(name.startswith("$") for name in condition):
+                for op, argument in condition.items():
+                    if not Store.check(op, value, unwrap(argument)):
+                        return False
+            elif isinstance(value, list) and not isinstance(condition, list):
+                if condition not in value:
+                    return False
+            elif value is MISSING or value != unwrap(condition):
+                return False
+        return True
+
+    @staticmethod
+    def check(op, value, argument):
+        if op == "$exists":
+            return (value is not MISSING) == bool(argument)
+        if op == "$ne":
+            return value != argument
+        if op == "$nin":
+            return value not in argument
+        if value is MISSING:
+            return False
+        if op == "$in":
+            if isinstance(value, list):
+                return any(item in argument for item in value)
+            return value in argument
+        if op == "$all":
+            return isinstance(value, list) and all(item in value for item in argument)
+        comparisons = {"$gt": lambda a, b: a > b, "$gte": lambda a, b: a >= b,
+                       "$lt": lambda a, b: a < b, "$lte": lambda a, b: a <= b}
+        if op not in comparisons:
+            raise ParseError(400, INVALID_QUERY, "Invalid query operator %s" % op)
+        try:
+            return comparisons[op](value, argument)
+        except TypeError:
+            return False
+
+
+class PushClient:
+    def __init__(self, server, writer, installation_id):
+        self.server = server
+        self.writer = writer
+        self.installation_id = installation_id
+        self.queue = asyncio.Queue()
+
+    async def run(self):
+        injector = self.server.injector
+        while True:
+            line = await self.queue.get()
+            if injector.drop():
+                self.writer.transport.abort()
+                return
+            await injector.delay()
+            await injector.write(self.writer, line.encode("utf-8") + b"\n")
+
+
+class MockServer:
+    def __init__(self, args):
+        self.args = args
+        self.stats = collections.Counter()
+        self.injector = Injector(args, self.stats)
+        self.store = Store(random.Random(args.seed))
+        self.push_clients = collections.defaultdict(set)
+        self.push_sequence = 0
+
+    # REST
+
+    async def handle_rest(self, reader, writer):
+        self.stats["rest.connections"] += 1
+        try:
+            while await self.serve_request(reader, writer):
+                pass
+        except (ConnectionError, asyncio.IncompleteReadError, asyncio.LimitOverrunError, ssl.SSLError):
+            pass
+        finally:
+            writer.close()
+
+    async def serve_request(self, reader, writer):
+        """Serves one request, returns True to keep the connection open."""
+        try:
+            head = await asyncio.wait_for(reader.readuntil(b"\r\n\r\n"), self.args.idle_timeout)
+        except (asyncio.TimeoutError, asyncio.IncompleteReadError):
+            return False
+        lines = head.decode("latin-1").split("\r\n")
+        parts = lines[0].split(" ")
+        if len(parts) != 3:
+            return False
+        method, target, version = parts
+        headers = {}
+        for line in lines[1:]:
+            if ":" in line:
+                name, value = line.split(":", 1)
+                headers[name.strip().lower()] = value.strip()
+
+        length = int(headers.get("content-length", "0") or 0)
+        if length > MAX_BODY:
+            await self.respond(writer, 413, {"code": INVALID_JSON, "error": "request too large"}, False)
+            return False
+        body = await reader.readexactly(length) if length else b""
+
+        keep_alive = (version == "HTTP/1.1" and headers.get("connection", "").lower() != "close"
+                      and not self.args.close)
+        started = time.monotonic()
+
+        url = urllib.parse.urlsplit(target)
+        if url.path == "/mock/stats":
+            await self.respond(writer, 200, self.snapshot(), keep_alive)
+            return keep_alive
+
+        self.stats["rest.requests"] += 1
+        drop = self.injector.drop()
+        if drop == "before":
+            writer.transport.abort()
+            return False
+
+        injected = self.injector.error()
+        if injected is not None:
+            status, payload = injected[0], {"code": injected[1], "error": injected[2]}
+        else:
+            status, payload = self.dispatch_checked(method, url, headers, body)
+        self.stats["rest.status.%d" % status] += 1
+
+        await self.injector.delay()
+        data = self.encode(status, payload, keep_alive)
+        if drop == "during":
+            await self.injector.write(writer, data[:len(data) // 2])
+            writer.transport.abort()
+            return False
+        await self.injector.write(writer, data)
+
+        if self.args.verbose:
+            print("%s %s %d %.1fms" % (method, target, status, (time.monotonic() - started) * 1000.0), flush=True)
+        return keep_alive
+
+    async def respond(self, writer, status, payload, keep_alive):
+        data = self.encode(status, payload, keep_alive)
+        writer.write(data)
+        await writer.drain()
+
+    def encode(self, status, payload, keep_alive):
+        body = json.dumps(payload, separators=(",", ":")).encode("utf-8")
+        if self.args.chunked:
+            # Two chunks and the last one, as a server that streams its responses sends them
+            half = len(body) // 2
+            framing = "Transfer-Encoding: chunked"
+            body = b"".join(b"%x\r\n%s\r\n" % (len(part), part) for part in (body[:half], body[half:]) if part) + b"0\r\n\r\n"
+        else:
+            framing = "Content-Length: %d" % len(body)
+        head = ("HTTP/1.1 %d %s\r\n"
+                "Content-Type: application/json; charset=utf-8\r\n"
+                "%s\r\n"
+                "Connection: %s\r\n\r\n") % (status, REASONS.get(status, ""), framing,
+                                             "keep-alive" if keep_alive else "close")
+        return head.encode("latin-1") + body
+
+    def dispatch_checked(self, method, url, headers, body):
+        application_id = headers.get("x-parse-application-id")
+        if not application_id or (self.args.app_id and application_id != self.args.app_id):
+            return 401, {"error": "unauthorized"}
+        try:
+            payload = json.loads(body.decode("utf-8")) if body else {}
+        except ValueError:
+            return 400, {"code": INVALID_JSON, "error": "invalid JSON"}
+        query = dict(urllib.parse.parse_qsl(url.query))
+        try:
+            return self.dispatch(method, url.path, query, payload)
+        except ParseError as error:
+            return error.status, error.body()
+
+    def dispatch(self, method, path, query, body):
+        parts = [part for part in path.split("/") if part]
+        if len(parts) < 2 or parts[0] != "1":
+            raise ParseError(404, INVALID_JSON, "unknown endpoint %s" % path)
+        self.stats["rest.%s %s" % (method, parts[1])] += 1
+
+        if parts[1] == "installations" and len(parts) <= 3:
+            class_name, object_id = "_Installation", parts[2] if len(parts) == 3 else None
+        elif parts[1] == "classes" and 3 <= len(parts) <= 4:
+            class_name, object_id = parts[2], parts[3] if len(parts) == 4 else None
+        elif parts == ["1", "batch"] and method == "POST":
+            return 200, self.batch(body)
+        elif parts == ["1", "push"] and method == "POST":
+            return 200, self.push(body)
+        else:
+            raise ParseError(404, INVALID_JSON, "unknown endpoint %s" % path)
+
+        if object_id is None:
+            if method == "POST":
+                return self.create(class_name, body)
+            if method == "GET":
+                return 200, self.query(class_name, query)
+        elif method == "GET":
+            return 200, self.store.get(class_name, object_id)
+        elif method == "PUT":
+            return 200, self.store.update(class_name, object_id, body)
+        elif method == "DELETE":
+            self.store.delete(class_name, object_id)
+            return 200, {}
+        raise ParseError(405, INVALID_JSON, "method %s not allowed on %s" % (method, path))
+
+    def create(self, class_name, body):
+        # Installations are unique per installationId, a second create updates the first
+        if class_name == "_Installation" and isinstance(body, dict) and "installationId" in body:
+            for obj in self.store.find(class_name, {"installationId": body["installationId"]}):
+                self.store.update(class_name, obj["objectId"], body)
+                return 200, {"objectId": obj["objectId"], "createdAt": obj["createdAt"]}
+        obj = self.store.create(class_name, body)
+        return 201, {"objectId": obj["objectId"], "createdAt": obj["createdAt"]}
+
+    def query(self, class_name, query):
+        try:
+            where = json.loads(query.get("where", "{}"))
+            limit = min(int(query.get("limit", QUERY_LIMIT_DEFAULT)), QUERY_LIMIT_MAX)
+            skip = int(query.get("skip", 0))
+        except ValueError:
+            raise ParseError(400, INVALID_QUERY, "invalid query")
+        if not isinstance(where, dict):
+            raise ParseError(400, INVALID_QUERY, "where must be an object")
+
+        results = self.store.find(class_name, where)
+        for key in reversed([key for key in query.get("order", "").split(",") if key]):
+            name = key.lstrip("-")
+            results.sort(key=lambda obj: (name in obj, str(type(obj.get(name))), obj.get(name, 0)),
+                         reverse=key.startswith("-"))
+
+        response = {}
+        if query.get("count") == "1":
+            response["count"] = len(results)
+        results = results[skip:skip + limit]
+        if "keys" in query:
+            keys = set(query["keys"].split(",")) | {"objectId", "createdAt", "updatedAt"}
+            results = [{key: value for key, value in obj.items() if key in keys} for obj in results]
+        response["results"] = results
+        return response
+
+    def batch(self, body):
+        requests = body.get("requests") if isinstance(body, dict) else None
+        if not isinstance(requests, list):
+            raise ParseError(400, INVALID_JSON, "requests must be an array")
+        if len(requests) > BATCH_LIMIT:
+            raise ParseError(400, INVALID_JSON, "too many requests in one batch, the limit is %d" % BATCH_LIMIT)
+        results = []
+        for request in requests:
+            try:
+                url = urllib.parse.urlsplit(request.get("path", ""))
+                _, payload = self.dispatch(request.get("method", "GET"), url.path,
+                                           dict(urllib.parse.parse_qsl(url.query)), request.get("body", {}))
+                results.append({"success": payload})
+            except ParseError as error:
+                results.append({"error": error.body()})
+        return results
+
+    # Push
+
+    def push(self, body):
+        if not isinstance(body, dict) or not isinstance(body.get("data"), dict):
+            raise ParseError(400, INVALID_JSON, "push requires a data object")
+        targets = None
+        if "where" in body:
+            targets = {obj.get("installationId") for obj in self.store.find("_Installation", body["where"])}
+        elif "channels" in body:
+            channels = set(body["channels"])
+            targets = {obj.get("installationId") for obj in self.store.find("_Installation", {})
+                       if channels & set(obj.get("channels", []))}
+        self.publish(body["data"], targets, body.get("channels"))
+        return {"result": True}
+
+    def publish(self, data, targets=None, channels=None):
+        self.push_sequence += 1
+        message = {"time": now_iso(), "push_id": "%010d" % self.push_sequence, "data": data}
+        if channels:
+            message["channels"] = channels
+        line = json.dumps(message, separators=(",", ":"))
+        for installation_id, clients in self.push_clients.items():
+            if targets is None or installation_id in targets:
+                for client in clients:
+                    client.queue.put_nowait(line)
+                    self.stats["push.sent"] += 1
+
+    async def handle_push(self, reader, writer):
+        self.stats["push.connections"] += 1
+        client = None
+        task = None
+        try:
+            line = await asyncio.wait_for(reader.readline(), self.args.idle_timeout)
+            handshake = json.loads(line.decode("utf-8"))
+            installation_id = handshake.get("installation_id")
+            if not installation_id:
+                return
+            client = PushClient(self, writer, installation_id)
+            self.push_clients[installation_id].add(client)
+            task = asyncio.ensure_future(client.run())
+            client.queue.put_nowait("{}")
+
+            while True:
+                line = await reader.readline()
+                if not line:
+                    break
+                if line.strip() == b"{}":
+                    self.stats["push.keepalives"] += 1
+                    client.queue.put_nowait("{}")
+        except (ValueError, AttributeError, asyncio.TimeoutError, ConnectionError):
+            pass
+        finally:
+            if client is not None:
+                self.push_clients[client.installation_id].discard(client)
+                if not self.push_clients[client.installation_id]:
+                    del self.push_clients[client.installation_id]
+            if task is not None:
+                task.cancel()
+            writer.close()
+
+    async def push_generator(self):
+        """Broadcasts a notification every --push-interval seconds, for push load tests."""
+        sequence = 0
+        while True:
+            await asyncio.sleep(self.args.push_interval)
+            sequence += 1
+            alert = "Notification %d " % sequence
+            alert += "x" * max(0, self.args.push_size - len(alert))
+            self.publish({"alert": alert, "badge": sequence, "seq": sequence, "sent": time.time()})
+
+    def snapshot(self):
+        stats = dict(self.stats)
+        stats["push.connected"] = sum(len(clients) for clients in self.push_clients.values())
+        stats["objects"] = sum(len(objects) for objects in self.store.classes.values())
+        return stats
+
+
+def ensure_certificate(directory, key_type):
+    """Creates a self-signed certificate for localhost and the Parse host names, once."""
+    cert = os.path.join(directory, "cert.pem")
+    key = os.path.join(directory, "key.pem")
+    if os.path.exists(cert) and os.path.exists(key):
+        return cert, key
+    os.makedirs(directory, exist_ok=True)
+    if key_type == "ec":
+        new_key = ["-newkey", "ec", "-pkeyopt", "ec_paramgen_curve:prime256v1"]
+    else:
+        new_key = ["-newkey", "rsa:2048"]
+    subprocess.check_call(["openssl", "req", "-x509", "-nodes", "-days", "3650"] + new_key +
+                          ["-keyout", key, "-out", cert, "-subj", "/CN=localhost",
+                           "-addext", "subjectAltName=DNS:localhost,DNS:api.parse.com,DNS:push.parse.com,IP:127.0.0.1"],
+                          stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    return cert, key
+
+
+async def serve(args):
+    cert, key = ensure_certificate(args.cert_dir, args.key_type)
+    context = ssl.create_default_context(ssl.Purpose.CLIENT_AUTH)
+    context.load_cert_chain(cert, key)
+
+    server = MockServer(args)
+    rest = await asyncio.start_server(server.handle_rest, args.host, args.https_port, ssl=context, backlog=1024)
+    push = await asyncio.start_server(server.handle_push, args.host, args.push_port, backlog=1024)
+    if args.push_interval > 0:
+        asyncio.ensure_future(server.push_generator())
+
+    # Stop cleanly on Ctrl-C or kill, so the counters are always printed
+    loop = asyncio.get_running_loop()
+    task = asyncio.current_task()
+    for number in (signal.SIGINT, signal.SIGTERM):
+        loop.add_signal_handler(number, task.cancel)
+
+    print("REST https://%s:%d, push tcp://%s:%d, certificate %s" % (args.host, args.https_port, args.host, args.push_port, cert), flush=True)
+    try:
+        async with rest, push:
+            await asyncio.gather(rest.serve_forever(), push.serve_forever())
+    finally:
+        print(json.dumps(server.snapshot(), indent=1, sort_keys=True), file=sys.stderr)
+
+
+def main():
+    directory = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="Local mock of the Parse REST and push servers")
+    parser.add_argument("--host", default="127.0.0.1", help="address to listen on")
+    parser.add_argument("--https-port", type=int, default=8443, help="REST port, HTTPS")
+    parser.add_argument("--push-port", type=int, default=8253, help="push port, plain TCP")
+    parser.add_argument("--cert-dir", default=os.path.join(directory, "certs"), help="where the certificate is kept")
+    parser.add_argument("--key-type", choices=("rsa", "ec"), default="rsa", help="key type of a new certificate")
+    parser.add_argument("--app-id", help="only accept this X-Parse-Application-Id")
+    parser.add_argument("--close", action="store_true", help="close REST connections after every response")
+    parser.add_argument("--idle-timeout", type=float, default=30.0, help="seconds before an idle connection is closed")
+    parser.add_argument("--latency", type=float, default=0.0, help="milliseconds added before every response")
+    parser.add_argument("--jitter", type=float, default=0.0, help="random milliseconds added on top of --latency")
+    parser.add_argument("--bandwidth", type=int, default=0, help="bytes per second per connection, 0 for unlimited")
+    parser.add_argument("--fragment", type=int, default=0, help="write responses in pieces of this many bytes")
+    parser.add_argument("--fragment-delay", type=float, default=0.0, help="milliseconds between pieces")
+    parser.add_argument("--chunked", action="store_true", help="send REST bodies with Transfer-Encoding: chunked")
+    parser.add_argument("--error-rate", type=float, default=0.0, help="fraction of requests answered with an error")
+    parser.add_argument("--drop-rate", type=float, default=0.0, help="fraction of responses cut off by closing the connection")
+    parser.add_argument("--push-interval", type=float, default=0.0, help="seconds between broadcast notifications, 0 for none")
+    parser.add_argument("--push-size", type=int, default=64, help="alert length of broadcast notifications")
+    parser.add_argument("--seed", type=int, help="random seed, for repeatable injection")
+    parser.add_argument("-v", "--verbose", action="store_true", help="log every request")
+    args = parser.parse_args()
+
+    try:
+        asyncio.run(serve(args))
+    except (KeyboardInterrupt, asyncio.CancelledError):
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Size and speed of the compact time series encoding
+ *
+ * Encodes synthetic series of the shapes telemetry usually has and prints,
+ * per sample, the bytes of the stream, of its base64 text and of the plain
+ * JSON "dt" and "v" arrays it replaces, and the encoding time including
+ * the base64 step. With -o every series is also written as a JSON line for
+ * time_series_decode.py --check.
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "time_series.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define MAX_SAMPLES             ( 1024 )
+#define DEFAULT_REPEAT          ( 2000 )
+#define SAMPLE_INTERVAL_MS      ( 1000 )
+
+/******************************************************
+ *                   Enumerations
+ ******************************************************/
+
+typedef enum
+{
+    SIGNAL_CONSTANT,
+    SIGNAL_COUNTER,
+    SIGNAL_TEMPERATURE,
+    SIGNAL_NOISE,
+} bench_signal_t;
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    const char*    name;
+    bench_signal_t signal;
+    uint32_t       jitter_ms;   /* Largest error of the sampling time */
+} bench_series_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static uint32_t bench_random  ( void );
+static void     generate      ( const bench_series_t* series, uint32_t count, uint32_t* times, float* values );
+static uint32_t encode        ( uint32_t count, const uint32_t* times, const float* values, uint8_t* buffer, uint32_t size );
+static uint32_t json_length   ( uint32_t count, const uint32_t* times, const float* values );
+static double   time_ns       ( void );
+static void     dump          ( FILE* file, const bench_series_t* series, uint32_t count, const uint32_t* times, const float* values, const uint8_t* text, uint32_t length );
+static void     usage         ( const char* program );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const bench_series_t bench_series[ ] =
+{
+    { "constant",         SIGNAL_CONSTANT,    0   },
+    { "counter",          SIGNAL_COUNTER,     0   },
+    { "temperature",      SIGNAL_TEMPERATURE, 0   },
+    { "temperature+jit",  SIGNAL_TEMPERATURE, 20  },
+    { "noise",            SIGNAL_NOISE,       0   },
+    { "noise+jitter",     SIGNAL_NOISE,       300 },
+};
+
+static const uint32_t bench_counts[ ] = { 32, MAX_SAMPLES };
+
+static uint32_t random_state = 12345;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+static uint32_t bench_random( void )
+{
+    /* xorshift32, the same series on every run */
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+static void generate( const bench_series_t* series, uint32_t count, uint32_t* times, float* values )
+{
+    float    level = 21.5f;
+    uint32_t time  = 1444000000;
+    uint32_t i;
+
+    random_state = 12345;
+    for ( i = 0; i < count; i++ )
+    {
+        times[ i ] = time;
+        if ( series->jitter_ms != 0 )
+        {
+            times[ i ] += bench_random( ) % ( 2 * series->jitter_ms + 1 ) - series->jitter_ms;
+        }
+        time += SAMPLE_INTERVAL_MS;
+
+        switch ( series->signal )
+        {
+            case SIGNAL_CONSTANT:
+                values[ i ] = 3.3f;
+                break;
+
+            case SIGNAL_COUNTER:
+                values[ i ] = (float) ( i * 7 );
+                break;
+
+            case SIGNAL_TEMPERATURE:
+                /* A sensor with a 0.0625 degree resolution, drifting slowly */
+                if ( bench_random( ) % 4 == 0 )
+                {
+                    level += ( bench_random( ) % 2 == 0 ) ? 0.0625f : -0.0625f;
+                }
+                values[ i ] = level;
+                break;
+
+            case SIGNAL_NOISE:
+                values[ i ] = 20.0f + (float) sin( i / 10.0 ) + (float) ( bench_random( ) % 1000 ) / 1000.0f;
+                break;
+        }
+    }
+}
+
+static uint32_t encode( uint32_t count, const uint32_t* times, const float* values, uint8_t* buffer, uint32_t size )
+{
+    time_series_encoder_t encoder;
+    uint32_t i;
+
+    time_series_encoder_init( &encoder, buffer, size );
+    for ( i = 0; i < count; i++ )
+    {
+        if ( time_series_encode( &encoder, times[ i ], values[ i ] ) != WICED_SUCCESS )
+        {
+            return 0;
+        }
+    }
+    return time_series_encoder_length( &encoder );
+}
+
+/* The ,"dt":[...],"v":[...] members of the plain telemetry object */
+static uint32_t json_length( uint32_t count, const uint32_t* times, const float* values )
+{
+    char     number[ 32 ];
+    uint32_t length = (uint32_t) strlen( ",\"dt\":[],\"v\":[]" );
+    uint32_t i;
+
+    for ( i = 0; i < count; i++ )
+    {
+        length += (uint32_t) snprintf( number, sizeof( number ), "%" PRIu32, times[ i ] - times[ 0 ] );
+        length += (uint32_t) snprintf( number, sizeof( number ), "%g", values[ i ] );
+        length += ( i > 0 ) ? 2 : 0;
+    }
+    return length;
+}
+
+static double time_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+}
+
+static void dump( FILE* file, const bench_series_t* series, uint32_t count, const uint32_t* times, const float* values, const uint8_t* text, uint32_t length )
+{
+    uint32_t i;
+
+    fprintf( file, "{\"name\":\"%s\",\"n\":%" PRIu32 ",\"data\":\"%.*s\",\"dt\":[", series->name, count, (int) length, (const char*) text );
+    for ( i = 0; i < count; i++ )
+    {
+        fprintf( file, "%s%" PRIu32, ( i > 0 ) ? "," : "", times[ i ] - times[ 0 ] );
+    }
+    fprintf( file, "],\"v\":[" );
+    for ( i = 0; i < count; i++ )
+    {
+        fprintf( file, "%s%.9g", ( i > 0 ) ? "," : "", values[ i ] );
+    }
+    fprintf( file, "]}\n" );
+}
+
+static void usage( const char* program )
+{
+    fprintf( stderr, "usage: %s [-r repeat] [-o dump.jsonl]\n", program );
+    exit( 2 );
+}
+
+int main( int argc, char** argv )
+{
+    static uint32_t times[ MAX_SAMPLES ];
+    static float    values[ MAX_SAMPLES ];
+    static uint8_t  buffer[ TIME_SERIES_BASE64_LENGTH( TIME_SERIES_MAX_BYTES( MAX_SAMPLES ) ) ];
+    uint32_t repeat = DEFAULT_REPEAT;
+    FILE*    output = NULL;
+    size_t   s;
+    size_t   c;
+    int      i;
+
+    for ( i = 1; i < argc; i++ )
+    {
+        if ( strcmp( argv[ i ], "-r" ) == 0 && i + 1 < argc )
+        {
+            repeat = (uint32_t) strtoul( argv[ ++i ], NULL, 10 );
+        }
+        else if ( strcmp( argv[ i ], "-o" ) == 0 && i + 1 < argc )
+        {
+            output = fopen( argv[ ++i ], "w" );
+            if ( output == NULL )
+            {
+                perror( argv[ i ] );
+                return 1;
+            }
+        }
+        else
+        {
+            usage( argv[ 0 ] );
+        }
+    }
+    if ( repeat == 0 )
+    {
+        usage( argv[ 0 ] );
+    }
+
+    printf( "%-16s %5s %10s %10s %10s %8s\n", "series", "n", "bits/smp", "b64 B/smp", "json B/smp", "ns/smp" );
+    for ( s = 0; s < sizeof( bench_series ) / sizeof( bench_series[ 0 ] ); s++ )
+    {
+        for ( c = 0; c < sizeof( bench_counts ) / sizeof( bench_counts[ 0 ] ); c++ )
+        {
+            uint32_t count = bench_counts[ c ];
+            uint32_t length;
+            uint32_t text_length = 0;
+            double   start;
+            double   elapsed;
+            uint32_t r;
+
+            generate( &bench_series[ s ], count, times, values );
+            length = encode( count, times, values, buffer, sizeof( buffer ) );
+
+            start = time_ns( );
+            for ( r = 0; r < repeat; r++ )
+            {
+                text_length = time_series_base64( buffer, encode( count, times, values, buffer, sizeof( buffer ) ), sizeof( buffer ) );
+            }
+            elapsed = time_ns( ) - start;
+
+            printf( "%-16s %5" PRIu32 " %10.2f %10.2f %10.2f %8.1f\n", bench_series[ s ].name, count,
+                    ( length * 8.0 ) / count, (double) text_length / count,
+                    (double) json_length( count, times, values ) / count, elapsed / ( (double) repeat * count ) );
+
+            if ( output != NULL )
+            {
+                dump( output, &bench_series[ s ], count, times, values, buffer, text_length );
+            }
+        }
+    }
+
+    if ( output != NULL )
+    {
+        fclose( output );
+    }
+    return 0;
+}
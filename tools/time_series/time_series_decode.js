@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Decoder of the compact time series of libraries/utilities/time_series, for
+ * Cloud Code or Node.js. The format is described in time_series.h.
+ *
+ *   var timeSeries = require('cloud/time_series_decode.js');
+ *
+ *   Parse.Cloud.beforeSave('Telemetry', function(request, response) {
+ *     var samples = timeSeries.expand(request.object.toJSON());
+ *     ...
+ *   });
+ *
+ * From the command line, node time_series_decode.js --check dump.jsonl
+ * compares the decoder with the output of time_series_bench -o.
+ */
+
+var ENCODING = 'ts1';
+var BASE64 = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+
+/* Delta of delta value lengths, by the number of one bits of the prefix */
+var TIME_LENGTHS = [0, 7, 9, 12, 32];
+
+function base64Decode(text) {
+  var bytes = [];
+  var word = 0;
+  var bits = 0;
+  var i;
+
+  for (i = 0; i < text.length && text.charAt(i) !== '='; i++) {
+    var index = BASE64.indexOf(text.charAt(i));
+    if (index < 0) {
+      throw new Error('invalid base64 character at ' + i);
+    }
+    word = (word << 6) | index;
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      bytes.push((word >> bits) & 0xFF);
+    }
+  }
+  return bytes;
+}
+
+function BitReader(bytes) {
+  this.bytes = bytes;
+  this.position = 0;
+}
+
+/* Up to 32 bits, as an unsigned number */
+BitReader.prototype.read = function(length) {
+  var value = 0;
+  var i;
+
+  for (i = 0; i < length; i++) {
+    var byte = this.bytes[this.position >> 3];
+    if (byte === undefined) {
+      throw new Error('stream ends early');
+    }
+    value = value * 2 + ((byte >> (7 - (this.position & 7))) & 1);
+    this.position++;
+  }
+  return value;
+};
+
+function signed(value, length) {
+  return value >= Math.pow(2, length - 1) ? value - Math.pow(2, length) : value;
+}
+
+function float32(bits) {
+  var view = new DataView(new ArrayBuffer(4));
+  view.setUint32(0, bits);
+  return view.getFloat32(0);
+}
+
+/*
+ * Returns {dt: [...], v: [...]}, the time offsets from the first sample and
+ * the values of count samples. data is the base64 text or an array of bytes.
+ */
+function decode(data, count) {
+  var reader = new BitReader(typeof data === 'string' ? base64Decode(data) : data);
+  var result = { dt: [], v: [] };
+  var time = 0;
+  var delta = 0;
+  var value = 0;
+  var leading = -1;
+  var trailing = 0;
+  var index;
+
+  for (index = 0; index < count; index++) {
+    if (index === 0) {
+      value = reader.read(32);
+    } else {
+      var ones = 0;
+      while (ones < 4 && reader.read(1) === 1) {
+        ones++;
+      }
+      if (ones > 0) {
+        var length = TIME_LENGTHS[ones];
+        delta = (delta + signed(reader.read(length), length)) | 0;
+      }
+      time = (time + delta) | 0;
+
+      if (reader.read(1) === 1) {
+        if (reader.read(1) === 1) {
+          leading = reader.read(5);
+          trailing = 32 - leading - (reader.read(5) + 1);
+        } else if (leading < 0) {
+          throw new Error('window reused before it was set');
+        }
+        var meaningful = reader.read(32 - leading - trailing);
+        value = (value ^ (meaningful * Math.pow(2, trailing))) >>> 0;
+      }
+    }
+    result.dt.push(time);
+    result.v.push(float32(value));
+  }
+  return result;
+}
+
+/*
+ * Returns {t: [...], v: [...]}, the wall clock times and values of a
+ * telemetry object, encoded or not.
+ */
+function expand(object) {
+  var samples = object.enc === ENCODING ? decode(object.data, object.n) : { dt: object.dt, v: object.v };
+  return {
+    t: samples.dt.map(function(offset) { return object.t0 + offset; }),
+    v: samples.v
+  };
+}
+
+exports.ENCODING = ENCODING;
+exports.decode = decode;
+exports.expand = expand;
+
+/* Decodes every line of a time_series_bench dump and compares it with its plain samples */
+function check(path) {
+  var lines = require('fs').readFileSync(path, 'utf8').split('\n');
+  var failures = 0;
+
+  lines.forEach(function(line) {
+    if (line.trim() === '') {
+      return;
+    }
+    var series = JSON.parse(line);
+    var samples = decode(series.data, series.n);
+    var ok = samples.dt.length === series.dt.length && samples.dt.every(function(offset, i) {
+      return offset === series.dt[i] && samples.v[i] === Math.fround(series.v[i]);
+    });
+    console.log((ok ? 'ok   ' : 'FAIL ') + series.name + ' ' + series.n);
+    failures += ok ? 0 : 1;
+  });
+  return failures;
+}
+
+if (typeof require !== 'undefined' && require.main === module) {
+  if (process.argv.length !== 4 || process.argv[2] !== '--check') {
+    console.error('usage: node time_series_decode.js --check dump.jsonl');
+    process.exit(2);
+  }
+  process.exit(check(process.argv[3]) === 0 ? 0 : 1);
+}
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Decode the compact time series of libraries/utilities/time_series.
+
+Usage:
+    time_series_decode.py objects.json
+    time_series_decode.py --count 32 <base64>
+    time_series_decode.py --check samples.jsonl
+
+Objects are telemetry objects as stored by parse_telemetry_record() with the
+time series encoding, e.g. the results of a query on the class: each one with
+"enc": "ts1" is printed as its wall clock times and values. --check compares
+the decoded samples of every line of a time_series_bench dump with the ones
+it was encoded from, and fails if any differs.
+
+decode() can be imported, the format is described in time_series.h.
+"""
+
+import argparse
+import base64
+import json
+import struct
+import sys
+
+ENCODING = "ts1"
+
+# Delta of delta codes: prefix, prefix length, value length
+TIME_CODES = ((0b10, 2, 7), (0b110, 3, 9), (0b1110, 4, 12), (0b1111, 4, 32))
+
+
+class BitReader:
+    def __init__(self, data):
+        self.data = data
+        self.position = 0
+
+    def read(self, length):
+        value = 0
+        for _ in range(length):
+            byte = self.data[self.position >> 3]
+            value = (value << 1) | ((byte >> (7 - (self.position & 7))) & 1)
+            self.position += 1
+        return value
+
+    def prefix(self, maximum):
+        """Number of one bits before a zero, at most maximum."""
+        ones = 0
+        while ones < maximum and self.read(1) == 1:
+            ones += 1
+        return ones
+
+
+def signed(value, length):
+    return value - (1 << length) if value & (1 << (length - 1)) else value
+
+
+def float32(bits):
+    return struct.unpack(">f", struct.pack(">I", bits))[0]
+
+
+def decode(data, count):
+    """Returns the time offsets from the first sample and the values of count samples.
+
+    data is the stream, as bytes or as its base64 text.
+    """
+    if isinstance(data, str):
+        data = base64.b64decode(data)
+    reader = BitReader(data)
+    offsets = []
+    values = []
+    time = 0
+    delta = 0
+    leading = trailing = None
+    value = 0
+
+    try:
+        for index in range(count):
+            if index == 0:
+                value = reader.read(32)
+            else:
+                ones = reader.prefix(4)
+                if ones > 0:
+                    _, _, length = TIME_CODES[ones - 1]
+                    delta = (delta + signed(reader.read(length), length)) & 0xFFFFFFFF
+                time = (time + delta) & 0xFFFFFFFF
+
+                if reader.read(1) == 1:
+                    if reader.read(1) == 1:
+                        leading = reader.read(5)
+                        trailing = 32 - leading - (reader.read(5) + 1)
+                    elif leading is None:
+                        raise ValueError("window reused before it was set")
+                    value ^= reader.read(32 - leading - trailing) << trailing
+            offsets.append(signed(time, 32))
+            values.append(float32(value))
+    except IndexError:
+        raise ValueError("stream ends after %d of %d samples" % (len(values), count))
+
+    return offsets, values
+
+
+def expand(obj):
+    """Returns the wall clock times and values of a telemetry object, encoded or not."""
+    if obj.get("enc") == ENCODING:
+        offsets, values = decode(obj["data"], obj["n"])
+    else:
+        offsets, values = obj["dt"], obj["v"]
+    return [obj["t0"] + offset for offset in offsets], values
+
+
+def check(path):
+    failures = 0
+    lines = 0
+    with open(path) as dump:
+        for number, line in enumerate(dump, 1):
+            sample = json.loads(line)
+            offsets, values = decode(sample["data"], sample["n"])
+            expected = [float32(struct.unpack(">I", struct.pack(">f", v))[0]) for v in sample["v"]]
+            if offsets != sample["dt"] or values != expected:
+                print("%s:%d: %s differs" % (path, number, sample.get("name", "series")))
+                failures += 1
+            lines += 1
+    print("%d series checked, %d differ" % (lines, failures))
+    return 1 if failures else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="JSON objects, a base64 stream with --count, or a dump with --check")
+    parser.add_argument("--count", type=int, help="decode input as one base64 stream of this many samples")
+    parser.add_argument("--check", action="store_true", help="check a time_series_bench dump")
+    args = parser.parse_args()
+
+    if args.check:
+        return check(args.input)
+
+    if args.count is not None:
+        for offset, value in zip(*decode(args.input, args.count)):
+            print("%d %r" % (offset, value))
+        return 0
+
+    with open(args.input) if args.input != "-" else sys.stdin as source:
+        document = json.load(source)
+    objects = document.get("results", [document]) if isinstance(document, dict) else document
+    for obj in objects:
+        times, values = expand(obj)
+        print("%s %s" % (obj.get("metric", ""), obj.get("objectId", "")))
+        for time, value in zip(times, values):
+            print("  %d %r" % (time, value))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Handshake time and TLS heap of the Parse TLS profiles
+ *
+ * Runs the same request with every profile of parse_host_tls.h against a
+ * Parse server, normally tools/parse_mock, one connection per request. The
+ * profiles are host only, tools/parse_host applies them to every connection
+ * of the process. The handshake time is the TLS phase of the library's
+ * latency record. The heap is counted by allocation functions installed in
+ * OpenSSL before it allocates anything, so it is the memory of the host TLS
+ * layer alone, not a figure for the SDK's; the peak is taken over each
+ * request and the table shows its median.
+ */
+
+#include "wiced.h"
+#include "parse.h"
+#include "parse_host_tls.h"
+
+#include <stdlib.h>
+#include <openssl/crypto.h>
+
+#ifndef PARSE_ENABLE_LATENCY_STATS
+#error "tls_bench needs a library built with LATENCY_STATS=1"
+#endif
+
+/******************************************************
+ *                      Macros
+ ******************************************************/
+
+#define BENCH_ATOMIC_ADD( counter, value )  __atomic_add_fetch( &( counter ), ( value ), __ATOMIC_RELAXED )
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define DEFAULT_REQUESTS        ( 20 )
+#define DEFAULT_APP_ID          "benchAppId"
+#define DEFAULT_CLIENT_KEY      "benchClientKey"
+#define DEFAULT_PATH            "/1/classes/TlsBench?limit=10"
+
+/* A stored installation, so that parse_init_with_installation() makes no request */
+#define BENCH_INSTALLATION_ID   "6f1c8a52-3b7e-4d0a-9c2e-5a8b1d4e7f30"
+#define BENCH_OBJECT_ID         "tlsBench01"
+
+/* Room for the size in front of every block, keeping the alignment of malloc() */
+#define HEAP_HEADER_SIZE        ( 16 )
+
+#define TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256     ( 0xC02B )
+#define TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256       ( 0xC02F )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    uint32_t handshake_us;
+    uint32_t total_us;
+    size_t   heap_peak;
+} bench_sample_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void* heap_malloc     ( size_t size, const char* file, int line );
+static void* heap_realloc    ( void* block, size_t size, const char* file, int line );
+static void  heap_free       ( void* block, const char* file, int line );
+static void  heap_reset_peak ( void );
+static void  heap_track      ( size_t added, size_t removed );
+
+static int   run_profile     ( parse_client_t* client, const parse_tls_profile_t* profile, unsigned int requests );
+static void  request_done    ( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody );
+static int   compare_u32     ( const void* a, const void* b );
+static int   compare_size    ( const void* a, const void* b );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static const uint16_t bench_fast_cipher_suites[ ] =
+{
+    TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+    TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+};
+
+/* Both restrictions together, an example of a profile defined by the application */
+static const parse_tls_profile_t bench_profile_small_fast =
+{
+    .name                = "small+fast",
+    .record_buffer_size  = 1024,
+    .max_fragment_length = PARSE_TLS_FRAGMENT_1024,
+    .cipher_suites       = bench_fast_cipher_suites,
+    .cipher_suite_count  = sizeof( bench_fast_cipher_suites ) / sizeof( bench_fast_cipher_suites[ 0 ] ),
+};
+
+static const parse_tls_profile_t* const bench_profiles[ ] =
+{
+    &parse_tls_profile_default,
+    &parse_tls_profile_small,
+    &parse_tls_profile_fast,
+    &bench_profile_small_fast,
+};
+
+static size_t          heap_live;
+static size_t          heap_base;
+static size_t          heap_peak;
+static const char*     request_path = DEFAULT_PATH;
+static int             request_error;
+static int             request_status;
+static bench_sample_t* samples;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+int main( int argc, char** argv )
+{
+    static parse_client_t client;
+    const char*           app_id     = DEFAULT_APP_ID;
+    const char*           client_key = DEFAULT_CLIENT_KEY;
+    const char*           only       = NULL;
+    unsigned int          requests   = DEFAULT_REQUESTS;
+    unsigned int          p;
+    int                   failed     = 0;
+    int                   arg;
+
+    /* Before anything in OpenSSL allocates */
+    if ( CRYPTO_set_mem_functions( heap_malloc, heap_realloc, heap_free ) != 1 )
+    {
+        fprintf( stderr, "%s: cannot count the OpenSSL heap\n", argv[ 0 ] );
+        return 1;
+    }
+
+    for ( arg = 1; arg < argc; arg++ )
+    {
+        if ( strcmp( argv[ arg ], "-n" ) == 0 && arg + 1 < argc )
+        {
+            requests = (unsigned int) atoi( argv[ ++arg ] );
+        }
+        else if ( strcmp( argv[ arg ], "-p" ) == 0 && arg + 1 < argc )
+        {
+            only = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-u" ) == 0 && arg + 1 < argc )
+        {
+            request_path = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-a" ) == 0 && arg + 1 < argc )
+        {
+            app_id = argv[ ++arg ];
+        }
+        else if ( strcmp( argv[ arg ], "-k" ) == 0 && arg + 1 < argc )
+        {
+            client_key = argv[ ++arg ];
+        }
+        else
+        {
+            fprintf( stderr, "usage: %s [-n requests_per_profile] [-p profile] [-u path] [-a app_id] [-k client_key]\n", argv[ 0 ] );
+            return 2;
+        }
+    }
+
+    samples = calloc( requests > 0 ? requests : 1, sizeof( bench_sample_t ) );
+    if ( requests == 0 || samples == NULL )
+    {
+        fprintf( stderr, "%s: bad request count\n", argv[ 0 ] );
+        return 2;
+    }
+
+    if ( parse_init_with_installation( &client, app_id, client_key, BENCH_INSTALLATION_ID, BENCH_OBJECT_ID, NULL ) != WICED_SUCCESS )
+    {
+        fprintf( stderr, "%s: parse_init_with_installation failed\n", argv[ 0 ] );
+        return 1;
+    }
+
+    printf( "%u requests per profile, GET %s, TLS context %lu bytes\n\n", requests, request_path, (unsigned long) sizeof( wiced_tls_simple_context_t ) );
+    printf( "%-12s %6s %10s %10s %10s %12s %12s\n", "profile", "errors", "hs p50 ms", "hs p90 ms", "req p50 ms", "heap p50 KB", "heap max KB" );
+
+    for ( p = 0; p < sizeof( bench_profiles ) / sizeof( bench_profiles[ 0 ] ); p++ )
+    {
+        if ( only == NULL || strcmp( only, bench_profiles[ p ]->name ) == 0 )
+        {
+            failed |= run_profile( &client, bench_profiles[ p ], requests );
+        }
+    }
+
+    free( samples );
+
+    return failed;
+}
+
+static int run_profile( parse_client_t* client, const parse_tls_profile_t* profile, unsigned int requests )
+{
+    uint32_t     handshake[ requests ];
+    uint32_t     total[ requests ];
+    size_t       heap[ requests ];
+    unsigned int count  = 0;
+    unsigned int errors = 0;
+    unsigned int r;
+
+    if ( parse_host_set_tls_profile( profile ) != WICED_SUCCESS )
+    {
+        printf( "%-12s not supported by the host TLS layer\n", profile->name );
+        return 1;
+    }
+
+    /* One request first, so that lazily created OpenSSL state is not counted */
+    parse_send_request( client, "GET", request_path, NULL, request_done );
+
+    for ( r = 0; r < requests; r++ )
+    {
+        const parse_latency_record_t* record;
+
+        heap_reset_peak( );
+        parse_send_request( client, "GET", request_path, NULL, request_done );
+        record = parse_get_request_latency( client );
+
+        if ( request_error != 0 || request_status != 200 || record->phase_us[ PARSE_LATENCY_TLS ] == 0 )
+        {
+            errors++;
+            continue;
+        }
+
+        samples[ count ].handshake_us = record->phase_us[ PARSE_LATENCY_TLS ];
+        samples[ count ].total_us     = record->phase_us[ PARSE_LATENCY_TOTAL ];
+        samples[ count ].heap_peak    = __atomic_load_n( &heap_peak, __ATOMIC_RELAXED );
+        count++;
+    }
+
+    if ( count == 0 )
+    {
+        printf( "%-12s %6u %10s %10s %10s %12s %12s\n", profile->name, errors, "-", "-", "-", "-", "-" );
+        return 1;
+    }
+
+    for ( r = 0; r < count; r++ )
+    {
+        handshake[ r ] = samples[ r ].handshake_us;
+        total[ r ]     = samples[ r ].total_us;
+        heap[ r ]      = samples[ r ].heap_peak;
+    }
+    qsort( handshake, count, sizeof( handshake[ 0 ] ), compare_u32 );
+    qsort( total,     count, sizeof( total[ 0 ] ),     compare_u32 );
+    qsort( heap,      count, sizeof( heap[ 0 ] ),      compare_size );
+
+    printf( "%-12s %6u %10.2f %10.2f %10.2f %12.1f %12.1f\n", profile->name, errors,
+            handshake[ count / 2 ] / 1000.0, handshake[ ( count * 9 ) / 10 ] / 1000.0, total[ count / 2 ] / 1000.0,
+            heap[ count / 2 ] / 1024.0, heap[ count - 1 ] / 1024.0 );
+
+    return 0;
+}
+
+static void request_done( parse_client_t* client, int error, int httpStatus, const char* httpResponseBody )
+{
+    request_error  = error;
+    request_status = httpStatus;
+}
+
+/* The peak is relative to what was live before the request, the store and SSL_CTX are not counted */
+static void heap_reset_peak( void )
+{
+    __atomic_store_n( &heap_peak, 0, __ATOMIC_RELAXED );
+    __atomic_store_n( &heap_base, __atomic_load_n( &heap_live, __ATOMIC_RELAXED ), __ATOMIC_RELAXED );
+}
+
+static void heap_track( size_t added, size_t removed )
+{
+    size_t live = BENCH_ATOMIC_ADD( heap_live, added - removed );
+    size_t base = __atomic_load_n( &heap_base, __ATOMIC_RELAXED );
+    size_t peak = __atomic_load_n( &heap_peak, __ATOMIC_RELAXED );
+
+    while ( live > base && live - base > peak && !__atomic_compare_exchange_n( &heap_peak, &peak, live - base, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+    {
+    }
+}
+
+static void* heap_malloc( size_t size, const char* file, int line )
+{
+    uint8_t* block = malloc( size + HEAP_HEADER_SIZE );
+
+    if ( block == NULL )
+    {
+        return NULL;
+    }
+    *(size_t*) block = size;
+    heap_track( size, 0 );
+
+    return block + HEAP_HEADER_SIZE;
+}
+
+static void* heap_realloc( void* block, size_t size, const char* file, int line )
+{
+    uint8_t* header;
+    size_t   old_size;
+
+    if ( block == NULL )
+    {
+        return heap_malloc( size, file, line );
+    }
+
+    header   = (uint8_t*) block - HEAP_HEADER_SIZE;
+    old_size = *(size_t*) header;
+    header   = realloc( header, size + HEAP_HEADER_SIZE );
+    if ( header == NULL )
+    {
+        return NULL;
+    }
+    *(size_t*) header = size;
+    heap_track( size, old_size );
+
+    return header + HEAP_HEADER_SIZE;
+}
+
+static void heap_free( void* block, const char* file, int line )
+{
+    uint8_t* header;
+
+    if ( block == NULL )
+    {
+        return;
+    }
+
+    header = (uint8_t*) block - HEAP_HEADER_SIZE;
+    heap_track( 0, *(size_t*) header );
+    free( header );
+}
+
+static int compare_u32( const void* a, const void* b )
+{
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+
+    return ( x > y ) - ( x < y );
+}
+
+static int compare_size( const void* a, const void* b )
+{
+    size_t x = *(const size_t*) a;
+    size_t y = *(const size_t*) b;
+
+    return ( x > y ) - ( x < y );
+}
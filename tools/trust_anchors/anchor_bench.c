@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2015 Broadcom
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * 3. Neither the name of Broadcom nor the names of other contributors to this 
+ * software may be used to endorse or promote products derived from this software 
+ * without specific prior written permission.
+ *
+ * 4. This software may not be used as a standalone product, and may only be used as 
+ * incorporated in your product or device that incorporates Broadcom wireless connectivity 
+ * products and solely for the purpose of enabling the functionalities of such Broadcom products.
+ *
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ *
+ * Load time, heap and flash of the trust anchors as PEM text and as DER tables
+ *
+ * Loads the certificates of the PEM files given on the command line with
+ * wiced_tls_init_root_ca_certificates(), and the same certificates from the
+ * tables pem_to_der.py generated from them with
+ * wiced_tls_init_root_ca_certificates_der() of the tools/parse_host TLS
+ * layer, clearing the store before every load. The heap is counted by
+ * allocation functions installed in OpenSSL before it allocates anything, so
+ * it is that of the host TLS layer alone, not a figure for the SDK's: the
+ * peak of a load, and what the store keeps after it.
+ */
+
+#include "wiced.h"
+
+#include <stdlib.h>
+#include <time.h>
+#include <openssl/crypto.h>
+
+/* Generated by the Makefile from the PEM files */
+#include "trust_anchors.h"
+
+/******************************************************
+ *                    Constants
+ ******************************************************/
+
+#define DEFAULT_LOADS           ( 2000 )
+
+/* Room for the size in front of every block, keeping the alignment of malloc() */
+#define HEAP_HEADER_SIZE        ( 16 )
+
+/******************************************************
+ *                    Structures
+ ******************************************************/
+
+typedef struct
+{
+    uint64_t time_ns;
+    size_t   heap_peak;
+    size_t   heap_kept;
+} bench_result_t;
+
+/******************************************************
+ *               Static Function Declarations
+ ******************************************************/
+
+static void*    heap_malloc  ( size_t size, const char* file, int line );
+static void*    heap_realloc ( void* block, size_t size, const char* file, int line );
+static void     heap_free    ( void* block, const char* file, int line );
+static void     heap_track   ( size_t added, size_t removed );
+
+static char*    read_pem     ( int count, char** paths, size_t* length );
+static int      run_loads    ( const char* pem, unsigned int loads, bench_result_t* result );
+static uint64_t now_ns       ( void );
+
+/******************************************************
+ *               Variable Definitions
+ ******************************************************/
+
+static size_t heap_live;
+static size_t heap_peak;
+
+/******************************************************
+ *               Function Definitions
+ ******************************************************/
+
+int main( int argc, char** argv )
+{
+    bench_result_t pem_result;
+    bench_result_t der_result;
+    unsigned int   loads = DEFAULT_LOADS;
+    size_t         pem_length;
+    size_t         der_length = 0;
+    char*          pem;
+    uint32_t       index;
+    int            arg = 1;
+
+    /* Before anything in OpenSSL allocates */
+    if ( CRYPTO_set_mem_functions( heap_malloc, heap_realloc, heap_free ) != 1 )
+    {
+        fprintf( stderr, "%s: cannot count the OpenSSL heap\n", argv[ 0 ] );
+        return 1;
+    }
+
+    if ( arg + 1 < argc && strcmp( argv[ arg ], "-n" ) == 0 )
+    {
+        loads = (unsigned int) atoi( argv[ arg + 1 ] );
+        arg  += 2;
+    }
+    if ( arg == argc || loads == 0 )
+    {
+        fprintf( stderr, "usage: %s [-n loads] certificate.pem...\n", argv[ 0 ] );
+        return 2;
+    }
+
+    pem = read_pem( argc - arg, argv + arg, &pem_length );
+    if ( pem == NULL )
+    {
+        return 1;
+    }
+    for ( index = 0; index < TRUST_ANCHORS_COUNT; index++ )
+    {
+        der_length += trust_anchors[ index ].length;
+    }
+
+    /* Only the anchors under test */
+    unsetenv( "WICED_HOST_CA_FILE" );
+
+    if ( run_loads( pem, loads, &pem_result ) != 0 || run_loads( NULL, loads, &der_result ) != 0 )
+    {
+        fprintf( stderr, "%s: the certificates do not load\n", argv[ 0 ] );
+        free( pem );
+        return 1;
+    }
+
+    printf( "%u anchors, %u loads each\n\n", (unsigned int) TRUST_ANCHORS_COUNT, loads );
+    printf( "%-6s %12s %10s %14s %14s\n", "format", "flash bytes", "load us", "heap peak KB", "heap kept KB" );
+    printf( "%-6s %12lu %10.1f %14.1f %14.1f\n", "PEM", (unsigned long) pem_length, pem_result.time_ns / 1000.0 / loads,
+            pem_result.heap_peak / 1024.0, pem_result.heap_kept / 1024.0 );
+    printf( "%-6s %12lu %10.1f %14.1f %14.1f\n", "DER", (unsigned long) der_length, der_result.time_ns / 1000.0 / loads,
+            der_result.heap_peak / 1024.0, der_result.heap_kept / 1024.0 );
+
+    free( pem );
+    return 0;
+}
+
+/* All the files in one string, as the library would embed them */
+static char* read_pem( int count, char** paths, size_t* length )
+{
+    char*  text = NULL;
+    size_t used = 0;
+    int    index;
+
+    for ( index = 0; index < count; index++ )
+    {
+        FILE* file = fopen( paths[ index ], "rb" );
+        long  size;
+        char* grown;
+
+        if ( file == NULL || fseek( file, 0, SEEK_END ) != 0 || ( size = ftell( file ) ) < 0 || fseek( file, 0, SEEK_SET ) != 0 )
+        {
+            fprintf( stderr, "cannot read %s\n", paths[ index ] );
+            if ( file != NULL )
+            {
+                fclose( file );
+            }
+            free( text );
+            return NULL;
+        }
+
+        grown = realloc( text, used + (size_t) size + 1 );
+        if ( grown == NULL || fread( grown + used, 1, (size_t) size, file ) != (size_t) size )
+        {
+            fprintf( stderr, "cannot read %s\n", paths[ index ] );
+            fclose( file );
+            free( grown != NULL ? grown : text );
+            return NULL;
+        }
+        fclose( file );
+
+        text  = grown;
+        used += (size_t) size;
+        text[ used ] = '\0';
+    }
+
+    *length = used;
+    return text;
+}
+
+/* Loads pem, or the DER tables when it is NULL */
+static int run_loads( const char* pem, unsigned int loads, bench_result_t* result )
+{
+    unsigned int load;
+    size_t       base;
+    uint64_t     start;
+
+    memset( result, 0, sizeof( *result ) );
+
+    for ( load = 0; load < loads; load++ )
+    {
+        wiced_result_t status;
+
+        wiced_tls_init_root_ca_certificates( NULL );
+        base      = heap_live;
+        heap_peak = heap_live;
+
+        start = now_ns( );
+        if ( pem != NULL )
+        {
+            status = wiced_tls_init_root_ca_certificates( pem );
+        }
+        else
+        {
+            status = wiced_tls_init_root_ca_certificates_der( trust_anchors, TRUST_ANCHORS_COUNT );
+        }
+        result->time_ns += now_ns( ) - start;
+
+        if ( status != WICED_SUCCESS )
+        {
+            return -1;
+        }
+        if ( heap_peak - base > result->heap_peak )
+        {
+            result->heap_peak = heap_peak - base;
+        }
+        result->heap_kept = heap_live - base;
+    }
+
+    wiced_tls_init_root_ca_certificates( NULL );
+    return 0;
+}
+
+static uint64_t now_ns( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return (uint64_t) now.tv_sec * 1000000000u + (uint64_t) now.tv_nsec;
+}
+
+static void heap_track( size_t added, size_t removed )
+{
+    heap_live += added - removed;
+    if ( heap_live > heap_peak )
+    {
+        heap_peak = heap_live;
+    }
+}
+
+static void* heap_malloc( size_t size, const char* file, int line )
+{
+    uint8_t* block = malloc( size + HEAP_HEADER_SIZE );
+
+    if ( block == NULL )
+    {
+        return NULL;
+    }
+    *(size_t*) block = size;
+    heap_track( size, 0 );
+
+    return block + HEAP_HEADER_SIZE;
+}
+
+static void* heap_realloc( void* block, size_t size, const char* file, int line )
+{
+    uint8_t* header;
+    size_t   old_size;
+
+    if ( block == NULL )
+    {
+        return heap_malloc( size, file, line );
+    }
+
+    header   = (uint8_t*) block - HEAP_HEADER_SIZE;
+    old_size = *(size_t*) header;
+    header   = realloc( header, size + HEAP_HEADER_SIZE );
+    if ( header == NULL )
+    {
+        return NULL;
+    }
+    *(size_t*) header = size;
+    heap_track( size, old_size );
+
+    return header + HEAP_HEADER_SIZE;
+}
+
+static void heap_free( void* block, const char* file, int line )
+{
+    uint8_t* header;
+
+    if ( block == NULL )
+    {
+        return;
+    }
+
+    header = (uint8_t*) block - HEAP_HEADER_SIZE;
+    heap_track( 0, *(size_t*) header );
+    free( header );
+}
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2015 Broadcom
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice, this
+# list of conditions and the following disclaimer in the documentation and/or
+# other materials provided with the distribution.
+#
+# 3. Neither the name of Broadcom nor the names of other contributors to this 
+# software may be used to endorse or promote products derived from this software 
+# without specific prior written permission.
+#
+# 4. This software may not be used as a standalone product, and may only be used as 
+# incorporated in your product or device that incorporates Broadcom wireless connectivity 
+# products and solely for the purpose of enabling the functionalities of such Broadcom products.
+#
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY WARRANTIES OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT, ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+# ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+"""Convert PEM trust anchors into a C header of DER tables for the TLS layer.
+
+Usage:
+    pem_to_der.py --name trust_anchors -o trust_anchors.h \\
+        digicert_sha2_high_assurance_server_ca.pem digicert_high_assurance_ev_root_ca.pem
+
+Every certificate of every input file becomes a const byte array, in the
+order given, and the header defines a wiced_tls_der_certificate_t table
+called <name> with <NAME>_COUNT entries for
+wiced_tls_init_root_ca_certificates_der(), which only the tools/parse_host TLS
+layer has: the Makefile here runs this script for anchor_bench, which compares
+the tables with the PEM text the library loads.
+List the current anchor and its successor to rotate certificates without a
+gap. --check compares the output with the existing file instead of writing it.
+"""
+
+import argparse
+import base64
+import datetime
+import hashlib
+import re
+import sys
+
+PEM_RE = re.compile(r"-----BEGIN CERTIFICATE-----(.*?)-----END CERTIFICATE-----", re.S)
+
+# DER tags
+SEQUENCE = 0x30
+SET = 0x31
+OID = 0x06
+UTC_TIME = 0x17
+GENERALIZED_TIME = 0x18
+CONTEXT_0 = 0xA0
+
+COMMON_NAME = bytes([0x55, 0x04, 0x03])
+ORGANIZATION = bytes([0x55, 0x04, 0x0A])
+
+
+def read_tlv(data, offset):
+    """Return tag, value start and value end of the element at offset."""
+    tag = data[offset]
+    length = data[offset + 1]
+    offset += 2
+    if length & 0x80:
+        count = length & 0x7F
+        if count == 0 or count > 4:
+            raise ValueError("unsupported DER length")
+        length = int.from_bytes(data[offset:offset + count], "big")
+        offset += count
+    if offset + length > len(data):
+        raise ValueError("truncated DER")
+    return tag, offset, offset + length
+
+
+def children(data, start, end):
+    while start < end:
+        tag, value, after = read_tlv(data, start)
+        yield tag, value, after
+        start = after
+
+
+def name_attribute(data, start, end, oid):
+    for _, set_start, set_end in children(data, start, end):
+        for _, attribute_start, attribute_end in children(data, set_start, set_end):
+            parts = list(children(data, attribute_start, attribute_end))
+            if len(parts) == 2 and parts[0][0] == OID and data[parts[0][1]:parts[0][2]] == oid:
+                return data[parts[1][1]:parts[1][2]].decode("utf-8", "replace")
+    return None
+
+
+def parse_time(data, tag, start, end):
+    text = data[start:end].decode("ascii")
+    if tag == UTC_TIME:
+        return datetime.datetime.strptime(text, "%y%m%d%H%M%SZ")
+    return datetime.datetime.strptime(text, "%Y%m%d%H%M%SZ")
+
+
+def describe(der):
+    """Subject name and expiry of a certificate, enough for the comments."""
+    tag, start, end = read_tlv(der, 0)
+    if tag != SEQUENCE or end != len(der):
+        raise ValueError("not a certificate")
+    tag, start, end = read_tlv(der, start)
+    if tag != SEQUENCE:
+        raise ValueError("no tbsCertificate")
+    fields = list(children(der, start, end))
+    if fields and fields[0][0] == CONTEXT_0:
+        fields = fields[1:]
+    # serialNumber, signature, issuer, validity, subject
+    if len(fields) < 5:
+        raise ValueError("short tbsCertificate")
+    validity = list(children(der, fields[3][1], fields[3][2]))
+    subject = fields[4]
+    name = name_attribute(der, subject[1], subject[2], COMMON_NAME) or \
+        name_attribute(der, subject[1], subject[2], ORGANIZATION) or "unnamed"
+    not_after = parse_time(der, validity[1][0], validity[1][1], validity[1][2])
+    return name, not_after
+
+
+def load(paths):
+    anchors = []
+    pem_bytes = 0
+    for path in paths:
+        with open(path) as f:
+            text = f.read()
+        blocks = PEM_RE.findall(text)
+        if not blocks:
+            sys.exit("pem_to_der: %s holds no certificate" % path)
+        for block in blocks:
+            der = base64.b64decode("".join(block.split()), validate=True)
+            try:
+                name, not_after = describe(der)
+            except (ValueError, IndexError) as error:
+                sys.exit("pem_to_der: %s: %s" % (path, error))
+            pem_bytes += len("-----BEGIN CERTIFICATE-----%s-----END CERTIFICATE-----\n" % block)
+            anchors.append((der, name, not_after, hashlib.sha256(der).hexdigest()))
+    fingerprints = [anchor[3] for anchor in anchors]
+    if len(set(fingerprints)) != len(fingerprints):
+        sys.exit("pem_to_der: duplicate certificates")
+    return anchors, pem_bytes
+
+
+def generate(name, anchors, command):
+    guard = "INCLUDED_%s_H_" % name.upper()
+    lines = [
+        "/*",
+        " * Generated by tools/trust_anchors/pem_to_der.py, do not edit.",
+        " * %s" % command,
+        " */",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        '#include "wiced_tls.h"',
+        "",
+        "#define %s_COUNT ( %d )" % (name.upper(), len(anchors)),
+        "",
+    ]
+    for index, (der, subject, not_after, fingerprint) in enumerate(anchors):
+        lines += [
+            "/* %s, valid until %s" % (subject, not_after.strftime("%Y-%m-%d")),
+            " * SHA-256 %s */" % fingerprint,
+            "static const uint8_t %s_%d[ %d ] =" % (name, index, len(der)),
+            "{",
+        ]
+        for row in range(0, len(der), 16):
+            chunk = der[row:row + 16]
+            separator = "," if row + 16 < len(der) else ""
+            lines.append("    " + ", ".join("0x%02x" % byte for byte in chunk) + separator)
+        lines += ["};", ""]
+    lines += [
+        "static const wiced_tls_der_certificate_t %s[ %s_COUNT ] =" % (name, name.upper()),
+        "{",
+    ]
+    for index, (der, _, _, _) in enumerate(anchors):
+        separator = "," if index + 1 < len(anchors) else ""
+        lines.append("    { %s_%d, sizeof( %s_%d ) }%s" % (name, index, name, index, separator))
+    lines += [
+        "};",
+        "",
+        "#endif /* %s */" % guard,
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--name", required=True, help="name of the generated table")
+    parser.add_argument("-o", "--output", help="output header, stdout by default")
+    parser.add_argument("--check", action="store_true", help="fail if the output is not up to date")
+    parser.add_argument("pem", nargs="+", help="PEM files, one or more certificates each")
+    args = parser.parse_args()
+
+    anchors, pem_bytes = load(args.pem)
+    now = datetime.datetime.utcnow()
+    for _, subject, not_after, _ in anchors:
+        if not_after < now:
+            print("pem_to_der: warning: %s expired on %s" % (subject, not_after.date()), file=sys.stderr)
+
+    command = "pem_to_der.py --name %s %s" % (args.name, " ".join(p.replace("\\", "/").split("/")[-1] for p in args.pem))
+    text = generate(args.name, anchors, command)
+    der_bytes = sum(len(anchor[0]) for anchor in anchors)
+    print("pem_to_der: %d anchors, %d bytes of DER from %d bytes of PEM" % (len(anchors), der_bytes, pem_bytes), file=sys.stderr)
+
+    if args.check:
+        if not args.output:
+            sys.exit("pem_to_der: --check needs --output")
+        with open(args.output, newline="") as existing:
+            if existing.read().replace("\r\n", "\n") != text:
+                sys.exit("pem_to_der: %s is not up to date" % args.output)
+    elif args.output:
+        with open(args.output, "w", newline="") as output:
+            output.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()